@@ -2,23 +2,64 @@ static_assert( __cplusplus > 2020'00 );
 
 #pragma once
 
+#include <Alepha/Alepha.h>
+
+#include <array>
+#include <atomic>
 #include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <Alepha/Buffer.h>
+#include <Alepha/BlobPool.h>
+#include <Alepha/BlobGrowth.h>
+#include <Alepha/error.h>
+#include <Alepha/swappable.h>
+
+#include <Alepha/IOStreams/String.h>
 
-#include "Buffer.h"
-#include "swappable.h"
-#include "stringify.h"
-#include "Exceptions.h"
-#include "evaluation_helpers.h"
-#include "threading.h"
-#include "error.h"
+#include <Alepha/Utility/evaluation_helpers.h>
 
 namespace Alepha::inline Cavorite  ::detail::  blob
 {
 	inline namespace exports
 	{
-		class Blob;
+		struct AtomicReferenceCount;
+		struct LocalReferenceCount;
+
+		template< typename ReferenceCount > class BasicBlob;
+
+		using Blob= BasicBlob< AtomicReferenceCount >;
+
+		// For pipelines where carved `Blob` objects never leave the thread that created them.
+		using LocalBlob= BasicBlob< LocalReferenceCount >;
+
 		class DataCarveTooLargeError;
 		class DataCarveOutOfRangeError;
+
+		/*!
+		 * Tag to request that a newly allocated `Blob` arena not be zeroed.
+		 *
+		 * This is meant for arenas which are about to be entirely overwritten (by `copyData` or by a `read()`
+		 * call, for example).  The contents of such an arena are indeterminate until written.
+		 */
+		enum Uninitialized { uninitialized };
+
+		/*!
+		 * Access hints for memory-mapped `Blob` arenas.
+		 *
+		 * These are passed on to the kernel (by `madvise`) to tune read-ahead on the mapped pages.
+		 */
+		enum class AccessPattern { normal, sequential, random };
 	}
 
 	namespace C
@@ -29,12 +70,15 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 		const bool debugAssignment= false or C::debugLifecycle or C::debug;
 		const bool debugSwap= false or C::debugLifecycle or C::debug;
 
-		const bool debugSplitSharing= false or C::debug;
 		const bool debugInteriorCarve= false or C::debug;
+
+		const std::size_t arenaAlignment= alignof( std::max_align_t );
 	}
 
 	using std::begin, std::end;
 
+	using IOStreams::stringify;
+
 	class exports::DataCarveTooLargeError
 		: public virtual OutOfRangeError
 	{
@@ -42,7 +86,7 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 			explicit
 			DataCarveTooLargeError( const void *const location, const std::size_t request, const std::size_t available )
 				: std::out_of_range( "Tried to carve " + stringify( request ) + " bytes from `Blob` object at location "
-						+ stringify( location ) + " which only has " + stringify( avail ) + " bytes allocated." ),
+						+ stringify( location ) + " which only has " + stringify( available ) + " bytes allocated." ),
 				OutOfRangeError( location, request, available )
 			{}
 	};
@@ -53,44 +97,151 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 	{
 		public:
 			explicit
-			DataCarveOutOfRanceError( const void *const location, const std::size_t request, const std::size_t available )
+			DataCarveOutOfRangeError( const void *const location, const std::size_t request, const std::size_t available )
 				: std::out_of_range( "Tried to carve " + stringify( request ) + " bytes from `Blob` object at location "
-						+ stringify( location ) + " which only has " + stringify( avail ) + " bytes allocated." ),
+						+ stringify( location ) + " which only has " + stringify( available ) + " bytes allocated." ),
 				OutOfRangeError( location, request, available )
 			{}
 	};
 
-	class exports::Blob
-		: public BufferModel< Blob >, public swappable
+	/*!
+	 * Reference count policy for `Blob` arenas which may be shared across threads.
+	 */
+	struct exports::AtomicReferenceCount
+	{
+		std::atomic< std::size_t > count= 1;
+
+		void acquire() noexcept { count.fetch_add( 1, std::memory_order_relaxed ); }
+
+		// Returns true when the last reference was dropped.
+		bool release() noexcept { return count.fetch_sub( 1, std::memory_order_acq_rel ) == 1; }
+
+		std::size_t use_count() const noexcept { return count.load( std::memory_order_relaxed ); }
+	};
+
+	/*!
+	 * Reference count policy for `Blob` arenas which never leave the thread which allocated them.
+	 */
+	struct exports::LocalReferenceCount
+	{
+		std::size_t count= 1;
+
+		void acquire() noexcept { ++count; }
+		bool release() noexcept { return --count == 0; }
+		std::size_t use_count() const noexcept { return count; }
+	};
+
+	/*!
+	 * The header which precedes (and owns) every `Blob` arena.
+	 *
+	 * The header lives in the same allocation as the arena it describes, immediately in front of it, so a
+	 * `Blob` costs exactly one allocation, and carving costs none.  The `destroy` hook is called when the last
+	 * reference is released.  It is responsible for releasing the entire allocation, header included.
+	 */
+	template< typename ReferenceCount >
+	struct ArenaHeader
+	{
+		ReferenceCount references;
+		void (*destroy)( ArenaHeader * ) noexcept;
+		BlobPool *pool= nullptr; // The pool which the allocation was drawn from, if any.
+		std::size_t allocated= 0; // The size of the whole allocation, header included.
+
+		static constexpr std::size_t
+		headerSize() noexcept
+		{
+			return ( sizeof( ArenaHeader ) + C::arenaAlignment - 1 ) / C::arenaAlignment * C::arenaAlignment;
+		}
+
+		std::byte *arena() noexcept { return reinterpret_cast< std::byte * >( this ) + headerSize(); }
+
+		static void
+		destroyAllocated( ArenaHeader *const header ) noexcept
+		{
+			auto *const pool= header->pool;
+			const auto allocated= header->allocated;
+			auto *const base= reinterpret_cast< std::byte * >( header );
+			header->~ArenaHeader();
+
+			if( pool ) pool->deallocate( base, allocated );
+			else ::operator delete( base, std::align_val_t{ C::arenaAlignment } );
+		}
+
+		static ArenaHeader *
+		allocate( const std::size_t amount, BlobPool *const pool )
+		{
+			const std::size_t allocated= headerSize() + amount;
+			auto *base= pool ? pool->tryAllocate( allocated ) : nullptr;
+			auto *const source= base ? pool : nullptr;
+			if( not base ) base= static_cast< std::byte * >( ::operator new( allocated, std::align_val_t{ C::arenaAlignment } ) );
+
+			return new ( base ) ArenaHeader{ {}, destroyAllocated, source, allocated };
+		}
+	};
+
+	/*!
+	 * The header for an arena which is a memory-mapped file region.
+	 *
+	 * The mapping cannot have the header in front of it, so this header is a separate allocation, made once per
+	 * mapping.  Carving the mapped `Blob` still costs nothing.
+	 */
+	template< typename ReferenceCount >
+	struct MappedArenaHeader
+		: ArenaHeader< ReferenceCount >
+	{
+		void *mapping;
+		std::size_t length;
+
+		static void
+		destroyMapped( ArenaHeader< ReferenceCount > *const header ) noexcept
+		{
+			const auto *const self= static_cast< MappedArenaHeader * >( header );
+			::munmap( self->mapping, self->length );
+			delete self;
+		}
+	};
+
+	inline int
+	adviceFor( const AccessPattern pattern ) noexcept
+	{
+		switch( pattern )
+		{
+			case AccessPattern::sequential: return MADV_SEQUENTIAL;
+			case AccessPattern::random: return MADV_RANDOM;
+			case AccessPattern::normal: break;
+		}
+		return MADV_NORMAL;
+	}
+
+	template< typename ReferenceCount >
+	class exports::BasicBlob
+		: public BufferModel< BasicBlob< ReferenceCount > >, public swappable
 	{
 		private:
-			using IndirectStorage= std::shared_ptr< std::shared_ptr< Blob > >;
-			IndirectStorage storage; // If this is empty, then this `Blob` object doesn't share ownership.  This references the shared pool.
-			Buffer buffer;
+			using Header= ArenaHeader< ReferenceCount >;
+			Header *header= nullptr; // The arena which this `Blob` object views, shared with any `Blob` carved from it.
+			Buffer< Mutable > buffer;
 			std::size_t viewLimit= 0; // TODO: Consider allowing for unrooted sub-buffer views?
 
-			// TODO: Take the `storage` parameter and make it not increment when this ctor is called -- only when the dice roll passes.
+			// Adopts one already-acquired reference to `header`.
 			explicit
-			Blob( IndirectStorage storage, Buffer buffer ) noexcept
-				: storage( evaluate <=[storage= std::move( storage )] () -> IndirectBacking
-				{
-					if( fastRandomBits( C::storageSplitRandomBitDepth ) ) return std::move( storage );
-					if( C::debugSplitSharing ) error() << "Observed a use count of " << storage.use_count() << " when we failed the dice roll." << std::endl;
-					auto split= std::make_shared< std::shared_ptr< Blob > >( *storage );
-					if( C::
-				}),
-				buffer( buffer )
+			BasicBlob( Header *const header, const Buffer< Mutable > buffer ) noexcept
+				: header( header ),
+				buffer( buffer ),
 				viewLimit( buffer.size() )
 			{}
 
+			using Base= BufferModel< BasicBlob >;
+
 		public:
-			~Buffer() { reset(); }
+			using Base::size, Base::data, Base::byte_data;
+
+			~BasicBlob() { reset(); }
 
 			auto
 			swap_lens() noexcept
 			{
 				if( C::debugSwap ) error() << "Swap lens called." << std::endl;
-				return swap_magma( storage, buffer, viewLimit );
+				return swap_magma( header, buffer, viewLimit );
 			}
 
 			/*!
@@ -106,8 +257,8 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 			void
 			reset() noexcept
 			{
-				if( not storage ) delete buffer;
-				else storage.reset();
+				if( header and header->references.release() ) header->destroy( header );
+				header= nullptr;
 
 				buffer= {};
 				viewLimit= 0;
@@ -125,42 +276,43 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 			 * @note: No data are copied.
 			 */
 			void
-			reset( const std::size_t )
+			reset( const std::size_t size )
 			{
-				Blob tmp{ size };
+				BasicBlob tmp{ size };
 				swap( tmp, *this );
 			}
 
 			// Copy deep copies the data.
-			Blob( const Blob &copy )
-				: buffer( new std::byte[ copy.buffer.size() ] ),
-				viewLimit( copy.viewLimit )
+			BasicBlob( const BasicBlob &copy )
+				: BasicBlob( copy.buffer.size(), uninitialized )
 			{
 				if( C::debugCtors ) error() << "Blob copy invoked." << std::endl;
+				viewLimit= copy.viewLimit;
 				copyData( *this, copy );
+				zeroData( buffer + viewLimit );
 			}
 
-			Blob( Blob &&orig ) noexcept { swap( *this, orig ); }
+			BasicBlob( BasicBlob &&orig ) noexcept { swap( *this, orig ); }
 
 			template< typename ByteIterator >
 			explicit
-			Blob( ByteIterator first, ByteIterator last )
-				: Blob( std::distance( first, last ) )
+			BasicBlob( ByteIterator first, ByteIterator last )
+				: BasicBlob( std::distance( first, last ), uninitialized )
 			{
 				std::copy( first, last, byte_data() );
 			}
 
 			// Move assignment
-			Blob &
-			operator= ( Blob &&orig ) noexcept
+			BasicBlob &
+			operator= ( BasicBlob &&orig ) noexcept
 			{
-				Blob temp= std::move( orig );
+				BasicBlob temp= std::move( orig );
 				swap( *this, temp );
 				return *this;
 			}
 
-			Blob &
-			operator= ( const Blob &source )
+			BasicBlob &
+			operator= ( const BasicBlob &source )
 			{
 				if( buffer.size() < source.size() ) reset( source.size() );
 				else viewLimit= source.size();
@@ -176,20 +328,52 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 				viewLimit= size;
 			}
 
+			/*!
+			 * Allocate a new arena of the specified size, without zeroing it.
+			 *
+			 * The arena is drawn from `pool`, when that pool will serve it, and from the general allocator
+			 * otherwise.
+			 *
+			 * @param amount The size of the arena to allocate.
+			 * @param pool The pool to draw the arena from.  Defaults to the calling thread's selected pool.
+			 *
+			 * @see `setThreadBlobPool`
+			 */
+			explicit
+			BasicBlob( const std::size_t amount, Uninitialized, BlobPool *const pool= threadBlobPool() )
+				: BasicBlob( Header::allocate( amount, pool ), Buffer< Mutable >{} )
+			{
+				buffer= Buffer< Mutable >{ header->arena(), amount };
+				viewLimit= amount;
+			}
+
 			explicit
-			Blob( const std::size_t amount )
-				: buffer( new std::byte[ amount ]{} ), // The data must be 0'ed upon allocation.
-				viewLimit( amount )
+			BasicBlob( const std::size_t amount, Uninitialized, BlobPool &pool )
+				: BasicBlob( amount, uninitialized, &pool )
 			{}
 
 			explicit
-			Blob( const Buffer< Const > b )
-				: Buffer( b.size() )
+			BasicBlob( const std::size_t amount, BlobPool &pool )
+				: BasicBlob( amount, uninitialized, &pool )
+			{
+				zeroData( buffer ); // The data must be 0'ed upon allocation.
+			}
+
+			explicit
+			BasicBlob( const std::size_t amount )
+				: BasicBlob( amount, uninitialized )
+			{
+				zeroData( buffer ); // The data must be 0'ed upon allocation.
+			}
+
+			explicit
+			BasicBlob( const Buffer< Const > b )
+				: BasicBlob( b.size(), uninitialized )
 			{
 				copyData( buffer, b );
 			}
 
-			Blob() noexcept= default;
+			BasicBlob() noexcept= default;
 
 			// Buffer Model adaptors:
 			constexpr operator Buffer< Mutable > () noexcept { return { buffer, viewLimit }; }
@@ -207,32 +391,28 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 			 * will shrink itself down by the requested number of bytes.
 			 *
 			 * Carving is very useful to maintain a large number of `Blob` objects referring to small chunks of data
-			 * inside a large single physical backing.  This helps maintain zero-copy semantics.
+			 * inside a large single physical backing.  This helps maintain zero-copy semantics.  The reference count
+			 * lives in a header in front of the arena, so a carve costs no allocation -- only a reference count
+			 * increment.  With `LocalBlob`, that increment is not even atomic.
 			 *
 			 * @param amount The amount of data to carve off.
 			 * @return A new `Blob` object referring to the same physical data, scoped to `amount` bytes.
 			 */
-			Blob
+			BasicBlob
 			carveHead( const std::size_t amount )
 			{
 				if( amount > size() ) throw DataCarveTooLargeError( data(), amount, size() );
-				if( not storage )
-				{
-					// If there's no two-layer scheme, we have to start the sharing...
-					storage= std::make_shared< std::shared_ptr< Blob > >( std::make_shared< Blob >( std::move( *this ) ) );
 
-					// Now that it's shared, we repoint ourselves at the invisible `Blob` above.
-					buffer= (*storage)->buffer;
-					viewLimit= (*storage)->viewLimit;
-				}
-
-				// Now we assume that there's a two-layer scheme, so we operate based upon that.
+				// An empty carve shares nothing -- and an empty `Blob` object may have no arena to share.
+				if( amount == 0 ) return BasicBlob{};
 
-				Blob rv{ storage, Buffer< Mutable >{ buffer, amount } }
+				// The arena header is shared in place, so carving never allocates.
+				header->references.acquire();
+				BasicBlob rv{ header, Buffer< Mutable >{ buffer, amount } };
 				buffer= buffer + amount;
 				viewLimit-= amount;
 
-				if( size() == 0 ) *this= Blob{};
+				if( size() == 0 ) *this= BasicBlob{};
 
 				return rv;
 			}
@@ -245,31 +425,147 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 			 * @param amount The amount of data to carve off.
 			 * @return A new `Blob` object referring to the same physical data, scoped to `amount` bytes.
 			 */
-			Blob
+			BasicBlob
 			carveTail( const std::size_t amount )
 			{
 				if( amount > this->size() ) throw DataCarveTooLargeError( data(), amount, size() );
-				Blob temp= carveHead( size() - amount );
+				BasicBlob temp= carveHead( size() - amount );
 				swap( *this, temp );
 				return temp;
 			}
 
 
+			/*!
+			 * Create a `Blob` object whose arena is a memory-mapped region of a file.
+			 *
+			 * The file is mapped privately, so the data are read straight from the page cache, and any writes made
+			 * through the `Blob` are copy-on-write and never reach the file.  The mapping is released when the last
+			 * `Blob` referring to it (including those carved from it) is destroyed.  Carving and
+			 * `isContiguousWith` work on mapped `Blob` objects exactly as they do on allocated ones, so records can
+			 * be split out of a mapped file without copying.
+			 *
+			 * @param path The file to map.
+			 * @param offset The offset into the file at which the region starts.  It need not be page aligned.
+			 * @param length The length of the region.
+			 * @param pattern The expected access pattern, which is passed on to the kernel as a read-ahead hint.
+			 *
+			 * @throws std::system_error if the file cannot be opened or mapped.
+			 * @throws std::out_of_range if the region extends past the end of the file.  (Touching a mapping past
+			 * the end of its file raises `SIGBUS`, so it is not allowed to be made.)
+			 */
+			static BasicBlob
+			mapFile( const std::string &path, const std::size_t offset, const std::size_t length,
+					const AccessPattern pattern= AccessPattern::normal )
+			{
+				const int fd= openForMapping( path );
+				try
+				{
+					const std::size_t size= fileSize( fd, path );
+					if( offset > size or length > size - offset )
+					{
+						throw std::out_of_range( "Tried to map " + stringify( length ) + " bytes at offset " + stringify( offset )
+								+ " of `" + path + "`, which only has " + stringify( size ) + " bytes." );
+					}
+					BasicBlob rv= mapRegion( fd, path, offset, length, pattern );
+					::close( fd );
+					return rv;
+				}
+				catch( ... )
+				{
+					::close( fd );
+					throw;
+				}
+			}
+
+			/*!
+			 * Create a `Blob` object whose arena is an entire memory-mapped file.
+			 *
+			 * @see `Blob::mapFile( path, offset, length, pattern )`
+			 */
+			static BasicBlob
+			mapFile( const std::string &path, const AccessPattern pattern= AccessPattern::normal )
+			{
+				const int fd= openForMapping( path );
+				try
+				{
+					BasicBlob rv= mapRegion( fd, path, 0, fileSize( fd, path ), pattern );
+					::close( fd );
+					return rv;
+				}
+				catch( ... )
+				{
+					::close( fd );
+					throw;
+				}
+			}
+
+		private:
+			static int
+			openForMapping( const std::string &path )
+			{
+				const int fd= ::open( path.c_str(), O_RDONLY | O_CLOEXEC );
+				if( fd == -1 ) throw std::system_error{ errno, std::generic_category(), "Unable to open `" + path + "` for mapping" };
+				return fd;
+			}
+
+			static std::size_t
+			fileSize( const int fd, const std::string &path )
+			{
+				struct ::stat status;
+				if( ::fstat( fd, &status ) == -1 )
+				{
+					throw std::system_error{ errno, std::generic_category(), "Unable to examine `" + path + "` for mapping" };
+				}
+				return status.st_size;
+			}
+
+			static BasicBlob
+			mapRegion( const int fd, const std::string &path, const std::size_t offset, const std::size_t length,
+					const AccessPattern pattern )
+			{
+				if( length == 0 ) return BasicBlob{};
+
+				// `mmap` requires a page aligned offset, so the mapping may start a little before the region.
+				const std::size_t pageSize= ::sysconf( _SC_PAGESIZE );
+				const std::size_t slop= offset % pageSize;
+
+				void *const mapping= ::mmap( nullptr, length + slop, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, offset - slop );
+				if( mapping == MAP_FAILED ) throw std::system_error{ errno, std::generic_category(), "Unable to map `" + path + "`" };
+
+				// The advice is only a hint, so failure to apply it is not an error.
+				std::ignore= ::madvise( mapping, length + slop, adviceFor( pattern ) );
+
+				using MappedHeader= MappedArenaHeader< ReferenceCount >;
+				MappedHeader *header= nullptr;
+				try
+				{
+					header= new MappedHeader{ { {}, MappedHeader::destroyMapped }, mapping, length + slop };
+				}
+				catch( ... )
+				{
+					::munmap( mapping, length + slop );
+					throw;
+				}
+
+				return BasicBlob{ header, Buffer< Mutable >{ static_cast< std::byte * >( mapping ) + slop, length } };
+			}
+
+		public:
 			// Assorted helpers:
 
 			template< typename T > void operator []( T ) const= delete;
 			template< typename T > void operator []( T )= delete;
 
-			constexpr std::size_t capacity() const noecept { return buffer.size(); }
+			constexpr std::size_t capacity() const noexcept { return buffer.size(); }
 
 			bool
-			isContiguousWith( const Blob &other ) const & noexcept
+			isContiguousWith( const BasicBlob &other ) const & noexcept
 			{
 				return
 				(
-					storage != nullptr
+					header != nullptr
 						and
-					*storage == *other.backing
+					header == other.header
 						and
 					byte_data() + size() == other.byte_data()
 				);
@@ -284,19 +580,19 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 			 * from, thus leaving it empty.
 			 */
 			auto
-			isContiguousWith( Blob &&other ) & noexcept
+			isContiguousWith( BasicBlob &&other ) & noexcept
 			{
 				class ContiguousProof
 				{
 					private:
 						bool result;
-						Blob &self;
-						Blob &other;
+						BasicBlob &self;
+						BasicBlob &other;
 
-						friend Blob;
+						friend BasicBlob;
 
 						explicit constexpr
-						ContiguousProof( const bool result, Blob &self, Blob &other )
+						ContiguousProof( const bool result, BasicBlob &self, BasicBlob &other )
 							: result( result ), self( self ), other( other ) {}
 
 					public:
@@ -306,7 +602,8 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 						compose() const noexcept
 						{
 							assert( result );
-							self= Blob{ self.storage, Buffer< Mutable >{ self.data(), self.size() + other.size() } };
+							self.buffer= Buffer< Mutable >{ self.data(), self.size() + other.size() };
+							self.viewLimit= self.buffer.size();
 							other.reset();
 						}
 				};
@@ -314,7 +611,7 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 				return ContiguousProof{ std::as_const( *this ).isContiguousWith( other ), *this, other };
 			}
 			
-			constexpr friend std::size_t mailboxWeight( const Blob &b ) noexcept { return b.size(); }
+			constexpr friend std::size_t mailboxWeight( const BasicBlob &b ) noexcept { return b.size(); }
 
 			/*!
 			 * Determine whether some data can be appended to this `Blob` object.
@@ -329,7 +626,7 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 			 * @return `true` if the data will fit and `false` otherwise.
 			 */
 			bool
-			couldConcatenate( const Buffer< Const > buffer ) const noexcept
+			couldConcatenate( const Buffer< Const > data ) const noexcept
 			{
 				return data.size() <= ( capacity() - size() );
 			}
@@ -349,7 +646,7 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 			 * @return `true` if the data will fit and `false` otherwise.
 			 */
 			bool
-			couldConcatenate( const Blob &data ) const noexcept
+			couldConcatenate( const BasicBlob &data ) const noexcept
 			{
 				return isContiguousWith( data ) or couldConcatenate( Buffer< Const >{ data } );
 			}
@@ -372,9 +669,8 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 			[[nodiscard]] Buffer< constness >
 			concatenate( const Buffer< constness > data ) noexcept
 			{
-				const auto amount= std::min( capacity - size(), data.size() );
-				const DataWindow< const > fitted{ data, amount };
-				copyData( buffer, + size(), fitted );
+				const auto amount= std::min( capacity() - size(), data.size() );
+				copyData( buffer + size(), Buffer< Const >{ data.data(), amount } );
 				setSize( size() + amount );
 				return data + amount;
 			}
@@ -396,18 +692,18 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 			 * @return A `Blob` object owning the uncopied portion.
 			 */
 
-			[[nodiscard]] Blob
-			concatenate( Blob &&blob ) noexcept
+			[[nodiscard]] BasicBlob
+			concatenate( BasicBlob &&blob ) noexcept
 			{
 				if( const auto proof= isContiguousWith( std::move( blob ) ) )
 				{
 					proof.compose();
-					return Blob{};
+					return BasicBlob{};
 				}
 				else
 				{
-					const auto amount= concatenate( Buffer< Const >{ blob } ).size()
-					const auto rv= blob.carveTail( amount );
+					const auto amount= concatenate( Buffer< Const >{ blob } ).size();
+					auto rv= blob.carveTail( amount );
 					blob.reset();
 					return rv;
 				}
@@ -420,7 +716,8 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 			 * reallocating if necessary.  The specified `requested` is a suggested minimum allocation size.
 			 * The amount allocated will be at least that much, but may be more, if more is needed.  This function
 			 * does not attempt to amortize reallocation and copy across multiple calls.  When working with `Blob`
-			 * objects, it is the programmer's responsibility to minimize reallocation and copy overhead.
+			 * objects, it is the programmer's responsibility to minimize reallocation and copy overhead -- or to
+			 * opt in to amortization by passing a `GrowthPolicy`.
 			 *
 			 * @param data The data to append.
 			 * @param requested The suggested size to allocate -- the amount allocated will be at least this
@@ -439,14 +736,74 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 					return;
 				}
 
-				Blob tmp{ needed };
-				copyData( tmp, *this );
-				copyData( tmp + size(), data );
+				BasicBlob tmp{ needed, uninitialized };
+				const std::array< CopyRequest, 2 > pieces
+				{ {
+					{ tmp, *this },
+					{ tmp + size(), data },
+				} };
+				copyData( pieces );
+				zeroData( tmp + size() + data.size() );
 				tmp.setSize( size() + data.size() );
 				using std::swap;
 				swap( *this, tmp );
 			}
 
+			/*!
+			 * Append some data, reallocating according to a growth policy if necessary.
+			 *
+			 * Behaves as `combine( data )`, except that when a reallocation is needed, the new capacity is chosen
+			 * by `policy` (see `GeometricGrowth`, `PageRoundedGrowth`, `CappedGrowth`).  The reallocation is
+			 * recorded in `policy.statistics`.
+			 *
+			 * @param data The data to append.
+			 * @param policy The growth policy to consult, and to record statistics in.
+			 */
+			template< GrowthPolicy Policy >
+			void
+			combine( const Buffer< Const > data, Policy &policy )
+			{
+				if( couldConcatenate( data ) )
+				{
+					std::ignore= concatenate( data );
+					return;
+				}
+
+				const std::size_t needed= size() + data.size();
+				std::size_t proposed;
+				if constexpr( requires { policy.capacityFor( capacity(), needed, Header::headerSize() ); } )
+				{
+					proposed= policy.capacityFor( capacity(), needed, Header::headerSize() );
+				}
+				else proposed= policy.capacityFor( capacity(), needed );
+				const std::size_t allocation= std::max< std::size_t >( needed, proposed );
+				policy.statistics.record( allocation, needed, size() );
+				combine( data, allocation );
+			}
+
+			/*!
+			 * Append some data, growing geometrically when reallocation is necessary.
+			 *
+			 * This lets a `Blob` object act as an append-only accumulator, with amortized linear cost over a
+			 * sequence of appends.  Use `combine( data, policy )` to choose a different policy, or to collect
+			 * statistics.
+			 *
+			 * @param data The data to append.
+			 */
+			void
+			append( const Buffer< Const > data )
+			{
+				GeometricGrowth growth;
+				combine( data, growth );
+			}
+
+			template< GrowthPolicy Policy >
+			void
+			append( const Buffer< Const > data, Policy &policy )
+			{
+				combine( data, policy );
+			}
+
 			/*!
 			 * Append some data, reallocating if necessary.
 			 *
@@ -467,7 +824,7 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 			 * would otherwise not occur.
 			 */
 			void
-			combine( Blob &&blob, const std::size_t requested= 0 )
+			combine( BasicBlob &&blob, const std::size_t requested= 0 )
 			{
 				const std::size_t needed= std::max( requested, size() + blob.size() );
 				if( couldConcatenate( blob ) and needed >= requested )
@@ -482,8 +839,9 @@ namespace Alepha::inline Cavorite  ::detail::  blob
 			}
 	};
 
-	static_assert( HasCapability< Blob, swappable > );
+	static_assert( Capability< Blob, swappable > );
 	static_assert( detail::swaps::SwapLensable< Blob > );
+	static_assert( detail::swaps::SwapLensable< LocalBlob > );
 }
 
 namespace Alepha::Cavorite::inline exports::inline blob
@@ -0,0 +1,227 @@
+static_assert( __cplusplus > 2020'00 );
+
+#include <Alepha/Blob.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <unistd.h>
+
+#include <Alepha/Testing/test.h>
+#include <Alepha/Utility/evaluation_helpers.h>
+
+namespace
+{
+	using Alepha::Blob;
+
+	Blob
+	blobOf( const std::string_view text )
+	{
+		return Blob{ Alepha::make_buffer( std::string{ text } ) };
+	}
+
+	std::string_view
+	textOf( const Blob &blob )
+	{
+		return { static_cast< const char * >( blob.data() ), blob.size() };
+	}
+
+	// A temporary file holding the specified contents, removed when it goes out of scope.
+	struct TemporaryFile
+	{
+		std::string path= "/tmp/Blob.test.XXXXXX";
+
+		explicit
+		TemporaryFile( const std::string_view contents )
+		{
+			const int fd= ::mkstemp( path.data() );
+			std::ignore= ::write( fd, contents.data(), contents.size() );
+			::close( fd );
+		}
+
+		~TemporaryFile() { ::unlink( path.c_str() ); }
+	};
+}
+
+static auto init= Alepha::Utility::enroll <=[]
+{
+	using namespace Alepha::Testing::exports::literals;
+	using Alepha::Testing::exports::TestState;
+
+	"A new Blob is zeroed, and a copy is deep."_test <=[]( TestState test )
+	{
+		Blob blob{ 32 };
+		test.expect( blob.size() == 32 and blob.capacity() == 32 );
+		test.expect( std::ranges::all_of( blob, []( const std::byte b ) { return b == std::byte{}; } ) );
+
+		Blob text= blobOf( "hello" );
+		Blob copy= text;
+		test.expect( textOf( copy ) == "hello" );
+		test.expect( copy.data() != text.data() );
+
+		Blob moved= std::move( copy );
+		test.expect( textOf( moved ) == "hello" );
+		test.expect( copy.size() == 0 );
+	};
+
+	"Carving shares the arena, which outlives the Blob it was carved from."_test <=[]( TestState test )
+	{
+		Blob head;
+		Blob tail;
+		const void *arena= nullptr;
+		{
+			Blob blob= blobOf( "head:body:tail" );
+			arena= blob.data();
+
+			head= blob.carveHead( 5 );
+			tail= blob.carveTail( 4 );
+			test.expect( textOf( blob ) == "body:" );
+		}
+		test.expect( head.data() == arena );
+		test.expect( textOf( head ) == "head:" );
+		test.expect( textOf( tail ) == "tail" );
+	};
+
+	"Carving the whole of a Blob leaves it empty."_test <=[]( TestState test )
+	{
+		Blob blob= blobOf( "all" );
+		Blob all= blob.carveHead( 3 );
+		test.expect( textOf( all ) == "all" );
+		test.expect( blob.size() == 0 and blob.capacity() == 0 );
+	};
+
+	"An empty carve is empty, even from an empty Blob."_test <=[]( TestState test )
+	{
+		Blob empty;
+		test.expect( empty.carveHead( 0 ).size() == 0 );
+		test.expect( empty.carveTail( 0 ).size() == 0 );
+
+		Blob blob= blobOf( "text" );
+		test.expect( blob.carveHead( 0 ).size() == 0 );
+		test.expect( textOf( blob ) == "text" );
+	};
+
+	"Carving more than there is throws."_test <=[]( TestState test )
+	{
+		Blob blob= blobOf( "short" );
+		bool threw= false;
+		try
+		{
+			std::ignore= blob.carveHead( 6 );
+		}
+		catch( const Alepha::DataCarveTooLargeError &ex )
+		{
+			threw= ex.getRequestedSize() == 6 and ex.getAvailableSize() == 5;
+		}
+		test.expect( threw );
+		test.expect( textOf( blob ) == "short" );
+	};
+
+	"Neighbouring carves recombine without copying."_test <=[]( TestState test )
+	{
+		Blob blob= blobOf( "left|right" );
+		Blob left= blob.carveHead( 5 );
+		test.expect( left.isContiguousWith( blob ) );
+
+		const void *arena= left.data();
+		left.combine( std::move( blob ) );
+		test.expect( left.data() == arena );
+		test.expect( textOf( left ) == "left|right" );
+		test.expect( blob.size() == 0 );
+	};
+
+	"Blobs which are not neighbours combine by copying."_test <=[]( TestState test )
+	{
+		Blob first= blobOf( "one " );
+		Blob second= blobOf( "two" );
+		test.expect( not first.isContiguousWith( second ) );
+
+		first.combine( std::move( second ) );
+		test.expect( textOf( first ) == "one two" );
+		test.expect( second.size() == 0 );
+	};
+
+	"A LocalBlob carves just as a Blob does."_test <=[]( TestState test )
+	{
+		Alepha::LocalBlob blob{ Alepha::make_buffer( std::string{ "local" } ) };
+		Alepha::LocalBlob head= blob.carveHead( 2 );
+		test.expect( head.size() == 2 and blob.size() == 3 );
+		test.expect( static_cast< const std::byte * >( head.data() ) + 2 == blob.data() );
+	};
+
+	"A mapped file reads as a Blob, and carves as one."_test <=[]( TestState test )
+	{
+		std::string contents;
+		for( int i= 0; i < 2000; ++i ) contents+= "line " + std::to_string( i ) + "\n";
+		const TemporaryFile file{ contents };
+
+		Blob whole= Alepha::Blob::mapFile( file.path, Alepha::AccessPattern::sequential );
+		test.expect( textOf( whole ) == contents );
+
+		// The region need not start on a page boundary.
+		const std::size_t offset= 5003;
+		const Blob region= Alepha::Blob::mapFile( file.path, offset, 100 );
+		test.expect( textOf( region ) == std::string_view{ contents }.substr( offset, 100 ) );
+
+		Blob head= whole.carveHead( 10 );
+		whole.reset();
+		test.expect( textOf( head ) == std::string_view{ contents }.substr( 0, 10 ) );
+	};
+
+	"Writes through a mapped Blob never reach the file."_test <=[]( TestState test )
+	{
+		const TemporaryFile file{ "original" };
+		{
+			Blob mapped= Alepha::Blob::mapFile( file.path );
+			std::ranges::fill( mapped, std::byte{ 'X' } );
+			test.expect( textOf( mapped ) == "XXXXXXXX" );
+		}
+		test.expect( textOf( Alepha::Blob::mapFile( file.path ) ) == "original" );
+	};
+
+	"A region which extends past the end of the file is refused, rather than mapped."_test <=[]( TestState test )
+	{
+		const TemporaryFile file{ "0123456789" };
+		const auto refused= [&]( const std::size_t offset, const std::size_t length )
+		{
+			try
+			{
+				std::ignore= Alepha::Blob::mapFile( file.path, offset, length );
+			}
+			catch( const std::out_of_range & )
+			{
+				return true;
+			}
+			return false;
+		};
+
+		test.expect( not refused( 8, 2 ) );
+		test.expect( not refused( 10, 0 ) );
+		test.expect( refused( 8, 3 ) );
+		test.expect( refused( 11, 0 ) );
+		test.expect( refused( 2, std::size_t( -1 ) ) );
+		test.expect( textOf( Alepha::Blob::mapFile( file.path, 8, 2 ) ) == "89" );
+	};
+
+	"Mapping an empty file gives an empty Blob, and a missing one throws."_test <=[]( TestState test )
+	{
+		const TemporaryFile file{ "" };
+		test.expect( Alepha::Blob::mapFile( file.path ).size() == 0 );
+
+		bool threw= false;
+		try
+		{
+			std::ignore= Alepha::Blob::mapFile( file.path + ".missing" );
+		}
+		catch( const std::system_error & )
+		{
+			threw= true;
+		}
+		test.expect( threw );
+	};
+};
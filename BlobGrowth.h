@@ -0,0 +1,145 @@
+static_assert( __cplusplus > 2020'00 );
+
+#pragma once
+
+#include <cstddef>
+
+#include <algorithm>
+#include <concepts>
+
+#include <unistd.h>
+
+namespace Alepha::inline Cavorite  ::detail::  blob_growth
+{
+	inline namespace exports
+	{
+		struct GrowthStatistics;
+
+		struct ExactGrowth;
+		struct GeometricGrowth;
+		struct PageRoundedGrowth;
+		struct CappedGrowth;
+	}
+
+	/*!
+	 * Running totals of the reallocations made under a growth policy.
+	 *
+	 * A single policy object can be shared by many `Blob` objects, in which case the statistics cover all of
+	 * them.  This is meant for tuning policies against real workloads.
+	 */
+	struct exports::GrowthStatistics
+	{
+		std::size_t reallocations= 0;
+		std::size_t bytesCopied= 0; // Existing data moved into a new arena, across all reallocations.
+		std::size_t bytesAllocated= 0; // The total capacity of all new arenas.
+		std::size_t bytesSlack= 0; // Capacity beyond what was needed, at the time of each reallocation.
+
+		void
+		record( const std::size_t allocated, const std::size_t needed, const std::size_t copied ) noexcept
+		{
+			++reallocations;
+			bytesCopied+= copied;
+			bytesAllocated+= allocated;
+			bytesSlack+= allocated - needed;
+		}
+
+		// The fraction of allocated capacity which was not needed when it was allocated.
+		double
+		wasteRatio() const noexcept
+		{
+			return bytesAllocated ? double( bytesSlack ) / bytesAllocated : 0.0;
+		}
+	};
+
+	namespace exports
+	{
+		/*!
+		 * A growth policy decides how large a new arena should be, when appending to a `Blob` object requires
+		 * reallocation.
+		 *
+		 * `capacityFor( capacity, needed )` is given the current capacity and the size which is needed, and
+		 * returns the capacity to allocate.  (Results smaller than `needed` are ignored.)  Every policy carries
+		 * `GrowthStatistics`, which record its decisions.
+		 *
+		 * A policy which cares about the size of the whole allocation may also accept `capacityFor( capacity,
+		 * needed, overhead )`, where `overhead` is the size of the header which is allocated in front of the
+		 * arena.  `Blob` calls that form when it exists.
+		 */
+		template< typename Policy >
+		concept GrowthPolicy= requires( const Policy &policy, Policy &mutablePolicy, const std::size_t amount )
+		{
+			{ policy.capacityFor( amount, amount ) } -> std::convertible_to< std::size_t >;
+			{ mutablePolicy.statistics } -> std::convertible_to< GrowthStatistics & >;
+		};
+	}
+
+	/*!
+	 * Allocate exactly what is needed.  This is what `Blob::combine` does without a policy.
+	 */
+	struct exports::ExactGrowth
+	{
+		GrowthStatistics statistics;
+
+		std::size_t capacityFor( std::size_t, const std::size_t needed ) const noexcept { return needed; }
+	};
+
+	/*!
+	 * Grow the capacity by a constant factor, which makes a sequence of appends cost amortized linear time.
+	 */
+	struct exports::GeometricGrowth
+	{
+		double factor= 2.0;
+		GrowthStatistics statistics;
+
+		std::size_t
+		capacityFor( const std::size_t capacity, const std::size_t needed ) const noexcept
+		{
+			return std::max( needed, std::size_t( capacity * factor ) );
+		}
+	};
+
+	/*!
+	 * Grow geometrically, rounding each allocation up to a whole number of pages.
+	 *
+	 * Large arenas come straight from the kernel in whole pages anyway, so the rounding claims capacity which
+	 * would otherwise be lost.  The arena's header is counted in the allocation, so the capacity is a whole
+	 * number of pages less the header.
+	 */
+	struct exports::PageRoundedGrowth
+	{
+		double factor= 2.0;
+		std::size_t pageSize= ::sysconf( _SC_PAGESIZE );
+		GrowthStatistics statistics;
+
+		std::size_t
+		capacityFor( const std::size_t capacity, const std::size_t needed, const std::size_t overhead= 0 ) const noexcept
+		{
+			const std::size_t target= std::max( needed, std::size_t( capacity * factor ) ) + overhead;
+			return ( target + pageSize - 1 ) / pageSize * pageSize - overhead;
+		}
+	};
+
+	/*!
+	 * Grow geometrically, but never allocate more than `maximumSlack` bytes beyond what is needed.
+	 *
+	 * This bounds the memory wasted by very large accumulators, at the cost of linear (rather than amortized
+	 * constant) growth once the cap is reached.
+	 */
+	struct exports::CappedGrowth
+	{
+		double factor= 2.0;
+		std::size_t maximumSlack= std::size_t{ 1 } << 20;
+		GrowthStatistics statistics;
+
+		std::size_t
+		capacityFor( const std::size_t capacity, const std::size_t needed ) const noexcept
+		{
+			return std::clamp( std::size_t( capacity * factor ), needed, needed + maximumSlack );
+		}
+	};
+}
+
+namespace Alepha::Cavorite::inline exports::inline blob_growth
+{
+	using namespace detail::blob_growth::exports;
+}
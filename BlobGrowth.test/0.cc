@@ -0,0 +1,121 @@
+static_assert( __cplusplus > 2020'00 );
+
+#include <Alepha/BlobGrowth.h>
+
+#include <string>
+#include <string_view>
+
+#include <unistd.h>
+
+#include <Alepha/Blob.h>
+
+#include <Alepha/Testing/test.h>
+#include <Alepha/Testing/TableTest.h>
+#include <Alepha/Utility/evaluation_helpers.h>
+
+namespace
+{
+	using namespace Alepha::Testing::exports;
+
+	std::size_t exact( const std::size_t capacity, const std::size_t needed ) { return Alepha::ExactGrowth{}.capacityFor( capacity, needed ); }
+	std::size_t geometric( const std::size_t capacity, const std::size_t needed ) { return Alepha::GeometricGrowth{}.capacityFor( capacity, needed ); }
+	std::size_t
+	pageRounded( const std::size_t capacity, const std::size_t needed, const std::size_t overhead )
+	{
+		Alepha::PageRoundedGrowth policy;
+		policy.pageSize= 4096;
+		return policy.capacityFor( capacity, needed, overhead );
+	}
+
+	std::size_t
+	capped( const std::size_t capacity, const std::size_t needed )
+	{
+		return Alepha::CappedGrowth{ .maximumSlack= 1000 }.capacityFor( capacity, needed );
+	}
+
+	// Append `count` copies of `piece` to an empty `Blob`, under `policy`.
+	template< typename Policy >
+	std::string
+	accumulate( const std::string_view piece, const int count, Policy &policy )
+	{
+		Alepha::Blob blob;
+		for( int i= 0; i < count; ++i ) blob.append( Alepha::Buffer< Alepha::Const >{ piece.data(), piece.size() }, policy );
+		return { static_cast< const char * >( blob.data() ), blob.size() };
+	}
+}
+
+static auto init= Alepha::Utility::enroll <=[]
+{
+	"ExactGrowth allocates only what is needed."_test <=TableTest< exact >::Cases
+	{
+		{ "From nothing", { 0, 10 }, 10 },
+		{ "From some", { 100, 150 }, 150 },
+	};
+
+	"GeometricGrowth doubles, or allocates what is needed if that is more."_test <=TableTest< geometric >::Cases
+	{
+		{ "From nothing", { 0, 10 }, 10 },
+		{ "Doubled", { 100, 150 }, 200 },
+		{ "Needed more than double", { 100, 500 }, 500 },
+	};
+
+	"PageRoundedGrowth rounds the whole allocation up to whole pages."_test <=TableTest< pageRounded >::Cases
+	{
+		{ "Small", { 0, 10, 0 }, 4096 },
+		{ "Doubled then rounded", { 3000, 3100, 0 }, 8192 },
+		{ "Exact pages", { 4096, 5000, 0 }, 8192 },
+		{ "Small, with a header", { 0, 10, 32 }, 4064 },
+		{ "Doubled, with a header", { 3000, 3100, 32 }, 8160 },
+		{ "Filling a page, with a header", { 0, 4064, 32 }, 4064 },
+		{ "Over a page, with a header", { 0, 4065, 32 }, 8160 },
+	};
+
+	"CappedGrowth never allocates more than its slack beyond the need."_test <=TableTest< capped >::Cases
+	{
+		{ "Doubling within the cap", { 500, 600 }, 1000 },
+		{ "Doubling beyond the cap", { 10'000, 10'001 }, 11'001 },
+		{ "Need above double", { 100, 300 }, 300 },
+	};
+
+	"Geometric appends reallocate logarithmically often."_test <=[]( TestState test )
+	{
+		Alepha::GeometricGrowth geometric;
+		const std::string text= accumulate( "0123456789", 1000, geometric );
+		test.expect( text.size() == 10'000 );
+		test.expect( text.substr( 9'990 ) == "0123456789" );
+		test.expect( geometric.statistics.reallocations <= 12 );
+		test.expect( geometric.statistics.bytesSlack > 0 );
+
+		Alepha::ExactGrowth exact;
+		test.expect( accumulate( "0123456789", 1000, exact ) == text );
+		test.expect( exact.statistics.reallocations == 1000 );
+		test.expect( exact.statistics.bytesSlack == 0 );
+		test.expect( exact.statistics.wasteRatio() == 0.0 );
+	};
+
+	"A page rounded Blob's allocation, header included, is whole pages."_test <=[]( TestState test )
+	{
+		using Header= Alepha::Cavorite::detail::blob::ArenaHeader< Alepha::AtomicReferenceCount >;
+		const std::size_t pageSize= ::sysconf( _SC_PAGESIZE );
+
+		Alepha::PageRoundedGrowth policy;
+		Alepha::Blob blob;
+		const std::string piece( 1000, 'x' );
+		for( int i= 0; i < 20; ++i )
+		{
+			blob.append( Alepha::Buffer< Alepha::Const >{ piece.data(), piece.size() }, policy );
+			test.expect( ( blob.capacity() + Header::headerSize() ) % pageSize == 0 );
+		}
+		test.expect( blob.size() == 20'000 );
+		test.expect( policy.statistics.reallocations < 20 );
+	};
+
+	"Appending without a policy grows geometrically."_test <=[]( TestState test )
+	{
+		Alepha::Blob blob;
+		const std::string_view piece= "abc";
+		for( int i= 0; i < 100; ++i ) blob.append( Alepha::Buffer< Alepha::Const >{ piece.data(), piece.size() } );
+		test.expect( blob.size() == 300 );
+		test.expect( blob.capacity() > blob.size() );
+	};
+};
@@ -0,0 +1,814 @@
+static_assert( __cplusplus > 2020'00 );
+
+#pragma once
+
+#include <Alepha/Alepha.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <cerrno>
+#include <climits>
+
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#include <linux/io_uring.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <Alepha/Blob.h>
+#include <Alepha/DataChain.h>
+
+#include <Alepha/Utility/evaluation_helpers.h>
+
+namespace Alepha::inline Cavorite  ::detail::  blob_io
+{
+	inline namespace exports
+	{
+		/*!
+		 * Called when a read completes.
+		 *
+		 * The `Blob` holds exactly the bytes which were read.  It is empty at end of file, and when the read
+		 * failed, in which case the error is also set.
+		 */
+		using ReadHandler= std::function< void ( Blob, std::error_code ) >;
+
+		/*!
+		 * Called when a write completes, with the number of bytes written.
+		 *
+		 * A write only completes once the whole chain has been written, or an error has occurred.
+		 */
+		using WriteHandler= std::function< void ( std::size_t, std::error_code ) >;
+
+		class BlobIoEngine;
+		class UringBlobIoEngine;
+		class EpollBlobIoEngine;
+
+		std::unique_ptr< BlobIoEngine > makeBlobIoEngine();
+	}
+
+	namespace C
+	{
+		const bool debug= false;
+
+		// The number of submission queue entries requested from the kernel.
+		const unsigned ringEntries= 256;
+
+		// Reads are made into these registered arenas, when they fit.  Records are carved from the front of
+		// an arena as they arrive, and a fresh arena is registered in its place once it is used up.
+		const std::size_t fixedArenas= 16;
+		const std::size_t fixedArenaSize= 256 * 1024;
+
+		const int maxEpollEvents= 64;
+	}
+
+	using namespace Utility::exports::evaluation_helpers;
+
+	/*!
+	 * An engine which performs reads into `Blob` objects, and writes from `DataChain` objects, asynchronously.
+	 *
+	 * Operations are queued by `read` and `write`, handed to the kernel (as one batch) by `submit`, and their
+	 * handlers are called from `complete`.  Handlers may queue further operations.
+	 *
+	 * An engine is not thread safe: it is meant to be driven by one event loop thread.
+	 *
+	 * @see `makeBlobIoEngine`
+	 */
+	class exports::BlobIoEngine
+		: boost::noncopyable
+	{
+		public:
+			virtual ~BlobIoEngine()= default;
+
+			/*!
+			 * Queue a read of up to `amount` bytes from `fd`, at its current position.
+			 *
+			 * @note The read is not started until the next `submit` call.
+			 */
+			virtual void read( int fd, std::size_t amount, ReadHandler handler )= 0;
+
+			/*!
+			 * Queue a write of an entire chain to `fd`.
+			 *
+			 * Short writes are resumed by the engine, so the handler is only called once.
+			 *
+			 * @note The write is not started until the next `submit` call.
+			 */
+			virtual void write( int fd, DataChain chain, WriteHandler handler )= 0;
+
+			/*!
+			 * Start every queued operation.
+			 *
+			 * @return The number of operations started.
+			 */
+			virtual std::size_t submit()= 0;
+
+			/*!
+			 * Call the handlers of completed operations.
+			 *
+			 * @param wait When set, and no operation has completed yet, block until one does.
+			 * @return The number of handlers called.
+			 */
+			virtual std::size_t complete( bool wait )= 0;
+
+			// The number of operations which have been queued but whose handlers have not yet been called.
+			virtual std::size_t pending() const noexcept= 0;
+	};
+
+	/*!
+	 * A `BlobIoEngine` built on an io_uring submission and completion ring.
+	 *
+	 * Every operation queued before a `submit` call goes to the kernel in one `io_uring_enter` call, and every
+	 * completion which is ready is collected without any system call at all.
+	 *
+	 * Reads which fit are made with `IORING_OP_READ_FIXED` into a small set of registered arenas, which spares
+	 * the kernel from pinning pages on every read.  Each completed read is carved off the front of its arena as
+	 * a `Blob` of its own, without copying, so the arena is shared by many records.  When an arena is used up,
+	 * a fresh one (from the thread's `BlobPool`) is registered in its place; the old one is freed once the last
+	 * record carved from it is released.  Larger reads use `IORING_OP_READ` into a freshly allocated `Blob`.
+	 *
+	 * Writes use `IORING_OP_WRITEV`, straight from the segments of the chain.  Writes to one descriptor are made
+	 * one at a time, in the order they were queued, as they are by `EpollBlobIoEngine`.
+	 *
+	 * Destroying the engine cancels every operation still in flight, and waits for the kernel to finish with
+	 * each of them, without calling their handlers.
+	 *
+	 * @throws std::system_error from the constructor, if the kernel does not support io_uring.
+	 */
+	class exports::UringBlobIoEngine
+		: public BlobIoEngine
+	{
+		private:
+			struct Operation
+			{
+				int fd;
+
+				ReadHandler onRead;
+				Blob target; // Where a read which is not made into a fixed arena lands.
+				std::optional< std::size_t > arena; // The fixed arena which a read lands in, if any.
+				std::size_t amount= 0;
+
+				WriteHandler onWrite;
+				DataChain chain;
+				std::vector< ::iovec > vector;
+				std::size_t written= 0;
+
+				bool isRead() const noexcept { return bool( onRead ); }
+			};
+
+			struct FixedArena
+			{
+				Blob remaining; // The part of the arena which has not yet been carved off.
+				bool busy= false;
+			};
+
+			int ringFd= -1;
+
+			void *submissionRing= MAP_FAILED;
+			std::size_t submissionRingSize= 0;
+			void *completionRing= MAP_FAILED;
+			std::size_t completionRingSize= 0;
+			::io_uring_sqe *entries= static_cast< ::io_uring_sqe * >( MAP_FAILED );
+			std::size_t entriesSize= 0;
+
+			unsigned *sqHead;
+			unsigned *sqTail;
+			unsigned sqMask;
+			unsigned *sqArray;
+			unsigned sqCapacity;
+
+			unsigned *cqHead;
+			unsigned *cqTail;
+			unsigned cqMask;
+			::io_uring_cqe *cqes;
+
+			std::vector< FixedArena > arenas;
+
+			std::deque< std::unique_ptr< Operation > > queued;
+			unsigned prepared= 0; // Entries written to the submission ring, but not yet entered.
+
+			// The kernel does not order the entries of one batch, so only one write per descriptor is outstanding
+			// (queued or in flight) at a time.  A descriptor is a key here while it has one, and the writes queued
+			// after it wait here, in order.
+			std::map< int, std::deque< std::unique_ptr< Operation > > > writesBehind;
+
+			// Operations in the kernel's hands, by the `user_data` of their entries.
+			std::map< const Operation *, std::unique_ptr< Operation > > active;
+
+			template< typename T >
+			static T *
+			at( void *const base, const std::size_t offset ) noexcept
+			{
+				return reinterpret_cast< T * >( static_cast< std::byte * >( base ) + offset );
+			}
+
+			static unsigned load( unsigned *const p ) noexcept { return std::atomic_ref{ *p }.load( std::memory_order_acquire ); }
+			static void store( unsigned *const p, const unsigned v ) noexcept { std::atomic_ref{ *p }.store( v, std::memory_order_release ); }
+
+			int
+			enter( const unsigned toSubmit, const unsigned minimum, const unsigned flags )
+			{
+				while( true )
+				{
+					const int rv= ::syscall( __NR_io_uring_enter, ringFd, toSubmit, minimum, flags, nullptr, 0 );
+					if( rv != -1 ) return rv;
+					if( errno == EINTR ) continue;
+					throw std::system_error{ errno, std::generic_category(), "`io_uring_enter` failed" };
+				}
+			}
+
+			static void *
+			mapRing( const int fd, const std::size_t length, const off_t offset )
+			{
+				void *const rv= ::mmap( nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset );
+				if( rv == MAP_FAILED ) throw std::system_error{ errno, std::generic_category(), "Unable to map io_uring" };
+				return rv;
+			}
+
+			void
+			registerArenas()
+			{
+				arenas.resize( C::fixedArenas );
+				std::vector< ::iovec > vector;
+				for( auto &arena: arenas )
+				{
+					arena.remaining= Blob{ C::fixedArenaSize, uninitialized };
+					vector.push_back( { arena.remaining.data(), arena.remaining.size() } );
+				}
+
+				::io_uring_rsrc_register registration{};
+				registration.nr= vector.size();
+				registration.data= reinterpret_cast< std::uintptr_t >( vector.data() );
+				const int rv= ::syscall( __NR_io_uring_register, ringFd, IORING_REGISTER_BUFFERS2,
+						&registration, sizeof( registration ) );
+
+				// Kernels before 5.13 cannot replace registered buffers, so every read goes to a fresh `Blob`.
+				if( rv == -1 ) arenas.clear();
+			}
+
+			// Replace a used-up arena.  The old arena lives on in the records which were carved from it.
+			bool
+			replaceArena( const std::size_t index )
+			{
+				Blob fresh{ C::fixedArenaSize, uninitialized };
+				::iovec vector{ fresh.data(), fresh.size() };
+
+				::io_uring_rsrc_update2 update{};
+				update.offset= index;
+				update.data= reinterpret_cast< std::uintptr_t >( &vector );
+				update.nr= 1;
+				if( ::syscall( __NR_io_uring_register, ringFd, IORING_REGISTER_BUFFERS_UPDATE, &update, sizeof( update ) ) == -1 )
+				{
+					return false;
+				}
+
+				arenas.at( index ).remaining= std::move( fresh );
+				return true;
+			}
+
+			std::optional< std::size_t >
+			chooseArena( const std::size_t amount )
+			{
+				if( amount > C::fixedArenaSize ) return std::nullopt;
+
+				for( std::size_t i= 0; i < arenas.size(); ++i )
+				{
+					if( not arenas[ i ].busy and arenas[ i ].remaining.size() >= amount ) return i;
+				}
+				for( std::size_t i= 0; i < arenas.size(); ++i )
+				{
+					if( not arenas[ i ].busy and replaceArena( i ) ) return i;
+				}
+				return std::nullopt;
+			}
+
+			bool ringFull() noexcept { return *sqTail - load( sqHead ) >= sqCapacity; }
+
+			// Write one entry to the submission ring, which must have room for it.  Only a complete entry is
+			// published to the kernel.
+			template< typename Fill >
+			void
+			pushEntry( Fill fill ) noexcept
+			{
+				const unsigned tail= *sqTail;
+				const unsigned index= tail & sqMask;
+				entries[ index ]= ::io_uring_sqe{};
+				fill( entries[ index ] );
+				sqArray[ index ]= index;
+				store( sqTail, tail + 1 );
+				++prepared;
+			}
+
+			// Everything which an operation needs before its entry is written, and which may throw.
+			void
+			stage( Operation &op )
+			{
+				if( op.isRead() )
+				{
+					if( not op.arena ) op.arena= chooseArena( op.amount );
+					if( op.arena ) arenas.at( *op.arena ).busy= true;
+					else if( op.target.capacity() < op.amount ) op.target= Blob{ op.amount, uninitialized };
+				}
+				else
+				{
+					op.vector.clear();
+					const auto &segments= std::as_const( op.chain ).chain_view();
+					const std::size_t limit= std::min< std::size_t >( segments.size(), IOV_MAX );
+					std::transform( segments.begin(), segments.begin() + limit, back_inserter( op.vector ),
+							[]( const Blob &segment ) { return ::iovec{ const_cast< void * >( segment.data() ), segment.size() }; } );
+				}
+			}
+
+			void
+			fill( ::io_uring_sqe &entry, Operation &op ) noexcept
+			{
+				entry.fd= op.fd;
+				entry.off= std::uint64_t( -1 ); // The current file position, or none for streams.
+				entry.user_data= reinterpret_cast< std::uintptr_t >( &op );
+
+				if( op.isRead() and op.arena )
+				{
+					entry.opcode= IORING_OP_READ_FIXED;
+					entry.addr= reinterpret_cast< std::uintptr_t >( arenas[ *op.arena ].remaining.data() );
+					entry.len= op.amount;
+					entry.buf_index= *op.arena;
+				}
+				else if( op.isRead() )
+				{
+					entry.opcode= IORING_OP_READ;
+					entry.addr= reinterpret_cast< std::uintptr_t >( op.target.data() );
+					entry.len= op.amount;
+				}
+				else
+				{
+					entry.opcode= IORING_OP_WRITEV;
+					entry.addr= reinterpret_cast< std::uintptr_t >( op.vector.data() );
+					entry.len= op.vector.size();
+				}
+			}
+
+			// The completions which are ready, with the ring's head moved past them.
+			std::vector< std::pair< std::uintptr_t, int > >
+			reap()
+			{
+				std::vector< std::pair< std::uintptr_t, int > > rv;
+				const unsigned tail= load( cqTail );
+				for( unsigned head= *cqHead; head != tail; ++head )
+				{
+					const ::io_uring_cqe &cqe= cqes[ head & cqMask ];
+					rv.emplace_back( cqe.user_data, cqe.res );
+				}
+				store( cqHead, tail );
+				return rv;
+			}
+
+			// Ask the kernel to cancel every active operation, and wait until it has finished with all of them.
+			// Their handlers are not called.
+			void
+			cancelAll()
+			{
+				for( const auto &[ op, owned ]: active )
+				{
+					if( ringFull() ) enter( std::exchange( prepared, 0 ), 0, 0 );
+					pushEntry( [op= op]( ::io_uring_sqe &entry )
+					{
+						entry.opcode= IORING_OP_ASYNC_CANCEL;
+						entry.fd= -1;
+						entry.addr= reinterpret_cast< std::uintptr_t >( op );
+						entry.user_data= 0; // Cancellations are told apart from operations by this.
+					} );
+				}
+				if( prepared ) enter( std::exchange( prepared, 0 ), 0, 0 );
+
+				while( not active.empty() )
+				{
+					enter( 0, 1, IORING_ENTER_GETEVENTS );
+					for( const auto &[ userData, result ]: reap() )
+					{
+						active.erase( reinterpret_cast< const Operation * >( userData ) );
+					}
+				}
+			}
+
+			// Handle one completion.  Returns true when the operation is finished, and its handler should run.
+			bool
+			finish( Operation &op, const int result )
+			{
+				if( op.isRead() )
+				{
+					const std::error_code error= result < 0 ? std::error_code{ -result, std::generic_category() } : std::error_code{};
+					const std::size_t amount= result > 0 ? result : 0;
+					if( op.arena )
+					{
+						FixedArena &arena= arenas.at( *op.arena );
+						arena.busy= false;
+						op.target= arena.remaining.carveHead( amount );
+					}
+					else op.target.setSize( amount );
+					op.onRead( std::move( op.target ), error );
+					return true;
+				}
+
+				if( result < 0 )
+				{
+					if( result == -EINTR or result == -EAGAIN ) return false;
+					op.onWrite( op.written, std::error_code{ -result, std::generic_category() } );
+					return true;
+				}
+
+				op.written+= result;
+				std::ignore= op.chain.carveHeadChain( result );
+				if( op.chain.size() ) return false;
+
+				op.onWrite( op.written, {} );
+				return true;
+			}
+
+			// Operations still in flight must have been reaped first (see `cancelAll`): closing the ring does not
+			// stop the kernel from writing into their buffers.
+			void
+			release() noexcept
+			{
+				if( entries != MAP_FAILED ) ::munmap( entries, entriesSize );
+				if( completionRing != MAP_FAILED and completionRing != submissionRing ) ::munmap( completionRing, completionRingSize );
+				if( submissionRing != MAP_FAILED ) ::munmap( submissionRing, submissionRingSize );
+				if( ringFd != -1 ) ::close( ringFd );
+			}
+
+		public:
+			explicit
+			UringBlobIoEngine( const unsigned depth= C::ringEntries )
+			{
+				::io_uring_params params{};
+				ringFd= ::syscall( __NR_io_uring_setup, depth, &params );
+				if( ringFd == -1 ) throw std::system_error{ errno, std::generic_category(), "`io_uring_setup` failed" };
+
+				try
+				{
+					submissionRingSize= params.sq_off.array + params.sq_entries * sizeof( unsigned );
+					completionRingSize= params.cq_off.cqes + params.cq_entries * sizeof( ::io_uring_cqe );
+					if( params.features & IORING_FEAT_SINGLE_MMAP )
+					{
+						submissionRingSize= completionRingSize= std::max( submissionRingSize, completionRingSize );
+					}
+
+					submissionRing= mapRing( ringFd, submissionRingSize, IORING_OFF_SQ_RING );
+					if( params.features & IORING_FEAT_SINGLE_MMAP ) completionRing= submissionRing;
+					else completionRing= mapRing( ringFd, completionRingSize, IORING_OFF_CQ_RING );
+
+					entriesSize= params.sq_entries * sizeof( ::io_uring_sqe );
+					entries= static_cast< ::io_uring_sqe * >( mapRing( ringFd, entriesSize, IORING_OFF_SQES ) );
+				}
+				catch( ... )
+				{
+					release();
+					throw;
+				}
+
+				sqHead= at< unsigned >( submissionRing, params.sq_off.head );
+				sqTail= at< unsigned >( submissionRing, params.sq_off.tail );
+				sqMask= *at< unsigned >( submissionRing, params.sq_off.ring_mask );
+				sqArray= at< unsigned >( submissionRing, params.sq_off.array );
+				sqCapacity= params.sq_entries;
+
+				cqHead= at< unsigned >( completionRing, params.cq_off.head );
+				cqTail= at< unsigned >( completionRing, params.cq_off.tail );
+				cqMask= *at< unsigned >( completionRing, params.cq_off.ring_mask );
+				cqes= at< ::io_uring_cqe >( completionRing, params.cq_off.cqes );
+
+				registerArenas();
+			}
+
+			~UringBlobIoEngine() override
+			{
+				try
+				{
+					cancelAll();
+				}
+				catch( const std::system_error & )
+				{
+					// The ring itself has failed, so there is nothing more which can be done to stop its I/O.
+				}
+				release();
+			}
+
+			void
+			read( const int fd, const std::size_t amount, ReadHandler handler ) override
+			{
+				auto op= std::make_unique< Operation >();
+				op->fd= fd;
+				op->onRead= std::move( handler );
+				op->amount= amount;
+				queued.push_back( std::move( op ) );
+			}
+
+			void
+			write( const int fd, DataChain chain, WriteHandler handler ) override
+			{
+				auto op= std::make_unique< Operation >();
+				op->fd= fd;
+				op->onWrite= std::move( handler );
+				op->chain= std::move( chain );
+
+				if( const auto found= writesBehind.find( fd ); found != end( writesBehind ) ) found->second.push_back( std::move( op ) );
+				else
+				{
+					queued.push_back( std::move( op ) );
+					writesBehind.try_emplace( fd );
+				}
+			}
+
+			std::size_t
+			submit() override
+			{
+				std::size_t rv= 0;
+				while( not queued.empty() )
+				{
+					// Everything which can throw is done before the entry is written, so that a failure never
+					// leaves a half-written entry in the ring.
+					Operation &op= *queued.front();
+					stage( op );
+
+					// When the ring is full, hand what is there to the kernel, which frees its entries.
+					if( ringFull() ) enter( std::exchange( prepared, 0 ), 0, 0 );
+
+					active.emplace( &op, std::move( queued.front() ) );
+					queued.pop_front();
+					pushEntry( [&]( ::io_uring_sqe &entry ) { fill( entry, op ); } );
+					++rv;
+				}
+				if( prepared ) enter( std::exchange( prepared, 0 ), 0, 0 );
+				return rv;
+			}
+
+			std::size_t
+			complete( const bool wait ) override
+			{
+				if( wait and not active.empty() and load( cqTail ) == *cqHead ) enter( 0, 1, IORING_ENTER_GETEVENTS );
+
+				// The completions are copied out first, so that handlers may freely queue and submit more work.
+				std::size_t rv= 0;
+				for( const auto &[ userData, result ]: reap() )
+				{
+					auto found= active.extract( reinterpret_cast< const Operation * >( userData ) );
+					if( found.empty() ) continue;
+
+					std::unique_ptr< Operation > op= std::move( found.mapped() );
+					if( not finish( *op, result ) )
+					{
+						// A short write; the rest goes out on the next `submit`, still ahead of any later write.
+						queued.push_front( std::move( op ) );
+						continue;
+					}
+					++rv;
+
+					if( op->isRead() ) continue;
+					const auto behind= writesBehind.find( op->fd );
+					if( behind->second.empty() ) writesBehind.erase( behind );
+					else
+					{
+						queued.push_back( std::move( behind->second.front() ) );
+						behind->second.pop_front();
+					}
+				}
+				return rv;
+			}
+
+			std::size_t
+			pending() const noexcept override
+			{
+				std::size_t rv= queued.size() + active.size();
+				for( const auto &[ fd, ops ]: writesBehind ) rv+= ops.size();
+				return rv;
+			}
+	};
+
+	/*!
+	 * A `BlobIoEngine` for kernels without io_uring, built on `epoll` and plain `read` and `writev` calls.
+	 *
+	 * Operations are attempted directly when submitted, and those which would block wait for readiness on an
+	 * `epoll` instance.  (Regular files are always ready, and so are never waited upon.)  File descriptors are
+	 * expected to be non-blocking; a blocking descriptor simply makes the engine synchronous.  Handlers are only
+	 * ever called from `complete`, just as with `UringBlobIoEngine`.
+	 *
+	 * @throws std::system_error from the constructor, if the `epoll` instance cannot be created.
+	 */
+	class exports::EpollBlobIoEngine
+		: public BlobIoEngine
+	{
+		private:
+			struct Operation
+			{
+				int fd;
+				std::size_t amount= 0;
+				ReadHandler onRead;
+				WriteHandler onWrite;
+				DataChain chain;
+				std::size_t written= 0;
+
+				bool isRead() const noexcept { return bool( onRead ); }
+			};
+
+			int epollFd= -1;
+
+			std::deque< Operation > queued;
+
+			// Operations waiting for their file descriptor to become ready, in order per descriptor.
+			std::map< int, std::deque< Operation > > waiting;
+
+			std::deque< std::function< void () > > ready;
+
+			// Attempt an operation.  Returns false if it would block.
+			bool
+			attempt( Operation &op )
+			{
+				if( op.isRead() )
+				{
+					Blob target{ op.amount, uninitialized };
+					const ::ssize_t amount= evaluate <=[&]
+					{
+						while( true )
+						{
+							const ::ssize_t rv= ::read( op.fd, target.data(), target.size() );
+							if( rv != -1 or errno != EINTR ) return rv;
+						}
+					};
+					if( amount == -1 and ( errno == EAGAIN or errno == EWOULDBLOCK ) ) return false;
+
+					const std::error_code error= amount == -1 ? std::error_code{ errno, std::generic_category() } : std::error_code{};
+					target.setSize( amount == -1 ? 0 : amount );
+					ready.push_back( [handler= std::move( op.onRead ), target= std::move( target ), error] () mutable
+					{
+						handler( std::move( target ), error );
+					} );
+					return true;
+				}
+
+				try
+				{
+					op.written+= op.chain.writeTo( op.fd );
+				}
+				catch( const std::system_error &ex )
+				{
+					ready.push_back( std::bind( std::move( op.onWrite ), op.written, ex.code() ) );
+					return true;
+				}
+				if( op.chain.size() ) return false;
+
+				ready.push_back( std::bind( std::move( op.onWrite ), op.written, std::error_code{} ) );
+				return true;
+			}
+
+			void
+			watch( const int fd, const bool known )
+			{
+				const auto &ops= waiting.at( fd );
+				::epoll_event event{};
+				event.data.fd= fd;
+				event.events= EPOLLONESHOT;
+				for( const auto &op: ops ) event.events|= op.isRead() ? EPOLLIN : EPOLLOUT;
+
+				if( ::epoll_ctl( epollFd, known ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &event ) == -1 )
+				{
+					throw std::system_error{ errno, std::generic_category(), "Unable to watch a file descriptor with `epoll`" };
+				}
+			}
+
+			// Retry every operation waiting on `fd`, in order, stopping at the first which still would block.
+			void
+			resume( const int fd )
+			{
+				auto &ops= waiting.at( fd );
+				while( not ops.empty() and attempt( ops.front() ) ) ops.pop_front();
+
+				if( not ops.empty() ) return watch( fd, true );
+
+				::epoll_ctl( epollFd, EPOLL_CTL_DEL, fd, nullptr );
+				waiting.erase( fd );
+			}
+
+		public:
+			explicit
+			EpollBlobIoEngine()
+				: epollFd( ::epoll_create1( EPOLL_CLOEXEC ) )
+			{
+				if( epollFd == -1 ) throw std::system_error{ errno, std::generic_category(), "`epoll_create1` failed" };
+			}
+
+			~EpollBlobIoEngine() override { ::close( epollFd ); }
+
+			void
+			read( const int fd, const std::size_t amount, ReadHandler handler ) override
+			{
+				Operation &op= queued.emplace_back();
+				op.fd= fd;
+				op.amount= amount;
+				op.onRead= std::move( handler );
+			}
+
+			void
+			write( const int fd, DataChain chain, WriteHandler handler ) override
+			{
+				Operation &op= queued.emplace_back();
+				op.fd= fd;
+				op.onWrite= std::move( handler );
+				op.chain= std::move( chain );
+			}
+
+			std::size_t
+			submit() override
+			{
+				std::size_t rv= 0;
+				for( ; not queued.empty(); queued.pop_front(), ++rv )
+				{
+					Operation &op= queued.front();
+					const int fd= op.fd;
+
+					// Operations on a descriptor which already has waiters must queue behind them, to keep order.
+					if( const auto found= waiting.find( fd ); found != end( waiting ) )
+					{
+						found->second.push_back( std::move( op ) );
+						watch( fd, true );
+						continue;
+					}
+					if( attempt( op ) ) continue;
+
+					waiting[ fd ].push_back( std::move( op ) );
+					watch( fd, false );
+				}
+				return rv;
+			}
+
+			std::size_t
+			complete( const bool wait ) override
+			{
+				if( ready.empty() and not waiting.empty() )
+				{
+					std::array< ::epoll_event, C::maxEpollEvents > events;
+					const int count= ::epoll_wait( epollFd, events.data(), events.size(), wait ? -1 : 0 );
+					if( count == -1 and errno != EINTR )
+					{
+						throw std::system_error{ errno, std::generic_category(), "`epoll_wait` failed" };
+					}
+					for( int i= 0; i < count; ++i ) resume( events[ i ].data.fd );
+				}
+
+				std::size_t rv= 0;
+				for( ; not ready.empty(); ++rv )
+				{
+					auto handler= std::move( ready.front() );
+					ready.pop_front();
+					handler();
+				}
+				return rv;
+			}
+
+			std::size_t
+			pending() const noexcept override
+			{
+				std::size_t rv= queued.size() + ready.size();
+				for( const auto &[ fd, ops ]: waiting ) rv+= ops.size();
+				return rv;
+			}
+	};
+
+	/*!
+	 * Construct the best `BlobIoEngine` which the running kernel supports.
+	 *
+	 * That is a `UringBlobIoEngine`, when io_uring is available (and permitted), and an `EpollBlobIoEngine`
+	 * otherwise.
+	 */
+	inline std::unique_ptr< BlobIoEngine >
+	exports::makeBlobIoEngine()
+	{
+		try
+		{
+			return std::make_unique< UringBlobIoEngine >();
+		}
+		catch( const std::system_error & )
+		{
+			return std::make_unique< EpollBlobIoEngine >();
+		}
+	}
+}
+
+namespace Alepha::Cavorite::inline exports::inline blob_io
+{
+	using namespace detail::blob_io::exports;
+}
@@ -0,0 +1,233 @@
+static_assert( __cplusplus > 2020'00 );
+
+#include <Alepha/BlobIo.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <Alepha/Testing/test.h>
+#include <Alepha/Utility/evaluation_helpers.h>
+
+namespace
+{
+	using Alepha::Blob;
+	using Alepha::DataChain;
+	using Alepha::BlobIoEngine;
+
+	std::string
+	textOf( const Blob &blob )
+	{
+		return { static_cast< const char * >( blob.data() ), blob.size() };
+	}
+
+	// Each engine which this kernel supports, with whether it wants non-blocking descriptors.
+	struct Engine
+	{
+		std::function< std::unique_ptr< BlobIoEngine > () > make;
+		bool nonblocking;
+	};
+
+	std::vector< Engine >
+	engines()
+	{
+		std::vector< Engine > rv;
+		try
+		{
+			std::ignore= Alepha::UringBlobIoEngine{};
+			rv.push_back( { []{ return std::make_unique< Alepha::UringBlobIoEngine >(); }, false } );
+		}
+		catch( const std::system_error & ) {}
+
+		rv.push_back( { []{ return std::make_unique< Alepha::EpollBlobIoEngine >(); }, true } );
+		return rv;
+	}
+
+	struct Pipe
+	{
+		int fds[ 2 ]= { -1, -1 };
+
+		explicit
+		Pipe( const bool nonblocking )
+		{
+			if( ::pipe2( fds, nonblocking ? O_NONBLOCK : 0 ) == -1 )
+			{
+				throw std::system_error{ errno, std::generic_category(), "`pipe2` failed" };
+			}
+		}
+
+		~Pipe() { ::close( fds[ 0 ] ); ::close( fds[ 1 ] ); }
+
+		int in() const noexcept { return fds[ 0 ]; }
+		int out() const noexcept { return fds[ 1 ]; }
+
+		void closeOut() noexcept { ::close( std::exchange( fds[ 1 ], -1 ) ); }
+	};
+
+	// Run the engine until nothing is pending.  (The rest of a short write goes out on the next `submit`.)
+	void
+	run( BlobIoEngine &engine )
+	{
+		while( engine.pending() )
+		{
+			engine.submit();
+			engine.complete( true );
+		}
+	}
+}
+
+static auto init= Alepha::Utility::enroll <=[]
+{
+	using namespace Alepha::Testing::exports::literals;
+	using Alepha::Testing::exports::TestState;
+
+	"A read delivers what is waiting, and end of file is an empty Blob with no error."_test <=[]( TestState test )
+	{
+		for( const auto &[ make, nonblocking ]: engines() )
+		{
+			Pipe pipe{ nonblocking };
+			const auto engine= make();
+
+			const std::string_view text= "hello";
+			test.demand( ::write( pipe.out(), text.data(), text.size() ) == ::ssize_t( text.size() ) );
+
+			std::vector< std::pair< std::string, std::error_code > > reads;
+			engine->read( pipe.in(), 100, [&]( Blob blob, std::error_code error ) { reads.emplace_back( textOf( blob ), error ); } );
+			run( *engine );
+
+			pipe.closeOut();
+			engine->read( pipe.in(), 100, [&]( Blob blob, std::error_code error ) { reads.emplace_back( textOf( blob ), error ); } );
+			run( *engine );
+
+			test.expect( reads.size() == 2 );
+			test.expect( reads.at( 0 ) == std::pair{ std::string{ text }, std::error_code{} } );
+			test.expect( reads.at( 1 ) == std::pair{ std::string{}, std::error_code{} } );
+		}
+	};
+
+	"A failed read reports its error."_test <=[]( TestState test )
+	{
+		for( const auto &[ make, nonblocking ]: engines() )
+		{
+			const Pipe pipe{ nonblocking };
+			const auto engine= make();
+
+			std::error_code error;
+			bool called= false;
+			engine->read( pipe.out(), 100, [&]( Blob blob, std::error_code e ) { called= blob.size() == 0; error= e; } );
+			run( *engine );
+
+			test.expect( called );
+			test.expect( error == std::errc::bad_file_descriptor );
+		}
+	};
+
+	"A chain larger than the pipe is written whole, across short writes."_test <=[]( TestState test )
+	{
+		for( const auto &[ make, nonblocking ]: engines() )
+		{
+			Pipe pipe{ nonblocking };
+			const auto engine= make();
+
+			// The reader blocks, whatever the writer's end is.
+			test.demand( ::fcntl( pipe.in(), F_SETFL, 0 ) == 0 );
+
+			std::string expected;
+			DataChain chain;
+			for( int i= 0; i < 64; ++i )
+			{
+				const std::string piece( 16 * 1024, char( 'a' + i % 26 ) );
+				expected+= piece;
+				chain.append( Alepha::Buffer< Alepha::Const >{ piece.data(), piece.size() } );
+			}
+
+			std::string received;
+			std::thread reader{ [&]
+			{
+				char buffer[ 4096 ];
+				for( ::ssize_t amount; ( amount= ::read( pipe.in(), buffer, sizeof( buffer ) ) ) > 0; ) received.append( buffer, amount );
+			} };
+
+			std::size_t written= 0;
+			std::error_code error;
+			engine->write( pipe.out(), std::move( chain ), [&]( std::size_t amount, std::error_code e ) { written= amount; error= e; } );
+			run( *engine );
+
+			pipe.closeOut();
+			reader.join();
+
+			test.expect( not error );
+			test.expect( written == expected.size() );
+			test.expect( received == expected );
+		}
+	};
+
+	"Writes to one descriptor arrive in the order they were queued, even when the first is cut short."_test <=[]( TestState test )
+	{
+		for( const auto &[ make, nonblocking ]: engines() )
+		{
+			// A non-blocking writer, into a pipe of one page, makes every large write a short one.
+			Pipe pipe{ true };
+			const auto engine= make();
+			test.demand( ::fcntl( pipe.in(), F_SETFL, 0 ) == 0 );
+			test.demand( ::fcntl( pipe.out(), F_SETPIPE_SZ, 4096 ) != -1 );
+
+			const std::string first( 64 * 1024, 'a' );
+			const std::string second( 64 * 1024, 'b' );
+
+			std::string received;
+			std::thread reader{ [&]
+			{
+				char buffer[ 4096 ];
+				for( ::ssize_t amount; ( amount= ::read( pipe.in(), buffer, sizeof( buffer ) ) ) > 0; ) received.append( buffer, amount );
+			} };
+
+			std::vector< std::size_t > written;
+			for( const auto &text: { first, second } )
+			{
+				DataChain chain;
+				chain.append( Alepha::Buffer< Alepha::Const >{ text.data(), text.size() } );
+				engine->write( pipe.out(), std::move( chain ), [&]( std::size_t amount, std::error_code ) { written.push_back( amount ); } );
+			}
+			run( *engine );
+
+			pipe.closeOut();
+			reader.join();
+
+			test.expect( written == std::vector< std::size_t >{ first.size(), second.size() } );
+			test.expect( received == first + second );
+		}
+	};
+
+	"Destroying an engine abandons its reads in flight, without calling them, and leaves the data unread."_test <=[]( TestState test )
+	{
+		for( const auto &[ make, nonblocking ]: engines() )
+		{
+			const Pipe pipe{ nonblocking };
+			bool called= false;
+			{
+				const auto engine= make();
+				engine->read( pipe.in(), 100, [&]( Blob, std::error_code ) { called= true; } );
+				engine->submit();
+				engine->complete( false );
+				test.expect( engine->pending() == 1 );
+			}
+
+			const std::string_view text= "later";
+			test.demand( ::write( pipe.out(), text.data(), text.size() ) == ::ssize_t( text.size() ) );
+
+			char buffer[ 16 ];
+			const ::ssize_t amount= ::read( pipe.in(), buffer, sizeof( buffer ) );
+			test.expect( not called );
+			test.expect( amount > 0 and std::string_view{ buffer, std::size_t( amount ) } == text );
+		}
+	};
+};
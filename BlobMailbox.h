@@ -0,0 +1,45 @@
+static_assert( __cplusplus > 2020'00 );
+
+#pragma once
+
+#include <Alepha/Alepha.h>
+
+#include <cstddef>
+
+#include <Alepha/Blob.h>
+#include <Alepha/DataChain.h>
+#include <Alepha/Mailbox.h>
+
+namespace Alepha::inline Cavorite  ::detail::  blob_mailbox
+{
+	inline namespace exports
+	{
+		// Hands `Blob` objects between threads, bounding the bytes in flight rather than the number of `Blob`s.
+		using BlobMailbox= MpscMailbox< Blob >;
+
+		template< Producers producers >
+		std::size_t drainInto( Mailbox< Blob, producers > &mailbox, DataChain &chain, std::size_t limit= -1 );
+	}
+
+	/*!
+	 * Pop every `Blob` which is available onto the end of a `DataChain`.
+	 *
+	 * Neighbouring carves of one arena are re-stitched as they are appended (see `DataChain::append`), so a
+	 * stream which was carved up to be handed across threads comes back together without copying.
+	 *
+	 * @return The number of `Blob` objects popped.
+	 *
+	 * @note Only the mailbox's single consumer thread may call this.
+	 */
+	template< Producers producers >
+	std::size_t
+	exports::drainInto( Mailbox< Blob, producers > &mailbox, DataChain &chain, const std::size_t limit )
+	{
+		return mailbox.drain( [&chain]( Blob &&blob ) { chain.append( blob ); }, limit );
+	}
+}
+
+namespace Alepha::Cavorite::inline exports::inline blob_mailbox
+{
+	using namespace detail::blob_mailbox::exports;
+}
@@ -0,0 +1,52 @@
+static_assert( __cplusplus > 2020'00 );
+
+#include <Alepha/BlobMailbox.h>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#include <Alepha/Testing/test.h>
+#include <Alepha/Utility/evaluation_helpers.h>
+
+static auto init= Alepha::Utility::enroll <=[]
+{
+	using namespace Alepha::Testing::exports::literals;
+	using Alepha::Testing::exports::TestState;
+
+	"A BlobMailbox weighs Blobs by their size."_test <=[]( TestState test )
+	{
+		Alepha::BlobMailbox mailbox{ 100 };
+		Alepha::Blob big{ 80 };
+		Alepha::Blob small{ 30 };
+
+		test.expect( mailbox.tryPush( big ) );
+		test.expect( mailbox.currentWeight() == 80 );
+		test.expect( not mailbox.tryPush( small ) );
+		test.expect( small.size() == 30 );
+	};
+
+	"Carves handed across threads are re-stitched as they are drained."_test <=[]( TestState test )
+	{
+		const std::string text( 1000, 'q' );
+		Alepha::Blob blob{ Alepha::make_buffer( text ) };
+		const void *const arena= blob.data();
+
+		Alepha::BlobMailbox mailbox{ 1000 };
+		std::thread producer{ [&]
+		{
+			while( blob.size() ) mailbox.push( blob.carveHead( std::min< std::size_t >( 100, blob.size() ) ) );
+			mailbox.close();
+		} };
+		producer.join();
+
+		Alepha::DataChain chain;
+		const std::size_t drained= Alepha::drainInto( mailbox, chain );
+
+		test.expect( drained == 10 );
+		test.expect( chain.size() == 1000 );
+		test.expect( chain.chain_length() == 1 );
+		test.expect( chain.chain_view().front().data() == arena );
+		test.expect( mailbox.currentWeight() == 0 );
+	};
+};
@@ -0,0 +1,273 @@
+static_assert( __cplusplus > 2020'00 );
+
+#pragma once
+
+#include <cstddef>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace Alepha::inline Cavorite  ::detail::  blob_pool
+{
+	inline namespace exports
+	{
+		class BlobPool;
+
+		BlobPool *threadBlobPool() noexcept;
+		void setThreadBlobPool( BlobPool *pool ) noexcept;
+	}
+
+	namespace C
+	{
+		// Size classes are powers of two, from `1 << minimumClassBits` to `1 << maximumClassBits`.  Requests
+		// larger than the largest class are not pooled -- at that size the general allocator's cost is dwarfed
+		// by the cost of touching the memory anyway.
+		const std::size_t minimumClassBits= 6;
+		const std::size_t maximumClassBits= 20;
+		const std::size_t classCount= maximumClassBits - minimumClassBits + 1;
+
+		// Each refill of a size class takes one slab of at least this size from the general allocator.
+		const std::size_t slabSize= std::size_t{ 1 } << 20;
+
+		const std::size_t arenaAlignment= alignof( std::max_align_t );
+	}
+
+	/*!
+	 * A size-classed slab pool for `Blob` arenas.
+	 *
+	 * `Blob` arenas are frequently short lived and frequently of a similar size (think of network read buffers
+	 * or per-record carve-outs that get combined).  Drawing each of them from the general allocator (and zeroing
+	 * each one) puts the allocator at the top of profiles.  A `BlobPool` keeps freed arenas on per-size-class
+	 * free lists, and refills those lists by splitting large slabs.
+	 *
+	 * A pool is owned by a single thread -- the thread which constructed it, or the thread which adopted it
+	 * through `BlobPool::local()`.  Only the owning thread draws arenas from the pool; `tryAllocate` on any
+	 * other thread declines (returns `nullptr`) so that the caller falls back to the general allocator.  Any
+	 * thread may return an arena to a pool.  Returns from foreign threads go onto a lock-free list which the
+	 * owner reclaims when its own list for that size class runs dry.  This keeps the owner's hot path free of
+	 * atomics, while still permitting `Blob` objects to be handed between threads.
+	 *
+	 * @note A pool must outlive every arena drawn from it.  The per-thread pools from `BlobPool::local()` are
+	 * never destroyed.  When their thread exits, they are parked and later adopted by a new thread.
+	 */
+	class exports::BlobPool
+		: boost::noncopyable
+	{
+		private:
+			struct FreeBlock
+			{
+				FreeBlock *next;
+			};
+
+			struct SizeClass
+			{
+				FreeBlock *local= nullptr; // Only touched by the owning thread.
+				std::atomic< FreeBlock * > remote= nullptr; // Pushed to by any thread, drained by the owner.
+			};
+
+			struct AlignedDelete
+			{
+				void
+				operator() ( std::byte *const p ) const noexcept
+				{
+					::operator delete[]( p, std::align_val_t{ C::arenaAlignment } );
+				}
+			};
+
+			std::array< SizeClass, C::classCount > classes;
+			std::vector< std::unique_ptr< std::byte[], AlignedDelete > > slabs;
+			std::atomic< std::thread::id > owner;
+
+			static constexpr std::size_t
+			classIndex( const std::size_t amount ) noexcept
+			{
+				const std::size_t bits= std::bit_width( std::max( amount, std::size_t{ 1 } ) - 1 );
+				return bits <= C::minimumClassBits ? 0 : bits - C::minimumClassBits;
+			}
+
+			static constexpr std::size_t
+			classSize( const std::size_t index ) noexcept
+			{
+				return std::size_t{ 1 } << ( index + C::minimumClassBits );
+			}
+
+			void
+			refill( const std::size_t index )
+			{
+				auto &sizeClass= classes.at( index );
+
+				// Blocks returned by other threads are the cheapest source of refill.
+				if( FreeBlock *const reclaimed= sizeClass.remote.exchange( nullptr, std::memory_order_acquire ) )
+				{
+					sizeClass.local= reclaimed;
+					return;
+				}
+
+				const std::size_t blockSize= classSize( index );
+				const std::size_t amount= std::max( C::slabSize, blockSize );
+				auto &slab= slabs.emplace_back( new ( std::align_val_t{ C::arenaAlignment } ) std::byte[ amount ] );
+
+				for( std::size_t offset= amount; offset >= blockSize; offset-= blockSize )
+				{
+					auto *const block= new ( slab.get() + offset - blockSize ) FreeBlock{ sizeClass.local };
+					sizeClass.local= block;
+				}
+			}
+
+			void
+			pushRemote( SizeClass &sizeClass, FreeBlock *const block ) noexcept
+			{
+				block->next= sizeClass.remote.load( std::memory_order_relaxed );
+				while( not sizeClass.remote.compare_exchange_weak( block->next, block,
+						std::memory_order_release, std::memory_order_relaxed ) );
+			}
+
+			struct Lease;
+
+		public:
+			/*!
+			 * Construct an empty pool, owned by the calling thread.
+			 */
+			BlobPool() : owner( std::this_thread::get_id() ) {}
+
+			/*!
+			 * Report whether arenas of the specified size are served by this pool at all.
+			 */
+			static constexpr bool
+			pools( const std::size_t amount ) noexcept
+			{
+				return amount != 0 and amount <= classSize( C::classCount - 1 );
+			}
+
+			/*!
+			 * Draw an arena of at least `amount` bytes from this pool.
+			 *
+			 * @return A pointer to uninitialized storage, or `nullptr` if this pool will not serve the request
+			 * (because the request is too large to be pooled, or because the calling thread is not the owner).
+			 * When `nullptr` is returned, the caller should use the general allocator instead.
+			 */
+			[[nodiscard]] std::byte *
+			tryAllocate( const std::size_t amount )
+			{
+				if( not pools( amount ) ) return nullptr;
+				if( owner.load( std::memory_order_relaxed ) != std::this_thread::get_id() ) return nullptr;
+
+				const auto index= classIndex( amount );
+				auto &sizeClass= classes[ index ];
+				if( not sizeClass.local ) refill( index );
+
+				FreeBlock *const block= sizeClass.local;
+				sizeClass.local= block->next;
+				block->~FreeBlock();
+				return reinterpret_cast< std::byte * >( block );
+			}
+
+			/*!
+			 * Return an arena previously drawn from this pool by `tryAllocate`.
+			 *
+			 * @param arena The arena to return.
+			 * @param amount The size which was requested when this arena was drawn.
+			 *
+			 * @note This may be called from any thread.
+			 */
+			void
+			deallocate( std::byte *const arena, const std::size_t amount ) noexcept
+			{
+				auto &sizeClass= classes[ classIndex( amount ) ];
+				auto *const block= new ( arena ) FreeBlock{ nullptr };
+
+				if( owner.load( std::memory_order_relaxed ) == std::this_thread::get_id() )
+				{
+					block->next= sizeClass.local;
+					sizeClass.local= block;
+				}
+				else pushRemote( sizeClass, block );
+			}
+
+			/*!
+			 * Returns the pool owned by the calling thread, creating or adopting one if necessary.
+			 */
+			static BlobPool &local();
+	};
+
+	struct BlobPool::Lease
+	{
+		static inline std::mutex access;
+		static inline std::vector< BlobPool * > parked;
+
+		BlobPool *pool= nullptr;
+
+		Lease()
+		{
+			{
+				std::lock_guard lock{ access };
+				if( not parked.empty() )
+				{
+					pool= parked.back();
+					parked.pop_back();
+				}
+			}
+
+			if( pool ) pool->owner.store( std::this_thread::get_id(), std::memory_order_relaxed );
+			else pool= new BlobPool;
+		}
+
+		~Lease()
+		{
+			// Arenas from this pool may still be alive in other threads, so it is parked rather than destroyed.
+			pool->owner.store( std::thread::id{}, std::memory_order_relaxed );
+			std::lock_guard lock{ access };
+			parked.push_back( pool );
+		}
+	};
+
+	inline BlobPool &
+	BlobPool::local()
+	{
+		thread_local Lease lease;
+		return *lease.pool;
+	}
+
+	namespace storage
+	{
+		inline thread_local BlobPool *threadPool= nullptr;
+	}
+
+	/*!
+	 * Returns the pool which newly allocated `Blob` arenas on this thread are drawn from.
+	 *
+	 * A `nullptr` result means that the general allocator is used.
+	 */
+	inline BlobPool *
+	exports::threadBlobPool() noexcept
+	{
+		return storage::threadPool;
+	}
+
+	/*!
+	 * Select the pool which newly allocated `Blob` arenas on this thread will be drawn from.
+	 *
+	 * Passing `&BlobPool::local()` opts the calling thread into pooled arenas.  Passing `nullptr` restores use of
+	 * the general allocator.  Individual `Blob` objects can still be constructed on a specific pool, regardless
+	 * of this setting.
+	 */
+	inline void
+	exports::setThreadBlobPool( BlobPool *const pool ) noexcept
+	{
+		storage::threadPool= pool;
+	}
+}
+
+namespace Alepha::Cavorite::inline exports::inline blob_pool
+{
+	using namespace detail::blob_pool::exports;
+}
@@ -0,0 +1,108 @@
+static_assert( __cplusplus > 2020'00 );
+
+#include <Alepha/BlobPool.h>
+
+#include <algorithm>
+#include <thread>
+
+#include <Alepha/Blob.h>
+
+#include <Alepha/Testing/test.h>
+#include <Alepha/Utility/evaluation_helpers.h>
+
+static auto init= Alepha::Utility::enroll <=[]
+{
+	using namespace Alepha::Testing::exports::literals;
+	using Alepha::Testing::exports::TestState;
+
+	using Alepha::BlobPool;
+
+	"Only sizes within the size classes are pooled."_test <=[]( TestState test )
+	{
+		test.expect( not BlobPool::pools( 0 ) );
+		test.expect( BlobPool::pools( 1 ) );
+		test.expect( BlobPool::pools( 1 << 20 ) );
+		test.expect( not BlobPool::pools( ( 1 << 20 ) + 1 ) );
+
+		BlobPool pool;
+		test.expect( pool.tryAllocate( ( 1 << 20 ) + 1 ) == nullptr );
+	};
+
+	"A returned arena is the next one drawn from its size class."_test <=[]( TestState test )
+	{
+		BlobPool pool;
+		std::byte *const first= pool.tryAllocate( 100 );
+		test.expect( first != nullptr );
+
+		std::byte *const second= pool.tryAllocate( 100 );
+		test.expect( second != nullptr and second != first );
+
+		pool.deallocate( first, 100 );
+		test.expect( pool.tryAllocate( 128 ) == first );
+
+		pool.deallocate( first, 128 );
+		pool.deallocate( second, 100 );
+	};
+
+	"Only the owning thread draws from a pool, but any thread may return to it."_test <=[]( TestState test )
+	{
+		// The largest class fills one block per slab, so the owner's list runs dry after every allocation.
+		const std::size_t largest= 1 << 20;
+
+		BlobPool pool;
+		std::byte *const arena= pool.tryAllocate( largest );
+		test.expect( arena != nullptr );
+
+		std::byte *foreign= arena;
+		std::thread{ [&]
+		{
+			foreign= pool.tryAllocate( largest );
+			pool.deallocate( arena, largest );
+		} }.join();
+		test.expect( foreign == nullptr );
+
+		// The returned arena is reclaimed from the remote list, rather than a new slab being taken.
+		test.expect( pool.tryAllocate( largest ) == arena );
+		pool.deallocate( arena, largest );
+	};
+
+	"Blob arenas are recycled through a pool."_test <=[]( TestState test )
+	{
+		BlobPool pool;
+		const void *arena= nullptr;
+		{
+			Alepha::Blob blob{ 200, pool };
+			test.expect( blob.size() == 200 );
+			arena= blob.data();
+			std::ranges::fill( blob, std::byte{ 0xA5 } );
+		}
+
+		Alepha::Blob recycled{ 150, pool };
+		test.expect( recycled.data() == arena );
+
+		// Even a recycled arena is zeroed, unless `uninitialized` is asked for.
+		test.expect( std::ranges::all_of( recycled, []( const std::byte b ) { return b == std::byte{}; } ) );
+	};
+
+	"Each thread has its own pool, which it opts into."_test <=[]( TestState test )
+	{
+		test.expect( Alepha::threadBlobPool() == nullptr );
+
+		BlobPool &local= BlobPool::local();
+		test.expect( &BlobPool::local() == &local );
+
+		BlobPool *other= nullptr;
+		std::thread{ [&]{ other= &BlobPool::local(); } }.join();
+		test.expect( other != &local );
+
+		Alepha::setThreadBlobPool( &local );
+		const void *arena= nullptr;
+		{
+			Alepha::Blob blob{ 64 };
+			arena= blob.data();
+		}
+		Alepha::Blob pooled{ 64, Alepha::uninitialized };
+		test.expect( pooled.data() == arena );
+		Alepha::setThreadBlobPool( nullptr );
+	};
+};
@@ -2,9 +2,16 @@ static_assert( __cplusplus > 2020'00 );
 
 #pragma once
 
+#include <Alepha/Alepha.h>
+
 #include <vector>
 #include <string>
 #include <array>
+#include <algorithm>
+#include <span>
+#include <utility>
+#include <cstdint>
+#include <cstring>
 #include <typeinfo>
 #include <typeindex>
 #include <exception>
@@ -12,10 +19,16 @@ static_assert( __cplusplus > 2020'00 );
 
 #include <boost/lexical_cast.hpp>
 
-#include "Concepts.h"
-#include "assertion.h"
-#include "Capabilities.h"
-#include "lifetime.h"
+#include <Alepha/Concepts.h>
+#include <Alepha/Constness.h>
+#include <Alepha/assertion.h>
+#include <Alepha/lifetime.h>
+
+#include <Alepha/IOStreams/String.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 
 namespace Alepha::inline Cavorite  ::detail::  buffer
@@ -24,6 +37,16 @@ namespace Alepha::inline Cavorite  ::detail::  buffer
 
 	using namespace std::literals::string_literals;
 
+	using IOStreams::stringify;
+
+	namespace C
+	{
+		// Transfers at least this large are done with non-temporal (streaming) stores, which bypass the cache.
+		// This is roughly the size of an L2 cache -- a copy this large would evict most of the working set
+		// anyway, and the destination of such a bulk copy is rarely read again soon.
+		const std::size_t streamingThreshold= std::size_t{ 1 } << 20;
+	}
+
 	namespace exports
 	{
 		class OutOfRangeError
@@ -42,7 +65,7 @@ namespace Alepha::inline Cavorite  ::detail::  buffer
 					: baseAddress( address ), requestedSize( requestedSize ), availableSize( availableSize )
 				{}
 
-			public
+			public:
 				const void *getAddress() const noexcept { return baseAddress; }
 				const std::size_t getRequestedSize() const noexcept { return requestedSize; }
 				const std::size_t getAvailableSize() const noexcept { return availableSize; }
@@ -62,20 +85,20 @@ namespace Alepha::inline Cavorite  ::detail::  buffer
 					: std::out_of_range( "Tried to access an object of type "s + type.name() + " which is " + stringify( requestedSize ) + " bytes in size.  "
 							+ "The request was at location " + stringify( location ) + " which only has " + stringify( availableSize )
 							+ " bytes allocated" ),
-					OutOfRangeError( location, requestedSIze, availableSize ),
+					OutOfRangeError( location, requestedSize, availableSize ),
 					typeID( type )
 				{}
 		};
 
 		class OutOfRangeSizeError
-			: virtual public OutOfRangeException
+			: virtual public OutOfRangeError
 		{
 			public:
 				explicit
-				OutOfRangeSizeException( const void *const location, const std::ptrdiff_t requestedOffset, const std::size_t availableSpace )
+				OutOfRangeSizeError( const void *const location, const std::ptrdiff_t requestedOffset, const std::size_t availableSpace )
 					: std::out_of_range( "Tried to view a byte offset of " + stringify( requestedOffset ) + " into location " + stringify( location )
 							+ " which is " + stringify( availableSpace ) + " bytes in size." ),
-					OutOfRangeException( location, requestedOffset, availableSpace )
+					OutOfRangeError( location, requestedOffset, availableSpace )
 				{}
 		};
 
@@ -84,6 +107,9 @@ namespace Alepha::inline Cavorite  ::detail::  buffer
 
 		constexpr Buffer< Mutable > copyData( Buffer< Mutable > destination, Buffer< Const > source );
 
+		using CopyRequest= std::pair< Buffer< Mutable >, Buffer< Const > >;
+		void copyData( std::span< const CopyRequest > requests );
+
 		constexpr void zeroData( Buffer< Mutable > buffer ) noexcept;
 	}
 
@@ -106,26 +132,28 @@ namespace Alepha::inline Cavorite  ::detail::  buffer
 
 			constexpr
 			Buffer( const pointer_type ptr, const std::size_t bytes ) noexcept
-				: ptr( static_cast< byte_pointer_type >( ptr ), bytes( bytes )
+				: ptr( static_cast< byte_pointer_type >( ptr ) ), bytes( bytes )
 			{}
 
-			constexpr
-			Buffer( const Buffer< Mutable > &copy ) noexcept
-				: ptr( copy.byte_data() ), bytes( copy.size() ) {}
+			constexpr Buffer( const Buffer & ) noexcept= default;
+			constexpr Buffer &operator= ( const Buffer & ) noexcept= default;
 
+			// A mutable view converts to a const one, but not the other way around.
 			constexpr
-			Buffer( const Buffer< Const > &copy ) noexcept requires( Constness == Mutable )= delete;
+			Buffer( const Buffer< Mutable > &copy ) noexcept requires( constness == Const )
+				: ptr( copy.byte_data() ), bytes( copy.size() ) {}
 
 
+			// A `Buffer` is a view, like a pointer, so its constness is that of the data, not of the view.
 			constexpr byte_pointer_type byte_data() const noexcept { return ptr; }
 			constexpr pointer_type data() const noexcept { return ptr; }
 
-			constexpr const_byte_pointer_type byte_data() const noexcept { return ptr; }
-			constexpr const_pointer_type data() const noexcept { return ptr; }
-
 			constexpr std::size_t size() const noexcept { return bytes; }
 			constexpr bool empty() const noexcept { return size() == 0; }
 
+			constexpr byte_pointer_type begin() const noexcept { return ptr; }
+			constexpr byte_pointer_type end() const noexcept { return ptr + bytes; }
+
 			constexpr const_byte_pointer_type cbegin() const noexcept { return begin(); }
 			constexpr const_byte_pointer_type cend() const noexcept { return end(); }
 
@@ -137,7 +165,7 @@ namespace Alepha::inline Cavorite  ::detail::  buffer
 			as( std::nothrow_t ) const noexcept
 			{
 				assertion( sizeof( T ) <= bytes );
-				return *start_lifetime_as< std::add_lvalue_reference_t< maybe_const_t< T, constness > > >( ptr );
+				return *start_lifetime_as< maybe_const_t< T, constness > >( ptr );
 			}
 
 			template< typename T >
@@ -145,11 +173,11 @@ namespace Alepha::inline Cavorite  ::detail::  buffer
 			as() const
 			{
 				if( sizeof( T ) > bytes ) throw InsufficientSizeError{ ptr, sizeof( T ), bytes, typeid( T ) };
-				return this->as< std::add_lvalue_reference_t< maybe_const_t< T, constness > > >( std::nothrow );
+				return this->as< T >( std::nothrow );
 			}
 
 			template< typename T >
-			constexpr std::add_lvalue_reference_t< std::add_const_t< T & > >
+			constexpr std::add_lvalue_reference_t< std::add_const_t< T > >
 			const_as( std::nothrow_t ) const noexcept
 			{
 				assertion( sizeof( T ) <= bytes );
@@ -222,7 +250,7 @@ namespace Alepha::inline Cavorite  ::detail::  buffer
 	struct BufferModel_capability {};
 
 	template< typename T >
-	concept UndecayedBufferModelable= HasCapability< T, BufferModel_capability >;
+	concept UndecayedBufferModelable= HasBase< T, BufferModel_capability >;
 
 	template< typename T >
 	concept BufferModelable= UndecayedBufferModelable< std::decay_t< T > >;
@@ -234,8 +262,8 @@ namespace Alepha::inline Cavorite  ::detail::  buffer
 			constexpr auto &crtp() noexcept { return static_cast< Derived & >( *this ); }
 			constexpr const auto &crtp() const noexcept { return static_cast< const Derived & >( *this ); }
 
-			constexpr auto &buffer() { return static_cast< Buffer< Mutable > >( crtp() ); }
-			constexpr const auto &buffer() const { return static_cast< Buffer< Const > >( crtp() ); }
+			constexpr Buffer< Mutable > buffer() { return static_cast< Buffer< Mutable > >( crtp() ); }
+			constexpr Buffer< Const > buffer() const { return static_cast< Buffer< Const > >( crtp() ); }
 
 		public:
 			constexpr auto byte_data() { return buffer().byte_data(); }
@@ -270,11 +298,9 @@ namespace Alepha::inline Cavorite  ::detail::  buffer
 			template< typename T > constexpr decltype( auto ) const_as() { return buffer().template const_as< T >(); }
 	};
 
+	// The access level of a `BufferModel` derivative follows its own constness.
 	template< typename T >
-	extern Constness constness_of_v;
-
-	template< UndecayedBufferModelble T >
-	constexpr Constness constness_of_v= std::is_const_v< T >;
+	constexpr Constness constness_of_v= std::is_const_v< T > ? Const : Mutable;
 
 	template< Constness constness >
 	constexpr Constness constness_of_v< Buffer< constness > >{ constness };
@@ -283,7 +309,7 @@ namespace Alepha::inline Cavorite  ::detail::  buffer
 	constexpr auto
 	operator + ( const Buffer< constness > buffer, const std::size_t offset )
 	{
-		if( offset > buffer.size() ) throw OutOfRangeError{ buffer.data(), offset, buffer.size() };
+		if( offset > buffer.size() ) throw OutOfRangeSizeError{ buffer.data(), std::ptrdiff_t( offset ), buffer.size() };
 		return Buffer< constness >{ buffer.byte_data() + offset, buffer.size() - offset };
 	}
 
@@ -310,18 +336,18 @@ namespace Alepha::inline Cavorite  ::detail::  buffer
 	}
 
 	constexpr Buffer< Mutable >
-	make_buffer( Concepts::StandardLayoutAggregate auto &aggregate ) noexcept
+	make_buffer( StandardLayoutAggregate auto &aggregate ) noexcept
 	{
 		return { &aggregate, sizeof( aggregate ) };
 	}
 
 	constexpr Buffer< Const >
-	make_buffer( const Concepts::StandardLayoutAggregate auto &aggregate ) noexcept
+	make_buffer( const StandardLayoutAggregate auto &aggregate ) noexcept
 	{
 		return { &aggregate, sizeof( aggregate ) };
 	}
 
-	template< Concepts::StandardLayout T >
+	template< StandardLayout T >
 	constexpr Buffer< Mutable >
 	make_buffer( std::vector< T > &vector ) noexcept
 	{
@@ -329,7 +355,7 @@ namespace Alepha::inline Cavorite  ::detail::  buffer
 		return { vector.data(), vector.size() * sizeof( T ) };
 	}
 
-	template< Concepts::StandardLayout T >
+	template< StandardLayout T >
 	constexpr Buffer< Const >
 	make_buffer( const std::vector< T > &vector ) noexcept
 	{
@@ -338,7 +364,7 @@ namespace Alepha::inline Cavorite  ::detail::  buffer
 	}
 
 
-	template< Concepts::StandardLayout T, std::size_t size >
+	template< StandardLayout T, std::size_t size >
 	constexpr Buffer< Mutable >
 	make_buffer( std::array< T, size > &array ) noexcept
 	{
@@ -346,7 +372,7 @@ namespace Alepha::inline Cavorite  ::detail::  buffer
 		return { array.data(), sizeof( array ) };
 	}
 
-	template< Concepts::StandardLayout T, std::size_t size >
+	template< StandardLayout T, std::size_t size >
 	constexpr Buffer< Const >
 	make_buffer( const std::array< T, size > &array ) noexcept
 	{
@@ -355,34 +381,17 @@ namespace Alepha::inline Cavorite  ::detail::  buffer
 	}
 
 
-	template< Concepts::StandardLayout T, std::size_t size >
+	template< StandardLayout T, std::size_t size >
 	constexpr Buffer< Mutable >
-	make_buffer( T array[ size ] ) noexcept
+	make_buffer( T ( &array )[ size ] ) noexcept
 	{
 		// TODO: Do we need to consider overflow here?
 		return { array, sizeof( array ) };
 	}
 
-	template< Concepts::StandardLayout T, std::size_t size >
+	template< StandardLayout T, std::size_t size >
 	constexpr Buffer< Const >
-	make_buffer( const T array[ size ] ) noexcept
-	{
-		// TODO: Do we need to consider overflow here?
-		return { array, sizeof( array ) };
-	}
-
-
-	template< Concepts::StandardLayout T, std::size_t size >
-	constexpr Buffer< Mutable >
-	make_buffer( T array[ size ] ) noexcept
-	{
-		// TODO: Do we need to consider overflow here?
-		return { array, sizeof( array ) };
-	}
-
-	template< Concepts::StandardLayout T, std::size_t size >
-	constexpr Buffer< Const >
-	make_buffer( const T array[ size ] ) noexcept
+	make_buffer( const T ( &array )[ size ] ) noexcept
 	{
 		// TODO: Do we need to consider overflow here?
 		return { array, sizeof( array ) };
@@ -402,19 +411,109 @@ namespace Alepha::inline Cavorite  ::detail::  buffer
 	}
 
 
+	// Copy with non-temporal stores, for transfers too large to be worth caching.
+	inline void
+	streamingCopy( std::byte *destination, const std::byte *source, std::size_t amount ) noexcept
+	{
+	#ifdef __SSE2__
+		// The streaming stores need an aligned destination, so the unaligned head is copied normally.
+		const std::size_t head= std::min( amount, -reinterpret_cast< std::uintptr_t >( destination ) % sizeof( __m128i ) );
+		::memcpy( destination, source, head );
+		destination+= head;
+		source+= head;
+		amount-= head;
+
+		for( ; amount >= 4 * sizeof( __m128i ); amount-= 4 * sizeof( __m128i ) )
+		{
+			const auto *const from= reinterpret_cast< const __m128i * >( source );
+			auto *const to= reinterpret_cast< __m128i * >( destination );
+			const __m128i a= _mm_loadu_si128( from + 0 );
+			const __m128i b= _mm_loadu_si128( from + 1 );
+			const __m128i c= _mm_loadu_si128( from + 2 );
+			const __m128i d= _mm_loadu_si128( from + 3 );
+			_mm_stream_si128( to + 0, a );
+			_mm_stream_si128( to + 1, b );
+			_mm_stream_si128( to + 2, c );
+			_mm_stream_si128( to + 3, d );
+			destination+= 4 * sizeof( __m128i );
+			source+= 4 * sizeof( __m128i );
+		}
+		_mm_sfence();
+	#endif
+		::memcpy( destination, source, amount );
+	}
+
+	// Zero with non-temporal stores, for regions too large to be worth caching.
+	inline void
+	streamingZero( std::byte *destination, std::size_t amount ) noexcept
+	{
+	#ifdef __SSE2__
+		const std::size_t head= std::min( amount, -reinterpret_cast< std::uintptr_t >( destination ) % sizeof( __m128i ) );
+		::memset( destination, 0, head );
+		destination+= head;
+		amount-= head;
+
+		const __m128i zero= _mm_setzero_si128();
+		for( ; amount >= sizeof( __m128i ); amount-= sizeof( __m128i ) )
+		{
+			_mm_stream_si128( reinterpret_cast< __m128i * >( destination ), zero );
+			destination+= sizeof( __m128i );
+		}
+		_mm_sfence();
+	#endif
+		::memset( destination, 0, amount );
+	}
+
+	/*!
+	 * Copy the contents of one buffer into another.
+	 *
+	 * Transfers of at least `C::streamingThreshold` bytes use non-temporal stores, so that bulk copies do not
+	 * evict the rest of the working set from the cache.
+	 *
+	 * @return The part of `destination` which was written.
+	 */
 	constexpr Buffer< Mutable >
 	exports::copyData( const Buffer< Mutable > destination, const Buffer< Const > source )
 	{
 		if( source.size() > destination.size() ) throw InsufficientSizeError{ destination.data(), source.size(), destination.size(), typeid( std::byte ) };
 
-		::memcpy( destination, source, source.size() );
+		if( source.size() >= C::streamingThreshold ) streamingCopy( destination.byte_data(), source.byte_data(), source.size() );
+		else ::memcpy( destination, source, source.size() );
 		return { destination, source.size() };
 	}
 
+	/*!
+	 * Perform a batch of copies.
+	 *
+	 * Every request is checked before any data are copied, so a batch either fails without side effects, or
+	 * completes.  While each copy runs, the source of the next is prefetched.  This suits the assembly of a
+	 * message from many small pieces.
+	 *
+	 * @param requests The copies to perform, as (destination, source) pairs.
+	 */
+	inline void
+	exports::copyData( const std::span< const CopyRequest > requests )
+	{
+		for( const auto &[ destination, source ]: requests )
+		{
+			if( source.size() > destination.size() ) throw InsufficientSizeError{ destination.data(), source.size(), destination.size(), typeid( std::byte ) };
+		}
+
+		for( std::size_t i= 0; i < requests.size(); ++i )
+		{
+			if( i + 1 < requests.size() ) __builtin_prefetch( requests[ i + 1 ].second.data() );
+
+			const auto &[ destination, source ]= requests[ i ];
+			if( source.size() >= C::streamingThreshold ) streamingCopy( destination.byte_data(), source.byte_data(), source.size() );
+			else ::memcpy( destination, source, source.size() );
+		}
+	}
+
 	constexpr void
 	exports::zeroData( const Buffer< Mutable > buffer ) noexcept
 	{
-		::memset( buffer, 0, buffer.size() );
+		if( buffer.size() >= C::streamingThreshold ) streamingZero( buffer.byte_data(), buffer.size() );
+		else ::memset( buffer, 0, buffer.size() );
 	}
 
 	namespace exports
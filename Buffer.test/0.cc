@@ -0,0 +1,138 @@
+static_assert( __cplusplus > 2020'00 );
+
+#include <Alepha/Buffer.h>
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include <Alepha/Testing/test.h>
+#include <Alepha/Utility/evaluation_helpers.h>
+
+namespace
+{
+	using Alepha::Buffer;
+	using Alepha::Const;
+	using Alepha::Mutable;
+
+	// A pattern which does not repeat at any power of two, so misplaced bytes are caught.
+	std::vector< std::byte >
+	pattern( const std::size_t size )
+	{
+		std::vector< std::byte > rv( size );
+		for( std::size_t i= 0; i < size; ++i ) rv[ i ]= std::byte( i % 251 );
+		return rv;
+	}
+}
+
+static auto init= Alepha::Utility::enroll <=[]
+{
+	using namespace Alepha::Testing::exports::literals;
+	using Alepha::Testing::exports::TestState;
+
+	"A small copy fills the front of its destination."_test <=[]( TestState test )
+	{
+		std::string destination( 8, '.' );
+		const std::string source= "abc";
+		const Buffer< Mutable > written= Alepha::copyData( Alepha::make_buffer( destination ), Alepha::make_buffer( source ) );
+
+		test.expect( written.size() == 3 );
+		test.expect( written.data() == destination.data() );
+		test.expect( destination == "abc....." );
+	};
+
+	"A bulk copy streams, whatever the alignment of its destination."_test <=[]( TestState test )
+	{
+		// Past the streaming threshold, and odd, to leave both an unaligned head and a short tail.
+		const std::size_t size= ( std::size_t{ 1 } << 21 ) + 7;
+		const auto source= pattern( size );
+		std::vector< std::byte > destination( size + 1 );
+
+		Alepha::copyData( Buffer< Mutable >{ destination.data() + 1, size }, Alepha::make_buffer( source ) );
+		test.expect( destination[ 0 ] == std::byte{} );
+		test.expect( std::equal( source.begin(), source.end(), destination.begin() + 1 ) );
+	};
+
+	"A copy into too small a destination throws, and copies nothing."_test <=[]( TestState test )
+	{
+		std::string destination( 2, '.' );
+		const std::string source= "abc";
+		bool threw= false;
+		try
+		{
+			std::ignore= Alepha::copyData( Alepha::make_buffer( destination ), Alepha::make_buffer( source ) );
+		}
+		catch( const Alepha::InsufficientSizeError &ex )
+		{
+			threw= ex.getRequestedSize() == 3 and ex.getAvailableSize() == 2;
+		}
+		test.expect( threw );
+		test.expect( destination == ".." );
+	};
+
+	"A batch of copies is checked as a whole before any is made."_test <=[]( TestState test )
+	{
+		std::string message( 11, '.' );
+		const std::string hello= "hello";
+		const std::string world= "world";
+
+		const std::array< Alepha::CopyRequest, 2 > good
+		{ {
+			{ Alepha::make_buffer( message ), Alepha::make_buffer( hello ) },
+			{ Alepha::make_buffer( message ) + 6, Alepha::make_buffer( world ) },
+		} };
+		Alepha::copyData( good );
+		test.expect( message == "hello.world" );
+
+		std::string untouched( 8, '.' );
+		const std::array< Alepha::CopyRequest, 2 > bad
+		{ {
+			{ Alepha::make_buffer( untouched ), Alepha::make_buffer( hello ) },
+			{ Alepha::make_buffer( untouched ) + 6, Alepha::make_buffer( world ) },
+		} };
+		bool threw= false;
+		try
+		{
+			Alepha::copyData( bad );
+		}
+		catch( const Alepha::InsufficientSizeError & )
+		{
+			threw= true;
+		}
+		test.expect( threw );
+		test.expect( untouched == std::string( 8, '.' ) );
+	};
+
+	"Zeroing clears exactly its buffer, small or bulk."_test <=[]( TestState test )
+	{
+		for( const std::size_t size: { std::size_t{ 5 }, ( std::size_t{ 1 } << 21 ) + 3 } )
+		{
+			std::vector< std::byte > data( size + 2, std::byte{ 0xFF } );
+			Alepha::zeroData( Buffer< Mutable >{ data.data() + 1, size } );
+
+			test.expect( data.front() == std::byte{ 0xFF } and data.back() == std::byte{ 0xFF } );
+			test.expect( std::all_of( data.begin() + 1, data.end() - 1, []( const std::byte b ) { return b == std::byte{}; } ) );
+		}
+	};
+
+	"Offsets past the end of a buffer throw."_test <=[]( TestState test )
+	{
+		const std::string text= "abc";
+		Buffer< Const > buffer= Alepha::make_buffer( text );
+		test.expect( ( buffer + 3 ).empty() );
+
+		bool threw= false;
+		try
+		{
+			buffer+= 4;
+		}
+		catch( const Alepha::OutOfRangeSizeError & )
+		{
+			threw= true;
+		}
+		test.expect( threw );
+		test.expect( buffer.size() == 3 );
+	};
+};
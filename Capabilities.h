@@ -100,6 +100,14 @@ namespace Alepha::Hydrogen
 			return has_cap( Meta::Container::vector< TParams... >{}, cap );
 		}
 
+		// A type which is not a template instance has no capability list to search.
+		template< typename Cap, typename T >
+		consteval bool
+		has_cap( const Meta::type_value< T > &, Meta::type_value< Cap > )
+		{
+			return false;
+		}
+
 		namespace exports
 		{
 			template< typename T, typename cap >
@@ -2,16 +2,29 @@ static_assert( __cplusplus > 2020'00 );
 
 #include "Console.h"
 
+#include <poll.h>
+#include <signal.h>
 #include <termios.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
 
+#include <cerrno>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <deque>
+#include <limits>
+#include <optional>
 #include <stack>
 #include <vector>
 #include <utility>
 #include <string>
 #include <sstream>
 #include <iostream>
+#include <system_error>
 
 #include <ext/stdio_filebuf.h>
 
@@ -22,6 +35,7 @@ static_assert( __cplusplus > 2020'00 );
 #include "StaticValue.h"
 #include "string_algorithms.h"
 #include "AutoRAII.h"
+#include "display_width.h"
 
 /*  
  * All of the terminal control code in this library uses ANSI escape sequences (https://en.wikipedia.org/wiki/ANSI_escape_code).
@@ -53,8 +67,14 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 
 			const int defaultScreenWidthLimit= 100;
 
-			// The Device Status Report should never be longer than this.
-			const int maxLengthOfDSR= 64;
+			// How long the terminal has to answer a cursor position query, before the answer is no longer expected.
+			const std::chrono::milliseconds positionReportTimeout{ 250 };
+
+			// How long to wait for the rest of a sequence, after an ESC, before taking it as the escape key.  The
+			// bytes of a sequence are sent together, so this need only cover a slow connection.
+			const int escapeTimeoutMs= 25;
+
+			const std::size_t inputBufferSize= 4096;
 		}
 
 		// TODO, this should be in its own lib.
@@ -67,12 +87,17 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 				if( applicationName().empty() ) applicationName()= "ALEPHA";
 			};
 		}
+
+		// Whether color is enabled, once `colorEnabled` has decided: -1 until then, and again whenever something
+		// it depends upon changes.
+		std::atomic< int > colorEnabledCache= -1;
 	}
 
 	void
 	exports::setApplicationName( std::string name )
 	{
 		storage::applicationName()= std::move( name );
+		colorEnabledCache= -1;
 	}
 
 	const std::string &
@@ -102,9 +127,21 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 			return d;
 		}
 
+		ScreenSize
+		askScreenSize( const int fd ) noexcept
+		{
+			// Use the `ioctl( TIOCGWINSZ )`, but we'll just defer to 24x80 if we fail that...
+			struct winsize ws;
+			if( not isatty( fd ) or ioctl( fd, TIOCGWINSZ, &ws ) == -1 or ws.ws_col == 0 ) return { 24, 80 };
+
+			return { ws.ws_row, ws.ws_col };
+		}
+
+		// This is asked of stdout directly, rather than through `Console::main`, which would cache it, and so
+		// install a `SIGWINCH` handler during static initialization.
 		int cachedScreenWidth= evaluate <=[]
 		{
-			const int underlying= getEnvOrDefault( screenWidthEnv(), Console::main().getScreenSize().columns );
+			const int underlying= getEnvOrDefault( screenWidthEnv(), askScreenSize( STDOUT_FILENO ).columns );
 			return std::min( underlying, getEnvOrDefault( screenWidthEnvLimit(), C::defaultScreenWidthLimit ) );
 		};
 
@@ -114,116 +151,56 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 		bool
 		colorEnabled()
 		{
-			if( not colorState.has_value() ) return not ::getenv( disableColorsEnv().c_str() );
+			if( const int cached= colorEnabledCache.load( std::memory_order_relaxed ); cached >= 0 ) return cached;
+
+			const bool rv= evaluate <=[]
+			{
+				if( not colorState.has_value() ) return not ::getenv( disableColorsEnv().c_str() );
 
-			if( colorState.value() == "never"_value ) return false;
-			if( colorState.value() == "always"_value ) return true;
-			assert( colorState.value() == "auto"_value );
+				if( colorState.value() == "never"_value ) return false;
+				if( colorState.value() == "always"_value ) return true;
+				assert( colorState.value() == "auto"_value );
 
-			return ::isatty( 1 ); // Auto means only do this for TTYs.
+				return bool( ::isatty( 1 ) ); // Auto means only do this for TTYs.
+			};
+			colorEnabledCache.store( rv, std::memory_order_relaxed );
+			return rv;
 		}
 
 		StaticValue< std::map< Style, SGR_String > > colorVariables;
 
+		// The escape sequence for each style handle (less one), kept in step with `colorVariables`.  Handles are
+		// given out by name, and a `deque` keeps each sequence in place as more are added.
+		StaticValue< std::deque< std::string > > styleEscapes;
+		StaticValue< std::map< std::string, std::uint32_t, std::less<> > > styleHandles;
 
-		SGR_String
-		parse( const std::string &token )
+		// Returns the handle for a style's name, giving it one if need be, and updates its escape sequence from
+		// `colorVariables`.
+		std::uint32_t
+		refreshStyle( const std::string &name )
 		{
-			const std::map< std::string, std::function< SGR_String () > > simple=
-			{
-				{ "reset", resetTextEffects },
-				{ "bold", setBold },
-				{ "dim", setFaint },
-				{ "faint", setFaint },
-				{ "italic", setItalic },
-				{ "underline", setUnderline },
-				{ "under", setUnderline },
-				{ "blink", setBlink },
-				{ "strike", setStrike },
-				{ "strikethrough", setStrike },
-				{ "strikethru", setStrike },
-				{ "doubleunderline", setDoubleUnderline },
-				{ "doubleunder", setDoubleUnderline },
-				{ "framed", setFramed },
-				{ "encircled", setEncircled },
-				{ "overline", setOverline },
-			};
-			if( simple.contains( token ) ) return simple.at( token )();
-
-			// The `fg:` is optional in "SGR Name"...
-			if( token.starts_with( "fg:" ) ) return parse( token.substr( 2 ) );
-
-			if( token.starts_with( "ansi:" ) ) return { '3' + token.substr( 5 ) };
-			if( token.starts_with( "ext:grey" ) )
-			{
-				std::ostringstream oss;
-				oss << "3;5;";
-				oss << int( TextColor::greyscale_base ) + boost::lexical_cast< int >( token.substr( 8 ) );
-				return { std::move( oss ).str() };
-			}
-			if( token.starts_with( "ext:rgb" ) )
+			const auto [ position, added ]= styleHandles().try_emplace( name, 0 );
+			if( added )
 			{
-				const std::string rgb= token.substr( 7 );
-				if( rgb.size() != 3 ) throw std::runtime_error{ "RGB request with more than 3 digits..." };
-				const int r= boost::lexical_cast< int >( rgb.substr( 0, 1 ) );
-				const int g= boost::lexical_cast< int >( rgb.substr( 1, 1 ) );
-				const int b= boost::lexical_cast< int >( rgb.substr( 2, 1 ) );
-				if( r < 0 or r > 5 ) throw std::runtime_error( "ext:rgb requested red value `" + rgb.substr( 0, 1 ) + "` out of range [0,5]" );
-				if( g < 0 or g > 5 ) throw std::runtime_error( "ext:rgb requested green value `" + rgb.substr( 1, 1 ) + "` out of range [0,5]" );
-				if( b < 0 or b > 5 ) throw std::runtime_error( "ext:rgb requested blue value `" + rgb.substr( 2, 1 ) + "` out of range [0,5]" );
-				std::ostringstream oss;
-				oss <<  "38;5;";
-				oss << int( TextColor::rgb_base ) + r * int( TextColor::red_radix ) + g * int( TextColor::green_radix ) + b * int( TextColor::blue_radix );
-				return { std::move( oss ).str() };
+				styleEscapes().emplace_back();
+				position->second= styleEscapes().size();
 			}
-			if( token.starts_with( "ext:" ) ) return { "38;5;" + token.substr( 4 ) };
-			if( token.starts_with( "#" ) )
-			{
-				const auto code= token.substr( 1 );
-				const auto [ r_s, g_s, b_s ]= evaluate <=[&]
-				{
-					if( code.size() == 3 ) return std::tuple{ code.substr( 0, 1 ), code.substr( 1, 1 ), code.substr( 2, 1 ) };
-					if( code.size() == 6 ) return std::tuple{ code.substr( 0, 2 ), code.substr( 2, 2 ), code.substr( 4, 2 ) };
-					throw std::runtime_error( "True color code parse error." );
-				};
-				int r, g, b;
-				{
-					std::istringstream iss{ r_s };
-					iss >> std::hex >> r;
-				}
-
-				{
-					std::istringstream iss{ g_s };
-					iss >> std::hex >> g;
-				}
-
-				{
-					std::istringstream iss{ b_s };
-					iss >> std::hex >> b;
-				}
 
-				std::ostringstream oss;
-				oss << "38;2;" << std::dec << r << ';' << g << ';' << b;
-				return { std::move( oss ).str() };
-			}
-
-			throw std::runtime_error{ "Unrecognized SGR Name keyword: `" + token + "`" };
+			const auto found= colorVariables().find( Style{ name } );
+			styleEscapes()[ position->second - 1 ]= found == end( colorVariables() ) ? "" : "\e[" + found->second.code + 'm';
+			return position->second;
 		}
 
-		SGR_String
-		parseTokens( std::vector< std::string > tokens )
-		{
-
-			SGR_String rv;
-			for( const auto token: tokens ) rv+= parse( token );
-
-			return rv;
-		}
 
 		auto init= enroll <=[]
 		{
 			--"screen-width"_option << affectsHelp << cachedScreenWidth << "Sets the screen width for use in automatic word-wrapping. !default!";
-			--"color"_option << affectsHelp << colorState << "Select the application color preference.  If not passed, the environment variable `"
+			--"color"_option << affectsHelp << []( const ColorState state )
+			{
+				colorState= state;
+				colorEnabledCache= -1;
+			}
+			<< "Select the application color preference.  If not passed, the environment variable `"
 					<< disableColorsEnv() << "` will be respected.  Otherwise, `auto` will detect if a TTY is on stdout.  `never` will entirely "
 					<< "disable color output.  And `always` will force color output.";
 			--"list-color-variables"_option << []
@@ -270,7 +247,8 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 					const Style name{ parsed.at( 0 ) };
 					const auto value= parsed.at( 1 );
 
-					colorVariables()[ name ]= parseTokens( split( value, ' ' ) );
+					colorVariables()[ name ]= SGR_String{ parseSgrNames< std::string >( value ) };
+					refreshStyle( name.name );
 				}
 			}
 			// Then the regular terminal codes
@@ -290,6 +268,7 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 					const auto value= parsed.at( 1 );
 
 					colorVariables()[ name ]= SGR_String{ value };
+					refreshStyle( name.name );
 				}
 			}
 		};
@@ -307,6 +286,7 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 		if( name == "reset" ) throw std::runtime_error( "The `reset` style name is reserved." );
 		Style style{ name };
 		colorVariables().insert( { style, sgr } );
+		style.handle= refreshStyle( name );
 		return style;
 	}
 
@@ -319,21 +299,23 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 	std::ostream &
 	exports::operator << ( std::ostream &os, const Style &s )
 	{
-		if( colorEnabled() and colorVariables().contains( s ) )
+		if( not colorEnabled() ) return os;
+
+		const std::uint32_t handle= s.handle ? s.handle : evaluate <=[&]() -> std::uint32_t
 		{
-			sendSGR( os, colorVariables().at( s ) );
-		}
+			const auto found= styleHandles().find( s.name );
+			return found == end( styleHandles() ) ? 0 : found->second;
+		};
+		if( handle == 0 ) return os;
 
-		return os;
+		const auto &escape= styleEscapes()[ handle - 1 ];
+		return os.write( escape.data(), escape.size() );
 	}
 
 	std::ostream &
 	exports::operator << ( std::ostream &os, decltype( resetStyle ) )
 	{
-		if( colorEnabled() )
-		{
-			sendSGR( os, resetTextEffects() );
-		}
+		if( colorEnabled() ) os.write( "\e[0m", 4 );
 
 		return os;
 	}
@@ -344,6 +326,45 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 		cooked, raw, noblock,
 	};
 
+	namespace
+	{
+		namespace storage
+		{
+			// The number of times the terminal has been resized.  Consoles compare it with the count they last saw,
+			// to know when to forget what they have cached about the screen.
+			std::atomic< unsigned > resizes;
+
+			struct sigaction previousWinchAction;
+		}
+
+		void
+		onWinch( const int signal, siginfo_t *const info, void *const context )
+		{
+			++storage::resizes;
+
+			// Whoever was watching for resizes before still gets to.
+			const auto &previous= storage::previousWinchAction;
+			if( previous.sa_flags & SA_SIGINFO ) previous.sa_sigaction( signal, info, context );
+			else if( previous.sa_handler != SIG_DFL and previous.sa_handler != SIG_IGN ) previous.sa_handler( signal );
+		}
+
+		void
+		watchResizes()
+		{
+			static const bool installed= evaluate <=[]
+			{
+				struct sigaction action{};
+				action.sa_sigaction= onWinch;
+				// Only the resize is of interest, so system calls which it interrupts carry on.  (`poll` is never
+				// restarted, so a wait for input still ends.)
+				action.sa_flags= SA_SIGINFO | SA_RESTART;
+				sigemptyset( &action.sa_mask );
+				return sigaction( SIGWINCH, &action, &storage::previousWinchAction ) == 0;
+			};
+			std::ignore= installed;
+		}
+	}
+
 
 	struct Console::Impl
 	{
@@ -353,14 +374,175 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 		std::ostream stream;
 		std::stack< std::pair< struct termios, ConsoleMode > > modeStack;
 		ConsoleMode mode= cooked;
-		std::optional< int > cachedScreenWidth;
+		std::optional< ScreenSize > cachedScreenSize;
+		unsigned resizesSeen= storage::resizes;
+
+		// The frame on the screen, as far as `render` knows, and a buffer to build the next one's output in.
+		std::optional< Frame > previousFrame;
+		std::string frameOutput;
+
+		int inputFd;
+		InputDecoder decoder;
+		std::array< char, C::inputBufferSize > inputBuffer;
+		bool inputClosed= false;
+
+		// Events read while waiting for something else, to be returned by the next `readInput`.
+		std::vector< InputEvent > deferredEvents;
+
+		// The last position reported, and the epoch of each query still unanswered, with when it was sent.
+		// Forgetting the position starts a new epoch, so that answers to queries sent before then are ignored.
+		struct PositionQuery
+		{
+			unsigned epoch;
+			std::chrono::steady_clock::time_point sent;
+		};
+		std::optional< CursorPosition > position;
+		std::deque< PositionQuery > positionQueries;
+		unsigned positionEpoch= 0;
 
 		explicit
-		Impl( const int fd )
-			: fd( fd ), filebuf( fd, std::ios::out ), stream( &filebuf )
+		Impl( const int fd, const int inputFd )
+			: fd( fd ), filebuf( fd, std::ios::out ), stream( &filebuf ), inputFd( inputFd )
 		{}
+
+		void
+		forgetPosition() noexcept
+		{
+			position.reset();
+			++positionEpoch;
+		}
+
+		// Forget what was cached about the screen, if it has been resized since this last looked.  This is called
+		// before anything is cached, so resizes are only watched for once there is something to forget.
+		void
+		checkResizes() noexcept
+		{
+			watchResizes();
+
+			const unsigned resizes= storage::resizes;
+			if( resizes == resizesSeen ) return;
+
+			resizesSeen= resizes;
+			cachedScreenSize.reset();
+			forgetPosition();
+		}
+
+		// Give up on the queries sent at or before `sent`, so that their answers are no longer expected: a
+		// terminal which never answers would otherwise have every shifted F3 (which looks just like an answer)
+		// taken for one.
+		void
+		expireQueries( const std::chrono::steady_clock::time_point sent ) noexcept
+		{
+			std::size_t expired= 0;
+			for( ; not positionQueries.empty() and positionQueries.front().sent <= sent; ++expired ) positionQueries.pop_front();
+			decoder.forgetPositionReports( expired );
+		}
+
+		void expireQueries() noexcept { expireQueries( std::chrono::steady_clock::now() - C::positionReportTimeout ); }
+
+		void receive( std::vector< InputEvent > &events, std::chrono::milliseconds timeout );
+
+		// Enter a raw mode, remembering the one to return to.  `when` is as for `tcsetattr`: `TCSAFLUSH` discards
+		// input which has not yet been read, and `TCSANOW` keeps it.
+		void pushMode( int min, int when );
+		void popMode( int when );
+
+		// Raw mode, for as long as the guard lives, unless the console is in it already, or is not a terminal.
+		// Input which was typed ahead is kept.
+		auto
+		rawModeGuard()
+		{
+			const bool skip= mode == raw or not isatty( inputFd );
+			return AutoRAII
+			{
+				[this, skip] { if( not skip ) pushMode( 1, TCSANOW ); },
+				[this, skip] { if( not skip ) popMode( TCSANOW ); },
+			};
+		}
 	};
 
+	/*!
+	 * Wait up to `timeout` (forever, if negative) for input, and decode all of it which has arrived onto `events`.
+	 *
+	 * Position reports are taken out of the events, to answer queries.  Any input, including a position report,
+	 * ends the wait.
+	 */
+	void
+	Console::Impl::receive( std::vector< InputEvent > &events, const std::chrono::milliseconds timeout )
+	{
+		const auto deadline= std::chrono::steady_clock::now() + std::max( timeout, std::chrono::milliseconds::zero() );
+		bool received= false;
+
+		// Once something has been received, only input which has already arrived is waited for.
+		const auto remaining= [&]() -> int
+		{
+			if( received ) return 0;
+			if( timeout.count() < 0 ) return -1;
+			const auto left= std::chrono::ceil< std::chrono::milliseconds >( deadline - std::chrono::steady_clock::now() );
+			return std::clamp< std::chrono::milliseconds::rep >( left.count(), 0, std::numeric_limits< int >::max() );
+		};
+
+		const auto decoded= [&]( const std::size_t before )
+		{
+			auto kept= begin( events ) + before;
+			for( auto event= kept; event != end( events ); ++event )
+			{
+				if( const auto *const report= std::get_if< PositionReport >( &*event ) )
+				{
+					if( positionQueries.front().epoch == positionEpoch ) position= CursorPosition{ report->x, report->y };
+					positionQueries.pop_front();
+				}
+				else *kept++= std::move( *event );
+			}
+			events.erase( kept, end( events ) );
+			received= true;
+		};
+
+		while( not inputClosed )
+		{
+			const bool pending= decoder.pending();
+			pollfd request{ inputFd, POLLIN, 0 };
+			const int ready= ::poll( &request, 1, pending ? C::escapeTimeoutMs : remaining() );
+			if( ready == -1 )
+			{
+				// A signal (such as `SIGWINCH`) ends the wait, so that the caller can deal with it.
+				if( errno == EINTR ) break;
+				throw std::system_error{ errno, std::generic_category(), "Cannot poll the console's input" };
+			}
+
+			const std::size_t before= events.size();
+			if( ready == 0 )
+			{
+				if( not pending ) break;
+				decoder.flush( events );
+				if( events.size() > before ) decoded( before );
+				if( remaining() == 0 ) break;
+				continue;
+			}
+
+			const auto amount= ::read( inputFd, inputBuffer.data(), inputBuffer.size() );
+			if( amount == -1 )
+			{
+				if( errno == EINTR ) break;
+				if( errno == EAGAIN ) continue;
+				throw std::system_error{ errno, std::generic_category(), "Cannot read the console's input" };
+			}
+
+			if( amount == 0 )
+			{
+				inputClosed= true;
+				decoder.flush( events );
+				decoded( before );
+				break;
+			}
+
+			expireQueries();
+			decoder.feed( { inputBuffer.data(), std::size_t( amount ) }, events );
+			if( events.size() > before ) decoded( before );
+		}
+	}
+
+
 	auto
 	Console::getMode() const
 	{
@@ -381,83 +563,71 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 			UnknownScreenError() : std::runtime_error( "Terminal is unrecognized.  Using defaults." ) {}
 		};
 
-		auto
-		rawModeGuard( Console console )
+		struct NoPositionReportError : std::runtime_error
 		{
-			const bool skip= console.getMode() == ConsoleMode::raw;
-			return AutoRAII
-			{
-				[skip, &console]
-				{
-					if( skip ) return;
-					console.setRaw();
-				},
-				[skip, &console]
-				{
-					if( skip ) return;
-					console.popTermMode();
-				},
-			};
-		}
+			NoPositionReportError() : std::runtime_error( "The terminal did not report the cursor position." ) {}
+		};
 	}
 	
 
 	Console::Console( const int fd )
-		: impl( std::make_unique< Impl >( fd ) )
+		: Console( fd, fd )
 	{}
 
+	Console::Console( const int fd, const int inputFd )
+		: impl( std::make_unique< Impl >( fd, inputFd ) )
+	{}
+
+	Console::~Console()= default;
+
 	std::ostream &
 	Console::csi()
 	{
-		return pimpl().stream;
+		return console_m::csi( pimpl().stream );
 	}
 
 	void
-	Console::popTermMode()
+	Console::Impl::popMode( const int when )
 	{
-		tcsetattr( pimpl().fd, TCSAFLUSH, &pimpl().modeStack.top().first );
-		pimpl().mode= pimpl().modeStack.top().second;
-		pimpl().modeStack.pop();
+		tcsetattr( fd, when, &modeStack.top().first );
+		mode= modeStack.top().second;
+		modeStack.pop();
 	}
 
+	void Console::popTermMode() { pimpl().popMode( TCSAFLUSH ); }
+
 	namespace
 	{
 		struct termios
-		setRawModeWithMin( const int fd, const int min )
+		setRawModeWithMin( const int fd, const int min, const int when )
 		{
-			struct termios next;
 			struct termios now;
-
 			if( tcgetattr( fd, &now ) == -1 ) throw UnknownScreenError{};
 
+			struct termios next= now;
 			next.c_iflag&= ~( BRKINT | ICRNL | INPCK | ISTRIP | IXON );
 			next.c_oflag&= ~( OPOST );
 			next.c_cflag|= CS8;
-			next.c_lflag&= !( ECHO | ICANON | IEXTEN | ISIG );
+			next.c_lflag&= ~( ECHO | ICANON | IEXTEN | ISIG );
 			next.c_cc[ VMIN ]= min;
 			next.c_cc[ VTIME ]= 0;
 
-			if( tcsetattr( fd, TCSAFLUSH, &next ) ) throw UnknownScreenError{};
+			if( tcsetattr( fd, when, &next ) ) throw UnknownScreenError{};
 
 			return now;
 		}
 	}
 
 	void
-	Console::setRaw()
+	Console::Impl::pushMode( const int min, const int when )
 	{
-		const auto old= setRawModeWithMin( pimpl().fd, 1 );
-		pimpl().modeStack.emplace( old, pimpl().mode );
-		pimpl().mode= raw;
+		const auto old= setRawModeWithMin( fd, min, when );
+		modeStack.emplace( old, mode );
+		mode= raw;
 	}
 
-	void
-	Console::setNoblock()
-	{
-		const auto old= setRawModeWithMin( pimpl().fd, 0 );
-		pimpl().modeStack.emplace( old, pimpl().mode );
-		pimpl().mode= raw;
-	}
+	void Console::setRaw() { pimpl().pushMode( 1, TCSAFLUSH ); }
+	void Console::setNoblock() { pimpl().pushMode( 0, TCSAFLUSH ); }
 
 	void Console::killLineTail() { csi() << 'K'; }
 	void Console::killLineHead() { csi() << "1K"; }
@@ -467,26 +637,365 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 	void Console::showCursor() { csi() << "?25h"; }
 
 	void Console::saveHardwareCursor() { csi() << 's'; }
-	void Console::restoreHardwareCursor() { csi() << 'u'; }
+	void Console::restoreHardwareCursor() { csi() << 'u'; pimpl().forgetPosition(); }
+
+	void Console::gotoX( const int x ) { csi() << x << 'G'; pimpl().forgetPosition(); }
 
-	void Console::gotoX( const int x ) { csi() << x << 'G'; }
+	// VPA: vertical position absolute, which keeps the cursor's column.
+	void Console::gotoY( const int y ) { csi() << y << 'd'; pimpl().forgetPosition(); }
 
 	void
-	Console::gotoY( const int y )
+	Console::gotoXY( const int x, const int y )
 	{
-		cursorUp( 1'000'000 );
-		cursorDown( y );
+		csi() << y << ';' << x << 'H';
+		pimpl().checkResizes();
+		pimpl().forgetPosition();
+		pimpl().position= CursorPosition{ x, y };
 	}
 
-	void Console::gotoXY( const int x, const int y ) { csi() << y << ';' << x << 'H'; }
-
-	void Console::cursorUp( const unsigned amt ) { csi() << amt << 'A'; }
-	void Console::cursorDown( const unsigned amt ) { csi() << amt << 'B'; }
-	void Console::cursorRight( const unsigned amt ) { csi() << amt << 'C'; }
-	void Console::cursorLeft( const unsigned amt ) { csi() << amt << 'D'; }
+	void Console::cursorUp( const unsigned amt ) { csi() << amt << 'A'; pimpl().forgetPosition(); }
+	void Console::cursorDown( const unsigned amt ) { csi() << amt << 'B'; pimpl().forgetPosition(); }
+	void Console::cursorRight( const unsigned amt ) { csi() << amt << 'C'; pimpl().forgetPosition(); }
+	void Console::cursorLeft( const unsigned amt ) { csi() << amt << 'D'; pimpl().forgetPosition(); }
 
 	void Console::clearScreen() { csi() << "2J"; }
 
+	// Button-event tracking (1002), reported in the SGR encoding (1006), which has no limit on positions.
+	void Console::enableMouseReports() { csi() << "?1002h"; csi() << "?1006h" << std::flush; }
+	void Console::disableMouseReports() { csi() << "?1006l"; csi() << "?1002l" << std::flush; }
+
+	void Console::enableBracketedPaste() { csi() << "?2004h" << std::flush; }
+	void Console::disableBracketedPaste() { csi() << "?2004l" << std::flush; }
+
+	std::vector< InputEvent >
+	Console::readInput( const std::chrono::milliseconds timeout )
+	{
+		auto rv= std::exchange( pimpl().deferredEvents, {} );
+		pimpl().receive( rv, rv.empty() ? timeout : std::chrono::milliseconds::zero() );
+		return rv;
+	}
+
+	bool Console::inputClosed() const noexcept { return pimpl().inputClosed; }
+
+	int Console::inputFd() const noexcept { return pimpl().inputFd; }
+
+	void
+	Console::requestPosition()
+	{
+		auto &impl= pimpl();
+		impl.checkResizes();
+		// DSR 6: the terminal answers with `ESC [ row ; column R`.
+		csi() << "6n" << std::flush;
+		impl.decoder.expectPositionReport();
+		impl.positionQueries.push_back( { impl.positionEpoch, std::chrono::steady_clock::now() } );
+	}
+
+	std::optional< CursorPosition >
+	Console::knownPosition()
+	{
+		pimpl().checkResizes();
+		pimpl().expireQueries();
+		return pimpl().position;
+	}
+
+	void Console::invalidatePosition() { pimpl().forgetPosition(); }
+
+	CursorPosition
+	Console::getXY()
+	{
+		auto &impl= pimpl();
+		if( const auto known= knownPosition() ) return *known;
+
+		// Without raw mode, the terminal would hold its answer back until enter is pressed.
+		const auto guard= impl.rawModeGuard();
+
+		// An answer to a query sent before the position was forgotten would not do.
+		if( impl.positionQueries.empty() or impl.positionQueries.back().epoch != impl.positionEpoch ) requestPosition();
+
+		// The answer is waited for only as long as it is expected.
+		const auto deadline= impl.positionQueries.back().sent + C::positionReportTimeout;
+		while( not impl.position )
+		{
+			const auto left= std::chrono::ceil< std::chrono::milliseconds >( deadline - std::chrono::steady_clock::now() );
+			if( left <= std::chrono::milliseconds::zero() or impl.inputClosed )
+			{
+				// Nothing which is still unanswered will be answered now.
+				impl.expireQueries( std::chrono::steady_clock::time_point::max() );
+				throw NoPositionReportError{};
+			}
+			impl.receive( impl.deferredEvents, left );
+		}
+		return *impl.position;
+	}
+
+	int Console::getX() { return getXY().x; }
+	int Console::getY() { return getXY().y; }
+
+	namespace
+	{
+		// Decode the code point at `position`, and advance past it.  Bytes which are not valid UTF-8 decode as U+FFFD.
+		char32_t
+		decodeUtf8( const std::string_view text, std::size_t &position ) noexcept
+		{
+			const unsigned char lead= text[ position ];
+			if( lead < 0x80 )
+			{
+				++position;
+				return lead;
+			}
+
+			const std::size_t length= lead >= 0xF8 ? 0 : lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC2 ? 2 : 0;
+			char32_t rv= lead & ( 0x7F >> length );
+			bool valid= length and position + length <= text.size();
+			for( std::size_t i= 1; valid and i < length; ++i )
+			{
+				const unsigned char continuation= text[ position + i ];
+				valid= ( continuation & 0xC0 ) == 0x80;
+				rv= rv << 6 | ( continuation & 0x3F );
+			}
+
+			if( not valid )
+			{
+				++position;
+				return U'\uFFFD';
+			}
+			position+= length;
+			return rv;
+		}
+
+		void
+		encodeUtf8( std::string &out, const char32_t codePoint )
+		{
+			if( codePoint < 0x80 ) out+= char( codePoint );
+			else if( codePoint < 0x800 )
+			{
+				out+= char( 0xC0 | codePoint >> 6 );
+				out+= char( 0x80 | ( codePoint & 0x3F ) );
+			}
+			else if( codePoint < 0x10000 )
+			{
+				out+= char( 0xE0 | codePoint >> 12 );
+				out+= char( 0x80 | ( codePoint >> 6 & 0x3F ) );
+				out+= char( 0x80 | ( codePoint & 0x3F ) );
+			}
+			else
+			{
+				out+= char( 0xF0 | codePoint >> 18 );
+				out+= char( 0x80 | ( codePoint >> 12 & 0x3F ) );
+				out+= char( 0x80 | ( codePoint >> 6 & 0x3F ) );
+				out+= char( 0x80 | ( codePoint & 0x3F ) );
+			}
+		}
+
+		void
+		appendNumber( std::string &out, const int number )
+		{
+			std::array< char, std::numeric_limits< int >::digits10 + 2 > buffer;
+			const auto result= std::to_chars( buffer.data(), buffer.data() + buffer.size(), number );
+			out.append( buffer.data(), result.ptr );
+		}
+
+		/*!
+		 * Append the output which changes a screen showing `previous` into one showing `next`.
+		 *
+		 * The cursor is only moved to reach a cell which changed: along a row with CUF, to the start of the next
+		 * row with CR LF, and otherwise with CUP.  A position of 0 in `cursor` means that coordinate is unknown.
+		 * The style is only changed when it differs from that of the last cell written.  Each frame numbers its
+		 * own styles, so they are matched up by their SGR codes, first.
+		 */
+		void
+		diffFrames( std::string &out, const Frame &previous, const Frame &next, const bool color, CursorPosition cursor )
+		{
+			const std::size_t unmatched= std::numeric_limits< std::size_t >::max();
+			std::vector< std::size_t > translated( next.styleCount(), unmatched );
+			for( std::size_t i= 0; i < next.styleCount(); ++i )
+			{
+				for( std::size_t j= 0; j < previous.styleCount(); ++j )
+				{
+					if( next.style( i ).code == previous.style( j ).code )
+					{
+						translated[ i ]= j;
+						break;
+					}
+				}
+			}
+
+			const auto [ rows, columns ]= next.size();
+
+			const auto moveTo= [&]( const int x, const int y )
+			{
+				if( cursor.y == y and cursor.x == x ) return;
+
+				if( cursor.y == y and cursor.x and x > cursor.x )
+				{
+					out+= "\e[";
+					if( x - cursor.x > 1 ) appendNumber( out, x - cursor.x );
+					out+= 'C';
+				}
+				else if( cursor.y and y == cursor.y + 1 and x == 1 ) out+= "\r\n";
+				else
+				{
+					out+= "\e[";
+					appendNumber( out, y );
+					if( x > 1 )
+					{
+						out+= ';';
+						appendNumber( out, x );
+					}
+					out+= 'H';
+				}
+				cursor= { x, y };
+			};
+
+			std::uint16_t pen= 0;
+			for( int y= 1; y <= rows; ++y ) for( int x= 1; x <= columns; ++x )
+			{
+				const auto &cell= next.at( x, y );
+				if( cell.glyph == 0 ) continue; // It is drawn along with its left half.
+
+				const bool wide= x < columns and next.at( x + 1, y ).glyph == 0;
+				const auto unchanged= [&]( const int column )
+				{
+					const auto &now= next.at( column, y );
+					const auto &before= previous.at( column, y );
+					return now.glyph == before.glyph and ( not color or translated[ now.style ] == before.style );
+				};
+				if( unchanged( x ) and ( not wide or unchanged( x + 1 ) ) ) continue;
+
+				moveTo( x, y );
+				if( color and cell.style != pen )
+				{
+					out+= "\e[0";
+					if( const auto &code= next.style( cell.style ).code; not code.empty() )
+					{
+						out+= ';';
+						out+= code;
+					}
+					out+= 'm';
+					pen= cell.style;
+				}
+				encodeUtf8( out, cell.glyph );
+
+				cursor.x+= wide ? 2 : 1;
+				// Writing the last column leaves the cursor there, waiting to wrap, so its column is uncertain.
+				if( cursor.x > columns ) cursor.x= 0;
+				if( wide ) ++x;
+			}
+
+			if( pen != 0 ) out+= "\e[0m";
+		}
+
+		void
+		writeAll( const int fd, std::string_view text )
+		{
+			while( not text.empty() )
+			{
+				const auto written= ::write( fd, text.data(), text.size() );
+				if( written < 0 )
+				{
+					if( errno == EINTR ) continue;
+					throw std::system_error{ errno, std::generic_category(), "Unable to write to the console" };
+				}
+				text.remove_prefix( written );
+			}
+		}
+	}
+
+	Frame::Frame( const ScreenSize size )
+		: size_( size ), cells( std::size_t( std::max( size.rows, 0 ) ) * std::max( size.columns, 0 ) ), styles{ SGR_String{} }
+	{}
+
+	void
+	Frame::clear()
+	{
+		std::fill( begin( cells ), end( cells ), Cell{} );
+		styles.resize( 1 );
+	}
+
+	std::uint16_t
+	Frame::intern( const SGR_String &style )
+	{
+		const auto found= std::find_if( begin( styles ), end( styles ),
+				[&]( const SGR_String &existing ) { return existing.code == style.code; } );
+		if( found != end( styles ) ) return found - begin( styles );
+
+		if( styles.size() > std::numeric_limits< std::uint16_t >::max() )
+		{
+			throw std::runtime_error( "A frame can only hold 65536 different styles." );
+		}
+		styles.push_back( style );
+		return styles.size() - 1;
+	}
+
+	const Frame::Cell &
+	Frame::at( const int x, const int y ) const
+	{
+		if( x < 1 or x > size_.columns or y < 1 or y > size_.rows ) throw std::out_of_range( "That position is outside the frame." );
+		return cells[ std::size_t( y - 1 ) * size_.columns + ( x - 1 ) ];
+	}
+
+	int
+	Frame::put( int x, const int y, const std::string_view text, const SGR_String &style )
+	{
+		if( y < 1 or y > size_.rows ) return x;
+
+		const auto index= intern( style );
+		Cell *const row= cells.data() + std::size_t( y - 1 ) * size_.columns;
+
+		// Overwriting either half of a wide character leaves a blank in its other half.
+		const auto release= [&]( const int column )
+		{
+			if( row[ column - 1 ].glyph == 0 ) row[ column - 2 ].glyph= U' ';
+			else if( column < size_.columns and row[ column ].glyph == 0 ) row[ column ].glyph= U' ';
+		};
+
+		for( std::size_t position= 0; position < text.size() and x <= size_.columns; )
+		{
+			const char32_t codePoint= decodeUtf8( text, position );
+			const int width= codePointWidth( codePoint );
+			if( width == 0 ) continue;
+			if( x + width - 1 > size_.columns ) break;
+
+			for( int column= std::max( x, 1 ); column < x + width; ++column ) release( column );
+			for( int column= std::max( x, 1 ); column < x + width; ++column )
+			{
+				// A wide character which starts left of the frame shows only as a blank in its right half.
+				row[ column - 1 ]= { column == x ? codePoint : x < 1 ? U' ' : U'\0', index };
+			}
+			x+= width;
+		}
+
+		return x;
+	}
+
+	void
+	Console::render( const Frame &frame )
+	{
+		auto &state= pimpl();
+		auto &out= state.frameOutput;
+		out.clear();
+
+		const auto size= frame.size();
+		CursorPosition cursor{ 0, 0 };
+		if( not state.previousFrame.has_value() or state.previousFrame->size().rows != size.rows
+				or state.previousFrame->size().columns != size.columns )
+		{
+			out+= "\e[0m\e[H\e[2J";
+			state.previousFrame.emplace( size );
+			cursor= { 1, 1 };
+		}
+
+		diffFrames( out, state.previousFrame.value(), frame, colorEnabled(), cursor );
+		state.previousFrame= frame;
+
+		if( out.empty() ) return;
+		state.stream.flush();
+		writeAll( state.fd, out );
+		state.forgetPosition();
+	}
+
+	void Console::invalidateFrame() { pimpl().previousFrame.reset(); }
+
 	SGR_String exports::resetTextEffects() { return { "0" }; }
 
 	SGR_String exports::setBold() { return { "1" }; }
@@ -498,7 +1007,7 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 	SGR_String exports::setDoubleUnderline() { return { "21" }; }
 	SGR_String exports::setFramed() { return { "51" }; }
 	SGR_String exports::setEncircled() { return { "52" }; }
-	SGR_String exports::setOverline() { return { "52" }; }
+	SGR_String exports::setOverline() { return { "53" }; }
 
 	SGR_String
 	exports::setFgColor( const BasicTextColor c )
@@ -587,46 +1096,23 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 		return { std::move( oss ).str() };
 	}
 
-	SGR_String
-	exports::operator ""_sgr( const char *const p, const std::size_t sz )
-	{
-		const std::string s{ p, p + sz };
-
-		const auto tokens= split( s, ' ' );
-		return parseTokens( tokens );
-	}
-
 	int
 	exports::getConsoleWidth()
 	{
 		return cachedScreenWidth;
 	}
 
-	int
-	Console::getScreenWidth()
-	{
-		if( not pimpl().cachedScreenWidth.has_value() )
-		{
-			pimpl().cachedScreenWidth= getScreenSize().columns;
-		}
-
-		return pimpl().cachedScreenWidth.value();
-	}
+	int Console::getScreenWidth() { return getScreenSize().columns; }
+	int Console::getScreenHeight() { return getScreenSize().rows; }
 
 	ScreenSize
 	Console::getScreenSize()
-	try
 	{
-		if( not isatty( pimpl().fd )  ) throw UnknownScreenError{};
-
-		// Use the `ioctl( TIOCGWINSZ )`, but we'll just defer to 24x80 if we fail that...
-		struct winsize ws;
-		const int ec= ioctl( pimpl().fd, TIOCGWINSZ, &ws );
-		if( ec == -1 or ws.ws_col == 0 ) throw UnknownScreenError{};
-
-		return { ws.ws_row, ws.ws_col };
+		auto &impl= pimpl();
+		impl.checkResizes();
+		if( not impl.cachedScreenSize ) impl.cachedScreenSize= askScreenSize( impl.fd );
+		return *impl.cachedScreenSize;
 	}
-	catch( const UnknownScreenError & ) { return { 24, 80 }; } // Fallback position....
 
 	namespace
 	{
@@ -639,7 +1125,7 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 	Console &
 	Console::main()
 	{
-		if( not storage::console ) storage::console= std::make_unique< Console >( 1 ); // stdout
+		if( not storage::console ) storage::console= std::make_unique< Console >( 1, 0 ); // stdout and stdin
 		return *storage::console;
 	}
 }
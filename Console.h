@@ -4,10 +4,19 @@ static_assert( __cplusplus > 2020'00 );
 
 #include <Alepha/Alepha.h>
 
+#include <cstdint>
+
+#include <chrono>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <optional>
+#include <vector>
 
+#include <Alepha/ConstexprString.h>
+#include <Alepha/InputDecoder.h>
 #include <Alepha/TotalOrder.h>
+#include <Alepha/sgr_names.h>
 
 // These are some terminal/console control primitives.
 // There are several "modern" terminal assumptions built
@@ -26,6 +35,7 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 		struct CursorPosition;
 
 		class Console;
+		class Frame;
 
 		struct SGR_String
 		{
@@ -46,17 +56,36 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 			return lhs= lhs + rhs;
 		}
 
-		// Parses sgr token names, like "bold ext:red"
-		[[nodiscard]] SGR_String operator ""_sgr( const char *p, std::size_t sz );
+		/*!
+		 * Parses SGR token names, like "bold ext:rgb500", at compile time.
+		 *
+		 * See `parseSgrNames` for the language.  A malformed name is a compile error.
+		 */
+		template< ConstexprString text >
+		[[nodiscard]] SGR_String
+		operator ""_sgr()
+		{
+			static constexpr ConstexprString code= parseSgrNames( text.c_str() );
+			return SGR_String{ { code.data(), code.size() } };
+		}
 
 		enum class BasicTextColor : int;
 		enum class TextColor : int;
 
+		/*!
+		 * A named text style, whose SGR codes the user may choose (see `createStyle`).
+		 *
+		 * A style returned by `createStyle` carries a handle to its escape sequence, so writing it to a stream is
+		 * a single copy.  A style made from just a name is found by that name when it is written.  Styles are
+		 * compared by name.
+		 */
 		struct Style
 		{
 			std::string name;
+			std::uint32_t handle= 0;
 
-			TotalOrder operator <=> ( const Style & ) const= default;
+			TotalOrder operator <=> ( const Style &other ) const { return name <=> other.name; }
+			bool operator == ( const Style &other ) const { return name == other.name; }
 		};
 		std::ostream &operator << ( std::ostream &, const Style & );
 
@@ -81,6 +110,57 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 	{
 		int x;
 		int y;
+
+		friend bool operator == ( const CursorPosition &, const CursorPosition & )= default;
+	};
+
+	/*!
+	 * A grid of character cells, to be drawn to a `Console` all at once.
+	 *
+	 * A live display builds each frame from scratch and hands it to `Console::render`, which sends only the cells
+	 * which differ from the frame it last drew, along with the cursor moves and SGR changes needed to reach them.
+	 */
+	class exports::Frame
+	{
+		public:
+			struct Cell
+			{
+				char32_t glyph= U' '; // The right half of a wide character holds 0.
+				std::uint16_t style= 0; // An index into the frame's styles; 0 is the terminal's default.
+
+				friend bool operator == ( const Cell &, const Cell & )= default;
+			};
+
+		private:
+			ScreenSize size_;
+			std::vector< Cell > cells;
+			std::vector< SGR_String > styles;
+
+			std::uint16_t intern( const SGR_String &style );
+
+		public:
+			explicit Frame( ScreenSize size );
+
+			ScreenSize size() const noexcept { return size_; }
+
+			// Blank every cell.
+			void clear();
+
+			/*!
+			 * Write UTF-8 text into one row, starting at column `x` of row `y`.
+			 *
+			 * Positions count from 1, as they do for `Console::gotoXY`.  Text which runs past the right edge is
+			 * clipped.  Wide characters take two cells, and zero-width characters (including control characters)
+			 * are dropped.
+			 *
+			 * @return The column just past the text.
+			 */
+			int put( int x, int y, std::string_view text, const SGR_String &style= {} );
+
+			const Cell &at( int x, int y ) const;
+
+			const SGR_String &style( std::uint16_t index ) const { return styles.at( index ); }
+			std::size_t styleCount() const noexcept { return styles.size(); }
 	};
 
 	class exports::Console
@@ -95,9 +175,13 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 
 
 		public:
-			// A console object can only be constructed on a raw UNIX file descriptor.
+			// A console object can only be constructed on a raw UNIX file descriptor.  Input is read from the same
+			// descriptor, unless another is given.
 			explicit Console( int fd );
+			explicit Console( int fd, int inputFd );
+			~Console();
 
+			// The console on standard output, which reads its input from standard input.
 			static Console &main();
 			auto getMode() const;
 
@@ -107,6 +191,8 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 			// Althought this could be implemented by combining the above observers,
 			// there are more efficient ways to implement this, thus we actually
 			// keep them separate.
+			//
+			// The size is asked of the terminal once, and remembered until it is resized (`SIGWINCH`).
 			ScreenSize getScreenSize();
 
 			void hideCursor();
@@ -139,9 +225,40 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 			void gotoY( int y );
 			void gotoXY( int x, int y );
 
+			/*!
+			 * Where the cursor is.
+			 *
+			 * A known position (see `knownPosition`) is returned at once.  Otherwise the terminal is asked, and its
+			 * answer waited for, briefly.  Any other input read meanwhile is kept for `readInput`, as is anything
+			 * typed before the call.
+			 *
+			 * @throws std::runtime_error if the terminal does not answer in time.  The queries outstanding are then
+			 * given up on, so that a late answer is read as the key it resembles (shifted F3).
+			 */
+			CursorPosition getXY();
 			int getX();
 			int getY();
-			CursorPosition getXY();
+
+			/*!
+			 * Ask the terminal where the cursor is, without waiting for the answer.
+			 *
+			 * The answer is taken from the input by `readInput` (or `getXY`), after which `knownPosition` has it.
+			 * Queries may be sent while earlier ones are unanswered; the answers are matched to them in order.  A
+			 * display which refreshes a status line can so ask on every update, and draw with the last answer.  A
+			 * query which is not answered within 250ms is given up on, and a late answer is read as the key it
+			 * resembles (shifted F3).
+			 */
+			void requestPosition();
+
+			/*!
+			 * The cursor position which the terminal last reported, if it is still current.
+			 *
+			 * The position is forgotten when the console moves the cursor (except by `gotoXY`, which sets it), when
+			 * a frame is rendered, and when the terminal is resized.  A program which writes to the terminal in
+			 * other ways should call `invalidatePosition` after doing so.
+			 */
+			std::optional< CursorPosition > knownPosition();
+			void invalidatePosition();
 
 			void cursorUp( unsigned amt= 0 );
 			void cursorDown( unsigned amt= 0 );
@@ -150,6 +267,52 @@ namespace Alepha::Hydrogen  ::detail::  console_m
 			void cursorRight( unsigned amt= 0 );
 
 			void clearScreen(); // `console` library does direct cursor control, so this won't return the cursor to 1,1.
+
+			// Mouse reports arrive as `MouseEvent`s, for presses, releases, and motion while a button is held.
+			void enableMouseReports();
+			void disableMouseReports();
+
+			// A bracketed paste arrives as one `PasteEvent`, rather than as keystrokes.
+			void enableBracketedPaste();
+			void disableBracketedPaste();
+
+			/*!
+			 * Wait for input, and decode all of it which has arrived.
+			 *
+			 * This sleeps in `poll` until the input is readable, or until `timeout` passes (a negative timeout
+			 * waits forever).  Then every byte which is available is read and decoded, so a burst of input (a
+			 * paste, say, or keys pressed while the caller was busy) is delivered as one batch.  A lone ESC is
+			 * held briefly, to tell the escape key from the start of a sequence.
+			 *
+			 * The console should be in raw mode (see `setRaw`), or the terminal will hold input back until enter
+			 * is pressed.  A program with its own event loop can watch `inputFd()` for readability, and call this
+			 * with a zero timeout when it is.
+			 *
+			 * Answers to `requestPosition` are taken from the input here, and are not returned as events.
+			 *
+			 * @return The events decoded, which are empty if the time ran out, a signal interrupted the wait, only
+			 * a position report arrived, or the input is closed.
+			 * @throws std::system_error if the input cannot be read.
+			 */
+			std::vector< InputEvent > readInput( std::chrono::milliseconds timeout= std::chrono::milliseconds{ -1 } );
+
+			// True once the end of the input has been read.
+			bool inputClosed() const noexcept;
+
+			int inputFd() const noexcept;
+
+			/*!
+			 * Draw a frame, with a single `write`.
+			 *
+			 * Only the cells which differ from the last frame rendered are sent.  The first frame, or one of a new
+			 * size, clears the screen and is drawn in full.  Rendering leaves the cursor after the last cell it
+			 * drew, and the text style at the terminal's default.
+			 */
+			void render( const Frame &frame );
+
+			// Forget the last frame rendered, so that the next is drawn in full.  (Use this after the screen has
+			// been written to in other ways.)
+			void invalidateFrame();
 	};
 
 	namespace exports
@@ -0,0 +1,278 @@
+static_assert( __cplusplus > 2020'00 );
+
+#include "../Console.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <csignal>
+
+#include <chrono>
+#include <initializer_list>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <Alepha/Testing/test.h>
+#include <Alepha/Utility/evaluation_helpers.h>
+
+namespace
+{
+	using namespace Alepha::Testing::literals::test_literals;
+	using Alepha::Testing::exports::TestState;
+
+	// A console which writes to memory, and reports what each render sent.
+	struct Recorder
+	{
+		int fd= ::memfd_create( "console", 0 );
+		Alepha::Console console{ fd };
+		off_t offset= 0;
+
+		std::string
+		render( TestState test, const Alepha::Frame &frame )
+		{
+			console.render( frame );
+			std::string rv( ::lseek( fd, 0, SEEK_CUR ) - offset, '\0' );
+			const ::ssize_t read= ::pread( fd, rv.data(), rv.size(), offset );
+			test.demand( read == ::ssize_t( rv.size() ) );
+			offset+= rv.size();
+			return rv;
+		}
+	};
+
+	struct Pipe
+	{
+		int fds[ 2 ];
+		int pipeResult= ::pipe( fds );
+
+		int in() const { return fds[ 0 ]; }
+		int out() const { return fds[ 1 ]; }
+	};
+
+	void
+	send( TestState test, const int fd, const std::string_view text )
+	{
+		const ::ssize_t written= ::write( fd, text.data(), text.size() );
+		test.demand( written == ::ssize_t( text.size() ) );
+	}
+
+	std::vector< Alepha::InputEvent >
+	events( const std::initializer_list< Alepha::InputEvent > list )
+	{
+		return list;
+	}
+}
+
+static auto init= Alepha::Utility::enroll <=[]
+{
+	"A style writes its escape sequence, whether made by `createStyle` or by name."_test <=[]( TestState test )
+	{
+		const auto style= Alepha::createStyle( "console-test", Alepha::setBold() );
+
+		std::ostringstream oss;
+		oss << style << 'x' << Alepha::Style{ "console-test" } << Alepha::resetStyle << Alepha::Style{ "console-test-unknown" };
+		test.expect( oss.str() == "\e[1mx\e[1m\e[0m" );
+	};
+
+	"The first frame clears the screen and draws everything."_test <=[]( TestState test )
+	{
+		Recorder recorder;
+		Alepha::Frame frame{ { 3, 10 } };
+		frame.put( 1, 1, "Hi" );
+		frame.put( 3, 2, "there" );
+
+		test.expect( recorder.render( test, frame ) == "\e[0m\e[H\e[2JHi\e[2;3Hthere" );
+	};
+
+	"An unchanged frame sends nothing."_test <=[]( TestState test )
+	{
+		Recorder recorder;
+		Alepha::Frame frame{ { 3, 10 } };
+		frame.put( 1, 1, "Hi" );
+
+		std::ignore= recorder.render( test, frame );
+		test.expect( recorder.render( test, frame ) == "" );
+	};
+
+	"Only changed cells are sent, with short cursor moves."_test <=[]( TestState test )
+	{
+		Recorder recorder;
+		Alepha::Frame frame{ { 3, 10 } };
+		frame.put( 1, 1, "abcdefgh" );
+		frame.put( 1, 2, "x" );
+		std::ignore= recorder.render( test, frame );
+
+		frame.put( 2, 1, "B" );
+		frame.put( 6, 1, "F" );
+		frame.put( 1, 2, "y" );
+		test.expect( recorder.render( test, frame ) == "\e[1;2HB\e[3CF\r\ny" );
+
+		frame.put( 10, 1, "z" );
+		frame.put( 1, 2, "w" );
+		test.expect( recorder.render( test, frame ) == "\e[1;10Hz\r\nw" );
+	};
+
+	"Styles are only sent when they change, and are reset at the end."_test <=[]( TestState test )
+	{
+		Recorder recorder;
+		Alepha::Frame frame{ { 2, 10 } };
+		std::ignore= recorder.render( test, frame );
+
+		frame.put( 1, 1, "ab", Alepha::setBold() );
+		frame.put( 3, 1, "c" );
+		test.expect( recorder.render( test, frame ) == "\e[1H\e[0;1mab\e[0mc" );
+
+		// A new frame numbers its styles differently, but the same style is still the same.
+		Alepha::Frame next{ { 2, 10 } };
+		next.put( 1, 1, "c", Alepha::setFaint() );
+		next.put( 1, 1, "ab", Alepha::setBold() );
+		next.put( 3, 1, "c" );
+		test.expect( recorder.render( test, next ) == "" );
+	};
+
+	"Wide characters take two cells."_test <=[]( TestState test )
+	{
+		Recorder recorder;
+		Alepha::Frame frame{ { 1, 6 } };
+		std::ignore= recorder.render( test, frame );
+
+		test.expect( frame.put( 1, 1, "\xE6\x97\xA5x" ) == 4 );
+		test.expect( frame.at( 2, 1 ).glyph == 0 );
+		test.expect( recorder.render( test, frame ) == "\e[1H\xE6\x97\xA5x" );
+
+		// Overwriting half of a wide character blanks the other half.
+		frame.put( 2, 1, "y" );
+		test.expect( frame.at( 1, 1 ).glyph == U' ' );
+		test.expect( recorder.render( test, frame ) == "\e[1H y" );
+	};
+
+	"Text is clipped at the right edge."_test <=[]( TestState test )
+	{
+		Alepha::Frame frame{ { 1, 4 } };
+		test.expect( frame.put( 3, 1, "abc" ) == 5 );
+		test.expect( frame.at( 4, 1 ).glyph == U'b' );
+
+		// A wide character which would straddle the edge is left out.
+		frame.clear();
+		test.expect( frame.put( 4, 1, "\xE6\x97\xA5" ) == 4 );
+		test.expect( frame.at( 4, 1 ).glyph == U' ' );
+	};
+
+	"A frame of a new size is drawn in full."_test <=[]( TestState test )
+	{
+		Recorder recorder;
+		Alepha::Frame frame{ { 1, 4 } };
+		frame.put( 1, 1, "ab" );
+		std::ignore= recorder.render( test, frame );
+
+		Alepha::Frame larger{ { 2, 4 } };
+		larger.put( 1, 1, "ab" );
+		test.expect( recorder.render( test, larger ) == "\e[0m\e[H\e[2Jab" );
+	};
+
+	"Input is read and decoded in batches, and a lone ESC is held only briefly."_test <=[]( TestState test )
+	{
+		Pipe pipe;
+		test.demand( pipe.pipeResult == 0 );
+		Alepha::Console console{ ::memfd_create( "console", 0 ), pipe.in() };
+
+		test.expect( console.readInput( std::chrono::milliseconds{ 0 } ).empty() );
+
+		send( test, pipe.out(), "ab\e[A\e" );
+		test.expect( console.readInput( std::chrono::milliseconds{ 0 } ) == events(
+		{
+			Alepha::KeyEvent{ Alepha::Key::character, U'a' },
+			Alepha::KeyEvent{ Alepha::Key::character, U'b' },
+			Alepha::KeyEvent{ Alepha::Key::up },
+			Alepha::KeyEvent{ Alepha::Key::escape },
+		} ) );
+
+		::close( pipe.out() );
+		test.expect( console.readInput().empty() );
+		test.expect( console.inputClosed() );
+	};
+
+	"Cursor position queries are answered from the input, in order, without blocking."_test <=[]( TestState test )
+	{
+		Pipe pipe;
+		test.demand( pipe.pipeResult == 0 );
+		const int output= ::memfd_create( "console", 0 );
+		Alepha::Console console{ output, pipe.in() };
+
+		console.requestPosition();
+		console.requestPosition();
+		test.expect( not console.knownPosition() );
+
+		std::string sent( 8, '\0' );
+		const ::ssize_t read= ::pread( output, sent.data(), sent.size(), 0 );
+		test.expect( read == 8 );
+		test.expect( sent == "\e[6n\e[6n" );
+
+		// Keys are still keys, and an answer is not mistaken for one.
+		send( test, pipe.out(), "\e[3;4Rx\e[1;2R" );
+		test.expect( console.readInput( std::chrono::milliseconds{ 0 } ) == events( { Alepha::KeyEvent{ Alepha::Key::character, U'x' } } ) );
+		test.expect( console.knownPosition() == Alepha::CursorPosition{ 2, 1 } );
+		test.expect( console.getXY().x == 2 );
+
+		// With nothing left to answer, this is F3.
+		send( test, pipe.out(), "\e[1;2R" );
+		test.expect( console.readInput( std::chrono::milliseconds{ 0 } ) == events( { Alepha::KeyEvent{ Alepha::Key::f3, 0, Alepha::shift } } ) );
+
+		// Moving the cursor forgets the position, and input read while waiting for a new one is kept.
+		console.cursorDown( 1 );
+		test.expect( not console.knownPosition() );
+		send( test, pipe.out(), "y\e[9;8R" );
+		test.expect( console.getXY() == Alepha::CursorPosition{ 8, 9 } );
+		test.expect( console.readInput( std::chrono::milliseconds{ 0 } ) == events( { Alepha::KeyEvent{ Alepha::Key::character, U'y' } } ) );
+
+		console.gotoXY( 5, 6 );
+		test.expect( console.getXY() == Alepha::CursorPosition{ 5, 6 } );
+
+		// A resize forgets it too.
+		::raise( SIGWINCH );
+		test.expect( not console.knownPosition() );
+
+		::close( pipe.out() );
+	};
+
+	"A terminal which does not answer is not waited for forever, nor is its answer awaited afterwards."_test <=[]( TestState test )
+	{
+		Pipe pipe;
+		test.demand( pipe.pipeResult == 0 );
+		Alepha::Console console{ ::memfd_create( "console", 0 ), pipe.in() };
+
+		console.requestPosition();
+		bool thrown= false;
+		try { std::ignore= console.getXY(); }
+		catch( const std::runtime_error & ) { thrown= true; }
+		test.expect( thrown );
+
+		// An answer which comes too late, or shifted F3, is a key.
+		send( test, pipe.out(), "\e[1;2R" );
+		test.expect( console.readInput( std::chrono::milliseconds{ 0 } ) == events( { Alepha::KeyEvent{ Alepha::Key::f3, 0, Alepha::shift } } ) );
+		test.expect( not console.knownPosition() );
+
+		::close( pipe.out() );
+	};
+
+	"Queries which are never answered stop being expected, without `getXY`."_test <=[]( TestState test )
+	{
+		Pipe pipe;
+		test.demand( pipe.pipeResult == 0 );
+		Alepha::Console console{ ::memfd_create( "console", 0 ), pipe.in() };
+
+		// A status line asking on every update, of a terminal which never answers.
+		for( int i= 0; i < 3; ++i ) console.requestPosition();
+		std::this_thread::sleep_for( std::chrono::milliseconds{ 300 } );
+
+		send( test, pipe.out(), "\e[1;2R\e[1;2R" );
+		const Alepha::InputEvent f3= Alepha::KeyEvent{ Alepha::Key::f3, 0, Alepha::shift };
+		test.expect( console.readInput( std::chrono::milliseconds{ 0 } ) == events( { f3, f3 } ) );
+		test.expect( not console.knownPosition() );
+
+		::close( pipe.out() );
+	};
+};
@@ -11,7 +11,7 @@ static_assert( __cplusplus > 2020'00 );
 
 #include <Alepha/Alepha.h>
 
-namespace Alepha::Cavorite  ::detail::  constexpr_string
+namespace Alepha::inline Cavorite  ::detail::  constexpr_string
 {
 	namespace C
 	{
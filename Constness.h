@@ -0,0 +1,53 @@
+static_assert( __cplusplus > 2020'00 );
+
+#pragma once
+
+#include <Alepha/Alepha.h>
+
+#include <type_traits>
+
+namespace Alepha::inline Cavorite  ::detail::  constness
+{
+	inline namespace exports
+	{
+		/*!
+		 * The access level of a view into memory which it does not own.
+		 *
+		 * `Buffer< Const >` is to `Buffer< Mutable >` as `const void *` is to `void *`.
+		 */
+		enum Constness : bool
+		{
+			Mutable= false,
+			Const= true,
+		};
+	}
+
+	template< typename T, Constness constness >
+	struct maybe_const_s
+	{
+		using type= std::conditional_t< constness, std::add_const_t< T >, T >;
+	};
+
+	// A reference is made const by making what it refers to const.
+	template< typename T, Constness constness >
+	struct maybe_const_s< T &, constness >
+	{
+		using type= typename maybe_const_s< T, constness >::type &;
+	};
+
+	namespace exports
+	{
+		// `T`, or `const T` when `constness` is `Const`.
+		template< typename T, Constness constness >
+		using maybe_const_t= typename maybe_const_s< T, constness >::type;
+
+		// A pointer to `T`, or to `const T` when `constness` is `Const`.
+		template< typename T, Constness constness >
+		using maybe_const_ptr_t= maybe_const_t< T, constness > *;
+	}
+}
+
+namespace Alepha::Cavorite::inline exports::inline constness
+{
+	using namespace detail::constness::exports;
+}
@@ -2,15 +2,30 @@ static_assert( __cplusplus > 2020'00 );
 
 #pragma once
 
+#include <Alepha/Alepha.h>
+
 #include <deque>
 #include <utility>
 #include <algorithm>
+#include <array>
 #include <iterator>
 #include <numeric>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <system_error>
+
+#include <cerrno>
+#include <climits>
+
+#include <sys/uio.h>
 
-#include "comparisons.h"
-#include "Buffer.h"
-#include "Blob.h"
+#include <Alepha/Blob.h>
+#include <Alepha/Buffer.h>
+
+#include <Alepha/Utility/evaluation_helpers.h>
 
 namespace Alepha::inline Cavorite  ::detail::  data_chain
 {
@@ -19,16 +34,55 @@ namespace Alepha::inline Cavorite  ::detail::  data_chain
 		class DataChain;
 	}
 
+	namespace C
+	{
+		// The kernel will not accept more than this many segments in one vectored I/O call.
+		const std::size_t maxIovecs= IOV_MAX;
+
+		// How many segment copies a peek gathers on the stack before handing them to `copyData`.
+		const std::size_t copyBatch= 16;
+	}
+
 	using std::begin, std::end;
 
+	using namespace Utility::exports::evaluation_helpers;
+
 	class exports::DataChain
 	{
 		private:
 			using Chain= std::deque< Blob >;
 			Chain chain;
 
+			// The running total of bytes in `chain`.  It becomes stale when the chain is handed out for direct
+			// modification, and is then recomputed by the next `size()` call.
+			mutable std::size_t bytes= 0;
+			mutable bool staleSize= false;
+
+			// Gathers the copies of a peek into fixed size batches, so that peeking allocates nothing.
+			class CopyBatch
+			{
+				private:
+					std::array< CopyRequest, C::copyBatch > requests;
+					std::size_t count= 0;
+
+				public:
+					void
+					add( const Buffer< Mutable > destination, const Buffer< Const > source )
+					{
+						requests[ count++ ]= { destination, source };
+						if( count == requests.size() ) flush();
+					}
+
+					void
+					flush()
+					{
+						copyData( std::span{ requests.data(), count } );
+						count= 0;
+					}
+			};
+
 			template< Constness constness >
-			class Iterator : comparable
+			class Iterator
 			{
 				public:
 					using iterator_category= std::forward_iterator_tag;
@@ -39,7 +93,7 @@ namespace Alepha::inline Cavorite  ::detail::  data_chain
 
 				private:
 					using ChainIter= decltype( std::declval< maybe_const_t< Chain, constness > >().begin() );
-					ChainIter position;
+					ChainIter pos;
 					std::size_t offset;
 
 					void
@@ -52,17 +106,34 @@ namespace Alepha::inline Cavorite  ::detail::  data_chain
 
 					friend DataChain;
 
-					explicit Iterator( const ChainIter pos, cosnt std::size_t offset ) noexcept : pos( pos ), offset( offset ) {}
+					explicit Iterator( const ChainIter pos, const std::size_t offset ) noexcept : pos( pos ), offset( offset ) {}
 
 				public:
-					auto
-					value_lens() const noexcept( noexcept( std::tie( pos, offset ) ) )
-					{
-						return std::tie( pos, offset );
-					}
+					friend bool operator == ( const Iterator &, const Iterator & )= default;
 
 					Iterator &operator ++() noexcept { advance(); return *this; }
 
+					/*!
+					 * Advance this iterator by `amount` bytes.
+					 *
+					 * Whole segments are skipped at once, so this costs time proportional to the number of segment
+					 * boundaries crossed, rather than to `amount`.
+					 *
+					 * @note Advancing past the end of the chain is undefined.
+					 */
+					Iterator &
+					advance( std::size_t amount ) noexcept
+					{
+						while( amount and amount >= pos->size() - offset )
+						{
+							amount-= pos->size() - offset;
+							++pos;
+							offset= 0;
+						}
+						offset+= amount;
+						return *this;
+					}
+
 					Iterator
 					operator++ ( int )
 					noexcept
@@ -72,7 +143,7 @@ namespace Alepha::inline Cavorite  ::detail::  data_chain
 						noexcept( advance() )
 					)
 					{
-						Iterator rv{ *this; }
+						Iterator rv{ *this };
 						advance();
 						return rv;
 					}
@@ -82,90 +153,433 @@ namespace Alepha::inline Cavorite  ::detail::  data_chain
 					{
 						return pos->byte_data()[ offset ];
 					}
+			};
 
-				public:
-					template< typename T > void operator []( T ) const= delete;
-					template< typename T > void operator []( T )= delete;
+		public:
+			template< typename T > void operator []( T ) const= delete;
+			template< typename T > void operator []( T )= delete;
 
-					using iterator= Iterator< Mutable >;
-					using const_iterator= Iterator< Const >;
+			using iterator= Iterator< Mutable >;
+			using const_iterator= Iterator< Const >;
 
-					auto begin() noexcept { using std::begin; return iterator{ begin( chain ), 0 }; }
-					auto end() noexcept { using std::end; return iterator{ end( chain ), 0 }; }
+			auto begin() noexcept { using std::begin; return iterator{ begin( chain ), 0 }; }
+			auto end() noexcept { using std::end; return iterator{ end( chain ), 0 }; }
 
-					auto begin() const noexcept { using std::begin; return const_iterator{ begin( chain ), 0 }; }
-					auto end() const noexcept { using std::end; return const_iterator{ end( chain ), 0 }; }
+			auto begin() const noexcept { using std::begin; return const_iterator{ begin( chain ), 0 }; }
+			auto end() const noexcept { using std::end; return const_iterator{ end( chain ), 0 }; }
 
-					auto cbegin() const noexcept { return begin(); }
-					auto cend() const noexcept { return end(); }
+			auto cbegin() const noexcept { return begin(); }
+			auto cend() const noexcept { return end(); }
 
-					// Please note that this non-const view form provides direct access to the chain.
-					// This class doesn't store any additional state, so modification of this chain is
-					// likely safe, for now.  But in the future, this could change.  Manual modification
-					// of this chain is strongly discouraged.
-					Chain &chain_view() noexcept { return chain; }
-					const Chain &chain_view() const noexcept { return chain; }
+			// Please note that this non-const view form provides direct access to the chain.
+			// This class caches the total size of the chain, so taking this view marks that
+			// cache stale, and the next `size()` call will walk the chain again.  Manual
+			// modification of this chain is strongly discouraged.
+			Chain &chain_view() noexcept { staleSize= true; return chain; }
+			const Chain &chain_view() const noexcept { return chain; }
 
-					std::size_t
-					size() const
-					{
-						using std::begin, std::end;
-						return std::accumulate( begin( chain_view() ), end( chain_view() ), std::size_t{},
-								[] ( const std::size_t lhs, const auto &rhs ) { return lhs + rhs.size(); } );
-					}
+			std::size_t
+			size() const
+			{
+				if( not staleSize ) return bytes;
+
+				using std::begin, std::end;
+				bytes= std::accumulate( begin( chain ), end( chain ), std::size_t{},
+						[] ( const std::size_t lhs, const auto &rhs ) { return lhs + rhs.size(); } );
+				staleSize= false;
+				return bytes;
+			}
+
+			/*!
+			 * Map an entire file into memory, as a chain of windows.
+			 *
+			 * The file is mapped once (see `Blob::mapFile`), and that mapping is carved into segments of
+			 * `chunkSize` bytes (the last may be shorter).  Every segment shares the one mapping, so segments (and
+			 * anything carved from them) can be split and recombined without copying.
+			 *
+			 * @param path The file to map.
+			 * @param chunkSize The size of each window in the chain.
+			 * @param pattern The expected access pattern, passed on to the kernel as a read-ahead hint.
+			 *
+			 * @throws std::system_error if the file cannot be opened or mapped.
+			 */
+			static DataChain
+			fromFile( const std::string &path, const std::size_t chunkSize,
+					const AccessPattern pattern= AccessPattern::sequential )
+			{
+				if( chunkSize == 0 ) throw std::invalid_argument( "`DataChain::fromFile` requires a non-zero chunk size." );
 
-					std::size_t chain_length() const noexcept { return chain.size(); }
-					std::size_t chain_empty() const noexcept { return chain.empty(); }
+				Blob mapping= Blob::mapFile( path, pattern );
 
-					void clear() noexcept { chain.clear(); }
+				// The windows are pushed directly, because `append` would re-stitch the contiguous pieces.
+				DataChain rv;
+				rv.bytes= mapping.size();
+				while( mapping.size() > chunkSize ) rv.chain.push_back( mapping.carveHead( chunkSize ) );
+				if( mapping.size() ) rv.chain.push_back( std::move( mapping ) );
 
-					void
-					append( Blob &block )
-					{
-						// Base case is fast:
-						if( chain.empty() ) return chain.push_back( std::move( block ) );
+				return rv;
+			}
 
-						// If we're getting a `Blob` which is contiguous we try to re-stitch them:
-						if( const auto contiguous= chain.back().isContiguousWith( std::move( block ) ) ) contiguous.compose();
-						// As a fallback, we just have to put it at the back of our list:
-						else chain.push_back( std::move( block ) );
-					}
+			std::size_t chain_length() const noexcept { return chain.size(); }
+			std::size_t chain_empty() const noexcept { return chain.empty(); }
 
-					void append( const Buffer< Const > &buffer ) { if( buffer.size() ) chain.emplace_back( buffer ); }
+			void clear() noexcept { chain.clear(); bytes= 0; staleSize= false; }
 
-					Blob
-					peekHead( const std::size_t amount )
-					{
-						if( amount == 0 ) return Blob{};
-						if( chain.empty() or size() < amount )
-						{
-							// TODO: Build a more specific exception for this case?
-							throw DataCarveToLargeError( nullptr, amount, size() );
-						}
+			void
+			append( Blob &block )
+			{
+				// An empty segment would only cost an `iovec` on every write.
+				if( block.size() == 0 ) return;
+
+				bytes+= block.size();
+
+				// Base case is fast:
+				if( chain.empty() ) return chain.push_back( std::move( block ) );
+
+				// If we're getting a `Blob` which is contiguous we try to re-stitch them:
+				if( const auto contiguous= chain.back().isContiguousWith( std::move( block ) ) ) contiguous.compose();
+				// As a fallback, we just have to put it at the back of our list:
+				else chain.push_back( std::move( block ) );
+			}
+
+			void
+			append( const Buffer< Const > &buffer )
+			{
+				if( not buffer.size() ) return;
+				chain.emplace_back( buffer );
+				bytes+= buffer.size();
+			}
+
+			/*!
+			 * Copy data from the head of this chain, without consuming it.
+			 *
+			 * Data are copied a whole segment at a time, in batches (see `copyData`).
+			 *
+			 * @param destination The buffer to fill.  Exactly `destination.size()` bytes are copied.
+			 * @return The part of `destination` which was filled.
+			 *
+			 * @throws DataCarveTooLargeError if the chain holds fewer bytes than `destination`.
+			 */
+			Buffer< Mutable >
+			copyOut( const Buffer< Mutable > destination ) const
+			{
+				if( size() < destination.size() ) throw DataCarveTooLargeError( nullptr, destination.size(), size() );
+
+				CopyBatch batch;
+				Buffer< Mutable > remaining= destination;
+				for( auto segment= chain.begin(); not remaining.empty(); ++segment )
+				{
+					const auto amount= std::min( remaining.size(), segment->size() );
+					batch.add( remaining, Buffer< Const >{ segment->data(), amount } );
+					remaining+= amount;
+				}
+				batch.flush();
+
+				return destination;
+			}
+
+			Blob
+			peekHead( const std::size_t amount ) const
+			{
+				if( amount == 0 ) return Blob{};
+				if( size() < amount )
+				{
+					// TODO: Build a more specific exception for this case?
+					throw DataCarveTooLargeError( nullptr, amount, size() );
+				}
+
+				Blob rv{ amount, uninitialized };
+				std::ignore= copyOut( rv );
 
-						// TODO: This should be in a common helper with part of `carveHead`'s internals:
-						Blob rv{ amount };
-						std::copy_n( begin(), amount, rv.byte_data() );
+				return rv;
+			}
 
+			Blob
+			peekTail( const std::size_t amount ) const
+			{
+				if( amount == 0 ) return Blob{};
+				if( size() < amount )
+				{
+					// TODO: Build a more specific exception for this case?
+					throw DataCarveTooLargeError( nullptr, amount, size() );
+				}
+
+				// Fill the result from its end, walking backwards through the chain a segment at a time.
+				Blob rv{ amount, uninitialized };
+				CopyBatch batch;
+				std::size_t remaining= amount;
+				for( auto segment= chain.rbegin(); remaining; ++segment )
+				{
+					const auto taken= std::min( remaining, segment->size() );
+					remaining-= taken;
+					batch.add( rv + remaining, Buffer< Const >{ *segment } + ( segment->size() - taken ) );
+				}
+				batch.flush();
+
+				return rv;
+			}
+
+			/*!
+			 * Remove the specified number of bytes from the head of this chain, as a single `Blob` object.
+			 *
+			 * When the range lies within the first segment, the result is carved from that segment, sharing
+			 * its arena, and no data are copied.  Only a range which spans segments is coalesced (copied) into a
+			 * fresh `Blob`.  Use `carveHeadChain` to avoid that copy entirely.
+			 *
+			 * @param amount The number of bytes to carve off.
+			 * @return A `Blob` object holding the first `amount` bytes of this chain.
+			 *
+			 * @throws DataCarveTooLargeError if the chain holds fewer than `amount` bytes.
+			 */
+			Blob
+			carveHead( const std::size_t amount )
+			{
+				if( amount == 0 ) return Blob{};
+				if( size() < amount ) throw DataCarveTooLargeError( nullptr, amount, size() );
+
+				if( chain.front().size() >= amount )
+				{
+					bytes-= amount;
+					if( chain.front().size() > amount ) return chain.front().carveHead( amount );
+
+					Blob rv= std::move( chain.front() );
+					chain.pop_front();
+					return rv;
+				}
+
+				Blob rv= peekHead( amount );
+				discardHead( amount );
+				return rv;
+			}
+
+			/*!
+			 * Remove the specified number of bytes from the tail of this chain, as a single `Blob` object.
+			 *
+			 * @see `DataChain::carveHead`
+			 *
+			 * @param amount The number of bytes to carve off.
+			 * @return A `Blob` object holding the last `amount` bytes of this chain.
+			 *
+			 * @throws DataCarveTooLargeError if the chain holds fewer than `amount` bytes.
+			 */
+			Blob
+			carveTail( const std::size_t amount )
+			{
+				if( amount == 0 ) return Blob{};
+				if( size() < amount ) throw DataCarveTooLargeError( nullptr, amount, size() );
+
+				if( chain.back().size() >= amount )
+				{
+					bytes-= amount;
+					if( chain.back().size() > amount ) return chain.back().carveTail( amount );
+
+					Blob rv= std::move( chain.back() );
+					chain.pop_back();
+					return rv;
+				}
+
+				Blob rv= peekTail( amount );
+				discardTail( amount );
+				return rv;
+			}
+
+			/*!
+			 * Remove the specified number of bytes from the head of this chain, as a new `DataChain`.
+			 *
+			 * No data are copied, even when the range spans segments.  Whole segments are moved into the
+			 * result, and the segment at the boundary (if any) is carved.
+			 *
+			 * @param amount The number of bytes to carve off.
+			 * @return A `DataChain` holding the first `amount` bytes of this chain.
+			 *
+			 * @throws DataCarveTooLargeError if the chain holds fewer than `amount` bytes.
+			 */
+			DataChain
+			carveHeadChain( std::size_t amount )
+			{
+				if( size() < amount ) throw DataCarveTooLargeError( nullptr, amount, size() );
+
+				DataChain rv;
+				while( amount )
+				{
+					Blob segment= chain.front().size() > amount ? chain.front().carveHead( amount ) : evaluate <=[&]
+					{
+						Blob rv= std::move( chain.front() );
+						chain.pop_front();
+						return rv;
+					};
+					amount-= segment.size();
+					bytes-= segment.size();
+					rv.append( segment );
+				}
+
+				return rv;
+			}
+
+			/*!
+			 * Remove the specified number of bytes from the tail of this chain, as a new `DataChain`.
+			 *
+			 * @see `DataChain::carveHeadChain`
+			 *
+			 * @param amount The number of bytes to carve off.
+			 * @return A `DataChain` holding the last `amount` bytes of this chain.
+			 *
+			 * @throws DataCarveTooLargeError if the chain holds fewer than `amount` bytes.
+			 */
+			DataChain
+			carveTailChain( std::size_t amount )
+			{
+				if( size() < amount ) throw DataCarveTooLargeError( nullptr, amount, size() );
+
+				// Segments are peeled from the back, so they are collected in reverse before being chained.
+				std::vector< Blob > segments;
+				while( amount )
+				{
+					Blob segment= chain.back().size() > amount ? chain.back().carveTail( amount ) : evaluate <=[&]
+					{
+						Blob rv= std::move( chain.back() );
+						chain.pop_back();
 						return rv;
+					};
+					amount-= segment.size();
+					bytes-= segment.size();
+					segments.push_back( std::move( segment ) );
+				}
+
+				DataChain rv;
+				std::for_each( segments.rbegin(), segments.rend(), [&rv]( Blob &segment ) { rv.append( segment ); } );
+				return rv;
+			}
+
+			/*!
+			 * Write as much of this chain as possible to a file descriptor, consuming what was written.
+			 *
+			 * The segments of the chain are handed to the kernel directly, as an `iovec` array, so a chain of
+			 * fragmented frames is flushed with a single `writev` call (or a few, for very long chains).
+			 * Bytes which were written are carved off the head of the chain.  A partial write leaves the
+			 * unwritten remainder at the head, for a later call.
+			 *
+			 * @param fd The file descriptor to write to.
+			 * @return The number of bytes written.  This is less than the size of the chain only when a
+			 * non-blocking `fd` would have blocked.
+			 *
+			 * @throws std::system_error if the write fails for any other reason.
+			 */
+			std::size_t
+			writeTo( const int fd )
+			{
+				std::size_t rv= 0;
+				std::vector< ::iovec > vector;
+				while( true )
+				{
+					// Empty segments are skipped: a vector of nothing but those would never make progress.
+					vector.clear();
+					for( auto segment= chain.begin(); segment != chain.end() and vector.size() < C::maxIovecs; ++segment )
+					{
+						if( segment->size() ) vector.push_back( { segment->data(), segment->size() } );
+					}
+					if( vector.empty() )
+					{
+						clear();
+						break;
 					}
 
-					Blob
-					peekTail( const std::size_t amount )
+					const ::ssize_t written= ::writev( fd, vector.data(), vector.size() );
+					if( written == -1 )
 					{
-						if( amount == 0 ) return Data{};
-						if( chain.empty() or size() < amount )
-						{
-							// TODO: Build a more specific exception for this case?
-							throw DataCarveToLargeError( nullptr, amount, size() );
-						}
-						
-						// TODO: This should be in a common helper with part of `carveTail`'s internals:
-						Blob rv{ amount };
-						std::copy_n( std::prev( end(), amount ), amount, rv.byte_data() );
+						if( errno == EINTR ) continue;
+						if( errno == EAGAIN or errno == EWOULDBLOCK ) break;
+						throw std::system_error{ errno, std::generic_category(), "`writev` failed while flushing a `DataChain`" };
+					}
+					if( written == 0 ) break;
+
+					rv+= written;
+					discardHead( written );
+				}
+
+				return rv;
+			}
+
+			/*!
+			 * Read from a file descriptor, appending what was read to the end of this chain.
+			 *
+			 * The unused capacity of the last segment (if any) is filled first, and then a fresh segment of
+			 * `hint` bytes, both in a single `readv` call.  The fresh segment is only appended if data
+			 * landed in it.
+			 *
+			 * @param fd The file descriptor to read from.
+			 * @param hint The size of the fresh segment to read into.
+			 * @return The number of bytes read (`0` at end of file), or `std::nullopt` when a non-blocking
+			 * `fd` had no data ready.
+			 *
+			 * @throws std::system_error if the read fails for any other reason.
+			 */
+			std::optional< std::size_t >
+			readFrom( const int fd, const std::size_t hint )
+			{
+				Blob fresh{ hint, uninitialized };
 
-						return rv;
-							
-			};
+				std::vector< ::iovec > vector;
+				const std::size_t slack= chain.empty() ? 0 : chain.back().capacity() - chain.back().size();
+				if( slack ) vector.push_back( { chain.back().byte_data() + chain.back().size(), slack } );
+				vector.push_back( { fresh.data(), fresh.size() } );
+
+				const ::ssize_t amount= evaluate <=[&]
+				{
+					while( true )
+					{
+						const ::ssize_t rv= ::readv( fd, vector.data(), vector.size() );
+						if( rv != -1 or errno != EINTR ) return rv;
+					}
+				};
+				if( amount == -1 )
+				{
+					if( errno == EAGAIN or errno == EWOULDBLOCK ) return std::nullopt;
+					throw std::system_error{ errno, std::generic_category(), "`readv` failed while filling a `DataChain`" };
+				}
+
+				const std::size_t intoSlack= std::min< std::size_t >( amount, slack );
+				if( intoSlack ) chain.back().setSize( chain.back().size() + intoSlack );
+				bytes+= amount;
+				if( const std::size_t intoFresh= amount - intoSlack )
+				{
+					fresh.setSize( intoFresh );
+					chain.push_back( std::move( fresh ) );
+				}
+
+				return amount;
+			}
+
+		private:
+			// Drop the specified number of bytes from the head of the chain.
+			void
+			discardHead( std::size_t amount )
+			{
+				bytes-= amount;
+				while( amount and amount >= chain.front().size() )
+				{
+					amount-= chain.front().size();
+					chain.pop_front();
+				}
+				if( amount ) std::ignore= chain.front().carveHead( amount );
+			}
+
+			// Drop the specified number of bytes from the tail of the chain.
+			void
+			discardTail( std::size_t amount )
+			{
+				bytes-= amount;
+				while( amount and amount >= chain.back().size() )
+				{
+					amount-= chain.back().size();
+					chain.pop_back();
+				}
+				if( amount ) std::ignore= chain.back().carveTail( amount );
+			}
 	};
 }
+
+namespace Alepha::Cavorite::inline exports::inline data_chain
+{
+	using namespace detail::data_chain::exports;
+}
@@ -0,0 +1,316 @@
+static_assert( __cplusplus > 2020'00 );
+
+#include <Alepha/DataChain.h>
+
+#include <cstdlib>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <Alepha/Testing/test.h>
+#include <Alepha/Utility/evaluation_helpers.h>
+
+namespace
+{
+	using Alepha::Blob;
+	using Alepha::DataChain;
+
+	DataChain
+	chainOf( const std::initializer_list< std::string_view > pieces )
+	{
+		DataChain rv;
+		for( const auto piece: pieces ) rv.append( Alepha::Buffer< Alepha::Const >{ piece.data(), piece.size() } );
+		return rv;
+	}
+
+	std::string
+	textOf( const DataChain &chain )
+	{
+		std::string rv;
+		for( const std::byte b: chain ) rv+= char( b );
+		return rv;
+	}
+
+	std::string_view
+	textOf( const Blob &blob )
+	{
+		return { static_cast< const char * >( blob.data() ), blob.size() };
+	}
+
+	// Read whatever is waiting in a pipe.
+	std::string
+	drain( const int fd )
+	{
+		std::string rv;
+		char buffer[ 4096 ];
+		for( ::ssize_t amount; ( amount= ::read( fd, buffer, sizeof( buffer ) ) ) > 0; ) rv.append( buffer, amount );
+		return rv;
+	}
+
+	struct Pipe
+	{
+		int fds[ 2 ]= { -1, -1 };
+		int pipeResult= ::pipe2( fds, O_NONBLOCK );
+
+		~Pipe() { ::close( fds[ 0 ] ); ::close( fds[ 1 ] ); }
+
+		int in() const noexcept { return fds[ 0 ]; }
+		int out() const noexcept { return fds[ 1 ]; }
+	};
+}
+
+static auto init= Alepha::Utility::enroll <=[]
+{
+	using namespace Alepha::Testing::exports::literals;
+	using Alepha::Testing::exports::TestState;
+
+	"Neighbouring carves are re-stitched as they are appended, and empty ones are dropped."_test <=[]( TestState test )
+	{
+		Blob blob{ Alepha::make_buffer( std::string{ "abcdef" } ) };
+		Blob first= blob.carveHead( 3 );
+		Blob empty;
+
+		DataChain chain;
+		chain.append( first );
+		chain.append( empty );
+		chain.append( blob );
+		test.expect( chain.chain_length() == 1 );
+		test.expect( chain.size() == 6 );
+		test.expect( textOf( chain ) == "abcdef" );
+	};
+
+	"A chain is written in one call, and consumed as it is written."_test <=[]( TestState test )
+	{
+		Pipe pipe;
+		test.demand( pipe.pipeResult == 0 );
+
+		DataChain chain= chainOf( { "one ", "two ", "three" } );
+		const std::size_t written= chain.writeTo( pipe.out() );
+		const std::string received= drain( pipe.in() );
+
+		test.expect( written == 13 );
+		test.expect( received == "one two three" );
+		test.expect( chain.size() == 0 and chain.chain_empty() );
+	};
+
+	"A chain of only empty segments writes nothing, and does not spin."_test <=[]( TestState test )
+	{
+		Pipe pipe;
+		test.demand( pipe.pipeResult == 0 );
+
+		DataChain chain;
+		chain.chain_view().emplace_back();
+		chain.chain_view().emplace_back();
+		const std::size_t written= chain.writeTo( pipe.out() );
+
+		test.expect( written == 0 );
+		test.expect( chain.chain_empty() );
+	};
+
+	"A write which would block leaves the remainder at the head of the chain."_test <=[]( TestState test )
+	{
+		Pipe pipe;
+		test.demand( pipe.pipeResult == 0 );
+
+		// More than a pipe holds, so the first write stops short.
+		const std::string big( 1 << 20, 'x' );
+		DataChain chain= chainOf( { "head", big, "tail" } );
+		const std::size_t total= chain.size();
+
+		std::string received;
+		std::size_t written= 0;
+		std::size_t calls= 0;
+		while( chain.size() and calls++ < 1000 )
+		{
+			written+= chain.writeTo( pipe.out() );
+			received+= drain( pipe.in() );
+		}
+
+		test.expect( calls > 1 );
+		test.expect( written == total );
+		test.expect( received == "head" + big + "tail" );
+	};
+
+	"Reads fill the slack of the last segment before starting another."_test <=[]( TestState test )
+	{
+		Pipe pipe;
+		test.demand( pipe.pipeResult == 0 );
+
+		DataChain chain;
+		const auto nothing= chain.readFrom( pipe.in(), 16 );
+
+		std::ignore= ::write( pipe.out(), "hello", 5 );
+		const auto first= chain.readFrom( pipe.in(), 16 );
+
+		std::ignore= ::write( pipe.out(), " world", 6 );
+		const auto second= chain.readFrom( pipe.in(), 16 );
+
+		std::ignore= ::write( pipe.out(), " and more", 9 );
+		const auto third= chain.readFrom( pipe.in(), 16 );
+
+		::close( pipe.fds[ 1 ] );
+		pipe.fds[ 1 ]= -1;
+		const auto end= chain.readFrom( pipe.in(), 16 );
+
+		test.expect( not nothing );
+		test.expect( first == 5 and second == 6 and third == 9 );
+		test.expect( end == 0 );
+		test.expect( chain.chain_length() == 2 );
+		test.expect( chain.size() == 20 );
+		test.expect( textOf( chain ) == "hello world and more" );
+	};
+
+	"The size is kept as the chain changes, and recounted after direct modification."_test <=[]( TestState test )
+	{
+		DataChain chain= chainOf( { "abc", "defg" } );
+		test.expect( chain.size() == 7 );
+
+		chain.append( Alepha::Buffer< Alepha::Const >{ "hi", 2 } );
+		test.expect( chain.size() == 9 );
+
+		std::ignore= chain.carveHead( 2 );
+		test.expect( chain.size() == 7 );
+
+		chain.chain_view().emplace_back( Alepha::make_buffer( std::string{ "jkl" } ) );
+		test.expect( chain.size() == 10 );
+
+		chain.clear();
+		test.expect( chain.size() == 0 );
+	};
+
+	"Copying out spans segments, without consuming them."_test <=[]( TestState test )
+	{
+		const DataChain chain= chainOf( { "ab", "cde", "fgh" } );
+
+		std::string out( 6, '.' );
+		const auto filled= chain.copyOut( Alepha::make_buffer( out ) );
+		test.expect( filled.size() == 6 );
+		test.expect( out == "abcdef" );
+		test.expect( textOf( chain ) == "abcdefgh" );
+
+		bool threw= false;
+		std::string tooLong( 9, '.' );
+		try
+		{
+			std::ignore= chain.copyOut( Alepha::make_buffer( tooLong ) );
+		}
+		catch( const Alepha::DataCarveTooLargeError & )
+		{
+			threw= true;
+		}
+		test.expect( threw );
+		test.expect( tooLong == std::string( 9, '.' ) );
+	};
+
+	"Peeks copy from either end, across segments."_test <=[]( TestState test )
+	{
+		const DataChain chain= chainOf( { "ab", "cde", "fgh" } );
+
+		const Blob head= chain.peekHead( 4 );
+		const Blob tail= chain.peekTail( 5 );
+		const Blob all= chain.peekTail( 8 );
+
+		test.expect( textOf( head ) == "abcd" );
+		test.expect( textOf( tail ) == "defgh" );
+		test.expect( textOf( all ) == "abcdefgh" );
+		test.expect( chain.peekHead( 0 ).size() == 0 );
+		test.expect( chain.size() == 8 );
+	};
+
+	"Peeks across more segments than one batch of copies still copy every byte, in order."_test <=[]( TestState test )
+	{
+		DataChain chain;
+		std::string expected;
+		for( char c= 'a'; c <= 'z'; ++c )
+		{
+			const std::string piece( 3, c );
+			chain.append( Alepha::Buffer< Alepha::Const >{ piece.data(), piece.size() } );
+			expected+= piece;
+		}
+
+		std::string out( expected.size() - 1, '.' );
+		std::ignore= chain.copyOut( Alepha::make_buffer( out ) );
+		test.expect( out == expected.substr( 0, expected.size() - 1 ) );
+		test.expect( textOf( chain.peekHead( 70 ) ) == expected.substr( 0, 70 ) );
+		test.expect( textOf( chain.peekTail( 70 ) ) == expected.substr( expected.size() - 70 ) );
+	};
+
+	"Carving within a segment shares its arena; only a carve across segments copies."_test <=[]( TestState test )
+	{
+		DataChain chain= chainOf( { "abcd", "efgh", "ijkl" } );
+		const void *const first= chain.chain_view().front().data();
+		const void *const last= chain.chain_view().back().data();
+
+		const Blob head= chain.carveHead( 2 );
+		const Blob tail= chain.carveTail( 4 );
+		test.expect( head.data() == first );
+		test.expect( textOf( head ) == "ab" );
+		test.expect( tail.data() == last );
+		test.expect( textOf( tail ) == "ijkl" );
+
+		const Blob across= chain.carveHead( 4 );
+		test.expect( textOf( across ) == "cdef" );
+		test.expect( textOf( chain ) == "gh" );
+		test.expect( chain.size() == 2 );
+
+		bool threw= false;
+		try
+		{
+			std::ignore= chain.carveTail( 3 );
+		}
+		catch( const Alepha::DataCarveTooLargeError & )
+		{
+			threw= true;
+		}
+		test.expect( threw );
+		test.expect( textOf( chain ) == "gh" );
+	};
+
+	"Carving a chain off either end moves segments, and copies nothing."_test <=[]( TestState test )
+	{
+		DataChain chain= chainOf( { "abcd", "efgh", "ijkl" } );
+		const void *const middle= chain.chain_view()[ 1 ].data();
+
+		DataChain head= chain.carveHeadChain( 6 );
+		DataChain tail= chain.carveTailChain( 3 );
+
+		test.expect( textOf( head ) == "abcdef" );
+		test.expect( head.chain_length() == 2 );
+		test.expect( head.chain_view().back().data() == middle );
+		test.expect( textOf( tail ) == "jkl" );
+		test.expect( textOf( chain ) == "ghi" );
+		test.expect( head.size() + tail.size() + chain.size() == 12 );
+	};
+
+	"A file maps as a chain of windows onto one mapping."_test <=[]( TestState test )
+	{
+		std::string path= "/tmp/DataChain.test.XXXXXX";
+		const std::string contents( 10000, 'z' );
+		const int fd= ::mkstemp( path.data() );
+		std::ignore= ::write( fd, contents.data(), contents.size() );
+		::close( fd );
+
+		const DataChain chain= DataChain::fromFile( path, 4096 );
+		::unlink( path.c_str() );
+
+		test.expect( chain.chain_length() == 3 );
+		test.expect( chain.size() == contents.size() );
+		test.expect( textOf( chain ) == contents );
+		test.expect( chain.chain_view()[ 0 ].isContiguousWith( chain.chain_view()[ 1 ] ) );
+
+		bool threw= false;
+		try
+		{
+			std::ignore= DataChain::fromFile( "/dev/null", 0 );
+		}
+		catch( const std::invalid_argument & )
+		{
+			threw= true;
+		}
+		test.expect( threw );
+	};
+};
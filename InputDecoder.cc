@@ -0,0 +1,382 @@
+static_assert( __cplusplus > 2020'00 );
+
+#include "InputDecoder.h"
+
+#include <algorithm>
+#include <array>
+#include <optional>
+
+namespace Alepha::Hydrogen  ::detail::  input_decoder_m
+{
+	namespace
+	{
+		namespace C
+		{
+			// No sequence a terminal sends is longer than this; a longer one is garbage, and is dropped, up to its final
+			// byte.
+			const std::size_t maxSequenceLength= 32;
+
+			const std::size_t maxParameters= 4;
+
+			const std::string_view pasteTerminator= "\e[201~";
+		}
+
+		// The numeric parameters of a CSI sequence.  Missing parameters are 0.
+		std::array< int, C::maxParameters >
+		parameters( const std::string_view sequence ) noexcept
+		{
+			std::array< int, C::maxParameters > rv{};
+			std::size_t index= 0;
+			for( const char ch: sequence )
+			{
+				if( ch == ';' )
+				{
+					if( ++index == rv.size() ) break;
+				}
+				else if( ch >= '0' and ch <= '9' and rv[ index ] < 100'000 ) rv[ index ]= rv[ index ] * 10 + ( ch - '0' );
+			}
+			return rv;
+		}
+
+		// The modifiers in an xterm modifier parameter, which is one more than the bits it carries.
+		unsigned
+		modifiersOf( const int parameter ) noexcept
+		{
+			return parameter > 1 ? unsigned( parameter - 1 ) & ( shift | alt | control ) : 0;
+		}
+
+		// The keys which CSI and SS3 sequences share, by their final byte.
+		std::optional< Key >
+		letterKey( const char final ) noexcept
+		{
+			switch( final )
+			{
+				case 'A': return Key::up;
+				case 'B': return Key::down;
+				case 'C': return Key::right;
+				case 'D': return Key::left;
+				case 'H': return Key::home;
+				case 'F': return Key::end;
+				case 'P': return Key::f1;
+				case 'Q': return Key::f2;
+				case 'R': return Key::f3;
+				case 'S': return Key::f4;
+				default: return std::nullopt;
+			}
+		}
+
+		// The keys of `CSI n ~` sequences, by `n`.
+		std::optional< Key >
+		tildeKey( const int code ) noexcept
+		{
+			switch( code )
+			{
+				case 1: case 7: return Key::home;
+				case 2: return Key::insert;
+				case 3: return Key::del;
+				case 4: case 8: return Key::end;
+				case 5: return Key::page_up;
+				case 6: return Key::page_down;
+				case 11: return Key::f1;
+				case 12: return Key::f2;
+				case 13: return Key::f3;
+				case 14: return Key::f4;
+				case 15: return Key::f5;
+				case 17: return Key::f6;
+				case 18: return Key::f7;
+				case 19: return Key::f8;
+				case 20: return Key::f9;
+				case 21: return Key::f10;
+				case 23: return Key::f11;
+				case 24: return Key::f12;
+				default: return std::nullopt;
+			}
+		}
+
+		// Both mouse encodings carry the same button byte; they differ in how they report a release.
+		MouseEvent
+		mouseEvent( const int buttons, const int x, const int y, const bool released ) noexcept
+		{
+			MouseEvent rv{ MouseEvent::press, 0, x, y };
+			if( buttons & 4 ) rv.modifiers|= shift;
+			if( buttons & 8 ) rv.modifiers|= alt;
+			if( buttons & 16 ) rv.modifiers|= control;
+
+			if( buttons & 64 ) rv.button= 4 + ( buttons & 3 );
+			else if( ( buttons & 3 ) != 3 ) rv.button= ( buttons & 3 ) + 1;
+
+			if( released ) rv.action= MouseEvent::release;
+			else if( buttons & 32 ) rv.action= MouseEvent::motion;
+			return rv;
+		}
+	}
+
+	void
+	InputDecoder::emitKey( std::vector< InputEvent > &events, const Key key, const char32_t character, unsigned modifiers )
+	{
+		if( altPending ) modifiers|= alt;
+		altPending= false;
+		events.push_back( KeyEvent{ key, character, modifiers } );
+	}
+
+	void
+	InputDecoder::groundByte( const unsigned char byte, std::vector< InputEvent > &events )
+	{
+		if( byte == 0x1B ) state= escape;
+		else if( byte == '\r' or byte == '\n' ) emitKey( events, Key::enter );
+		else if( byte == '\t' ) emitKey( events, Key::tab );
+		else if( byte == 0x7F or byte == 0x08 ) emitKey( events, Key::backspace );
+		else if( byte == 0 ) emitKey( events, Key::character, U' ', control );
+		else if( byte <= 0x1A ) emitKey( events, Key::character, U'a' + byte - 1, control );
+		else if( byte < 0x20 ) emitKey( events, Key::character, byte + 0x40, control );
+		else if( byte < 0x80 ) emitKey( events, Key::character, byte );
+		else if( byte >= 0xC2 and byte <= 0xF4 )
+		{
+			state= utf8;
+			continuations= byte < 0xE0 ? 1 : byte < 0xF0 ? 2 : 3;
+			codePoint= byte & ( 0x3F >> continuations );
+
+			// Only the first continuation byte can make the character overlong, a surrogate, or too large.
+			lowest= byte == 0xE0 ? 0xA0 : byte == 0xF0 ? 0x90 : 0x80;
+			highest= byte == 0xED ? 0x9F : byte == 0xF4 ? 0x8F : 0xBF;
+		}
+		else emitKey( events, Key::character, U'\uFFFD' );
+	}
+
+	void
+	InputDecoder::finishCsi( const char final, std::vector< InputEvent > &events )
+	{
+		// A leading byte of `<`, `=`, `>` or `?` marks a private sequence.
+		const char marker= not sequence.empty() and sequence.front() >= '<' ? sequence.front() : 0;
+		const auto params= parameters( marker ? std::string_view{ sequence }.substr( 1 ) : sequence );
+
+		if( marker == '<' and ( final == 'M' or final == 'm' ) )
+		{
+			altPending= false;
+			events.push_back( mouseEvent( params[ 0 ], params[ 1 ], params[ 2 ], final == 'm' ) );
+		}
+		else if( marker ) altPending= false;
+		else if( final == 'M' and sequence.empty() )
+		{
+			state= x10Mouse;
+		}
+		else if( final == '~' and params[ 0 ] == 200 )
+		{
+			altPending= false;
+			state= paste;
+			pasted.clear();
+			terminatorMatched= 0;
+		}
+		else if( final == 'R' and reportsExpected and params[ 0 ] and params[ 1 ] )
+		{
+			altPending= false;
+			--reportsExpected;
+			events.push_back( PositionReport{ params[ 1 ], params[ 0 ] } );
+		}
+		else if( final == 'Z' ) emitKey( events, Key::tab, 0, shift );
+		else if( const auto key= final == '~' ? tildeKey( params[ 0 ] ) : letterKey( final ) )
+		{
+			emitKey( events, *key, 0, modifiersOf( params[ 1 ] ) );
+		}
+		else altPending= false;
+	}
+
+	void
+	InputDecoder::finishSs3( const char final, std::vector< InputEvent > &events )
+	{
+		if( final == 'M' ) emitKey( events, Key::enter ); // The keypad's enter key, in application mode.
+		else if( const auto key= letterKey( final ) ) emitKey( events, *key );
+		else altPending= false;
+	}
+
+	void
+	InputDecoder::finishX10Mouse( std::vector< InputEvent > &events )
+	{
+		// Each byte is offset by 32, to keep it printable.
+		const int buttons= static_cast< unsigned char >( sequence[ 0 ] ) - 32;
+		const int x= static_cast< unsigned char >( sequence[ 1 ] ) - 32;
+		const int y= static_cast< unsigned char >( sequence[ 2 ] ) - 32;
+
+		// This encoding has no way to say which button was released.
+		const bool released= ( buttons & 3 ) == 3 and not ( buttons & ( 32 | 64 ) );
+		altPending= false;
+		events.push_back( mouseEvent( buttons, x, y, released ) );
+	}
+
+	std::size_t
+	InputDecoder::pasteBytes( const std::string_view bytes, std::vector< InputEvent > &events )
+	{
+		std::size_t position= 0;
+		while( position < bytes.size() )
+		{
+			if( terminatorMatched == 0 )
+			{
+				// Everything before the next ESC is pasted text, and is copied at once.
+				const auto found= std::min( bytes.find( '\e', position ), bytes.size() );
+				pasted.append( bytes.substr( position, found - position ) );
+				position= found;
+				if( position == bytes.size() ) break;
+			}
+
+			const char ch= bytes[ position++ ];
+			if( ch == C::pasteTerminator[ terminatorMatched ] )
+			{
+				if( ++terminatorMatched == C::pasteTerminator.size() )
+				{
+					events.push_back( PasteEvent{ std::move( pasted ) } );
+					pasted.clear();
+					terminatorMatched= 0;
+					state= ground;
+					break;
+				}
+			}
+			else
+			{
+				// Only the terminator's first byte is an ESC, so a mismatch can only restart a match there.
+				pasted.append( C::pasteTerminator.substr( 0, terminatorMatched ) );
+				terminatorMatched= ch == '\e';
+				if( not terminatorMatched ) pasted+= ch;
+			}
+		}
+		return position;
+	}
+
+	void
+	InputDecoder::feed( const std::string_view bytes, std::vector< InputEvent > &events )
+	{
+		for( std::size_t position= 0; position < bytes.size(); )
+		{
+			if( state == paste )
+			{
+				position+= pasteBytes( bytes.substr( position ), events );
+				continue;
+			}
+
+			const unsigned char byte= bytes[ position++ ];
+			switch( state )
+			{
+				case ground:
+					groundByte( byte, events );
+					break;
+
+				case escape:
+					if( byte == '[' )
+					{
+						state= csi;
+						sequence.clear();
+					}
+					else if( byte == 'O' ) state= ss3;
+					else if( byte == 0x1B ) emitKey( events, Key::escape ); // The second ESC may start a sequence.
+					else
+					{
+						state= ground;
+						altPending= true;
+						groundByte( byte, events );
+					}
+					break;
+
+				case csi:
+					if( byte >= 0x40 and byte <= 0x7E )
+					{
+						state= ground;
+						finishCsi( byte, events );
+					}
+					else if( byte >= 0x20 and byte < 0x40 )
+					{
+						if( sequence.size() < C::maxSequenceLength ) sequence+= byte;
+						else state= csiDiscard;
+					}
+					else
+					{
+						// A control character cancels the sequence.
+						state= ground;
+						altPending= false;
+						if( byte < 0x20 ) groundByte( byte, events );
+					}
+					break;
+
+				case csiDiscard:
+					// The rest of a runaway sequence is not keys.
+					if( byte >= 0x20 and byte < 0x40 ) break;
+					state= ground;
+					altPending= false;
+					if( byte < 0x20 ) groundByte( byte, events );
+					break;
+
+				case ss3:
+					state= ground;
+					finishSs3( byte, events );
+					break;
+
+				case x10Mouse:
+					sequence+= byte;
+					if( sequence.size() == 3 )
+					{
+						state= ground;
+						finishX10Mouse( events );
+					}
+					break;
+
+				case utf8:
+					if( byte >= lowest and byte <= highest )
+					{
+						codePoint= codePoint << 6 | ( byte & 0x3F );
+						lowest= 0x80;
+						highest= 0xBF;
+						if( --continuations == 0 )
+						{
+							state= ground;
+							emitKey( events, Key::character, codePoint );
+						}
+					}
+					else
+					{
+						state= ground;
+						emitKey( events, Key::character, U'\uFFFD' );
+						groundByte( byte, events );
+					}
+					break;
+
+				case paste:
+					break;
+			}
+		}
+	}
+
+	void
+	InputDecoder::flush( std::vector< InputEvent > &events )
+	{
+		const State was= state;
+		state= ground;
+		switch( was )
+		{
+			case escape:
+				emitKey( events, Key::escape );
+				break;
+
+			case csi:
+				// Alt and `[`, rather than the start of a sequence.
+				if( sequence.empty() ) emitKey( events, Key::character, U'[', alt );
+				altPending= false;
+				break;
+
+			case ss3:
+				emitKey( events, Key::character, U'O', alt );
+				break;
+
+			case csiDiscard:
+			case x10Mouse:
+				altPending= false;
+				break;
+
+			case utf8:
+				emitKey( events, Key::character, U'\uFFFD' );
+				break;
+
+			case ground:
+			case paste:
+				state= was;
+				break;
+		}
+	}
+}
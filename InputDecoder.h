@@ -0,0 +1,181 @@
+static_assert( __cplusplus > 2020'00 );
+
+#pragma once
+
+#include <Alepha/Alepha.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+// Decoding of the bytes which a terminal sends as input: keys, with their modifiers, bracketed pastes, mouse reports,
+// and cursor position reports.  The decoder is only a state machine; `Console::readInput` feeds it from a terminal.
+
+namespace Alepha::Hydrogen  ::detail::  input_decoder_m
+{
+	inline namespace exports
+	{
+		enum class Key : int;
+
+		struct KeyEvent;
+		struct MouseEvent;
+		struct PasteEvent;
+		struct PositionReport;
+
+		// Every event which a terminal's input can decode to.
+		using InputEvent= std::variant< KeyEvent, MouseEvent, PasteEvent, PositionReport >;
+
+		class InputDecoder;
+	}
+
+	enum class exports::Key : int
+	{
+		character, // A character, which is in `KeyEvent::character`.
+
+		enter,
+		tab,
+		backspace,
+		escape,
+
+		up,
+		down,
+		right,
+		left,
+		home,
+		end,
+		insert,
+		del,
+		page_up,
+		page_down,
+
+		f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12,
+	};
+
+	namespace exports
+	{
+		// The modifier bits of an event.  (These match the bits which xterm reports, less one.)
+		enum Modifier : unsigned
+		{
+			shift= 1,
+			alt= 2,
+			control= 4,
+		};
+	}
+
+	struct exports::KeyEvent
+	{
+		Key key;
+		char32_t character= 0; // Only for `Key::character`.  A control character arrives as its letter, with `control`.
+		unsigned modifiers= 0;
+
+		friend bool operator == ( const KeyEvent &, const KeyEvent & )= default;
+	};
+
+	struct exports::MouseEvent
+	{
+		enum Action { press, release, motion };
+
+		Action action;
+		int button; // 1, 2 and 3 are left, middle and right; 4 and 5 are the wheel, up and down.  0 is none (motion).
+		int x; // Positions count from 1, as they do for `Console::gotoXY`.
+		int y;
+		unsigned modifiers= 0;
+
+		friend bool operator == ( const MouseEvent &, const MouseEvent & )= default;
+	};
+
+	struct exports::PasteEvent
+	{
+		std::string text;
+
+		friend bool operator == ( const PasteEvent &, const PasteEvent & )= default;
+	};
+
+	// The terminal's answer to a cursor position query (`ESC [ 6 n`).  `Console` consumes these itself.
+	struct exports::PositionReport
+	{
+		int x;
+		int y;
+
+		friend bool operator == ( const PositionReport &, const PositionReport & )= default;
+	};
+
+	/*!
+	 * An incremental decoder of terminal input.
+	 *
+	 * Bytes may be fed in pieces of any size; a sequence split across reads is held until the rest of it arrives.
+	 * Every event completed by a piece is appended to the caller's vector.
+	 *
+	 * A lone ESC cannot be told from the start of a sequence until more bytes arrive, or until none do.  When
+	 * `pending` is true, the caller should wait a short while for more input, then call `flush` if there was none.
+	 *
+	 * Understood are: UTF-8 text, control characters, ESC-prefixed (alt) keys, the CSI and SS3 cursor, editing and
+	 * function keys (with xterm's modifier parameters), bracketed paste (`ESC [ 200 ~` ... `ESC [ 201 ~`), and
+	 * mouse reports in both the SGR (1006) and the original X10 encodings.  Unrecognized sequences are dropped, as are
+	 * sequences too long to be any of these, up to and including their final byte.  Bytes which are not valid UTF-8
+	 * (including overlong encodings) decode as U+FFFD.
+	 *
+	 * A cursor position report looks just like F3 with modifiers, so one is only decoded as a `PositionReport`
+	 * while the decoder has been told to expect it.
+	 */
+	class exports::InputDecoder
+	{
+		public:
+			enum State { ground, escape, csi, csiDiscard, ss3, x10Mouse, utf8, paste };
+
+		private:
+			State state= ground;
+			bool altPending= false; // An ESC preceded the key being decoded.
+
+			std::string sequence; // The parameter and intermediate bytes of a CSI, or the bytes of an X10 report.
+
+			char32_t codePoint= 0;
+			int continuations= 0; // The UTF-8 continuation bytes still to come.
+			// The range the next continuation byte must be in.  It is narrower after some lead bytes, so that
+			// overlong encodings, surrogates, and code points past U+10FFFF are rejected.
+			unsigned char lowest= 0x80;
+			unsigned char highest= 0xBF;
+
+			std::string pasted;
+			std::size_t terminatorMatched= 0; // How much of the end of a paste has been seen.
+
+			std::size_t reportsExpected= 0;
+
+			void emitKey( std::vector< InputEvent > &events, Key key, char32_t character= 0, unsigned modifiers= 0 );
+			void groundByte( unsigned char byte, std::vector< InputEvent > &events );
+			void finishCsi( char final, std::vector< InputEvent > &events );
+			void finishSs3( char final, std::vector< InputEvent > &events );
+			void finishX10Mouse( std::vector< InputEvent > &events );
+			std::size_t pasteBytes( std::string_view bytes, std::vector< InputEvent > &events );
+
+		public:
+			// Decode some more input, appending whatever events it completes.
+			void feed( std::string_view bytes, std::vector< InputEvent > &events );
+
+			// True when the input so far ends partway through a key's sequence (but not within a paste).
+			bool pending() const noexcept { return state != ground and state != paste; }
+
+			// Give up on waiting for the rest of a sequence: a lone ESC becomes `Key::escape`, a partial UTF-8
+			// character becomes U+FFFD, and a partial escape sequence is dropped.
+			void flush( std::vector< InputEvent > &events );
+
+			State currentState() const noexcept { return state; }
+
+			// A cursor position query was sent, so its answer should be decoded as a `PositionReport`.
+			void expectPositionReport() noexcept { ++reportsExpected; }
+			std::size_t positionReportsExpected() const noexcept { return reportsExpected; }
+
+			// The oldest `count` queries will not be answered, so answers to them which do arrive are decoded as keys.
+			void forgetPositionReports( const std::size_t count ) noexcept { reportsExpected-= std::min( count, reportsExpected ); }
+	};
+}
+
+namespace Alepha::Hydrogen::inline exports::inline input_decoder_m
+{
+	using namespace detail::input_decoder_m::exports;
+}
@@ -0,0 +1,167 @@
+static_assert( __cplusplus > 2020'00 );
+
+#include "../InputDecoder.h"
+
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Alepha/Testing/test.h>
+#include <Alepha/Utility/evaluation_helpers.h>
+
+namespace
+{
+	using namespace Alepha::Testing::literals::test_literals;
+	using Alepha::Testing::exports::TestState;
+
+	using Alepha::InputEvent;
+	using Alepha::KeyEvent;
+	using Alepha::MouseEvent;
+	using Alepha::PasteEvent;
+	using Alepha::Key;
+
+	// Decode input which arrives in the pieces given, as though each were one read.
+	std::vector< InputEvent >
+	decode( const std::initializer_list< std::string_view > pieces )
+	{
+		Alepha::InputDecoder decoder;
+		std::vector< InputEvent > rv;
+		for( const auto piece: pieces ) decoder.feed( piece, rv );
+		return rv;
+	}
+
+	std::vector< InputEvent >
+	decode( const std::string_view input )
+	{
+		return decode( { input } );
+	}
+
+	std::vector< InputEvent > events( const std::initializer_list< InputEvent > list ) { return list; }
+
+	InputEvent key( const Key key, const unsigned modifiers= 0 ) { return KeyEvent{ key, 0, modifiers }; }
+	InputEvent character( const char32_t ch, const unsigned modifiers= 0 ) { return KeyEvent{ Key::character, ch, modifiers }; }
+
+	const InputEvent replacement= character( U'\uFFFD' );
+}
+
+static auto init= Alepha::Utility::enroll <=[]
+{
+	"Text and control characters decode as keys."_test <=[]( TestState test )
+	{
+		test.expect( decode( "a\xC3\xA9\xE6\x97\xA5" ) == events( { character( U'a' ), character( U'é' ), character( U'日' ) } ) );
+		test.expect( decode( "\r\t\x7F\x03" ) == events( { key( Key::enter ), key( Key::tab ), key( Key::backspace ),
+				character( U'c', Alepha::control ) } ) );
+		test.expect( decode( "\xFF\xC3x" ) == events( { replacement, replacement, character( U'x' ) } ) );
+	};
+
+	"Overlong encodings, surrogates, and code points past U+10FFFF are not characters."_test <=[]( TestState test )
+	{
+		test.expect( decode( "\xE0\x80\xAF" ) == events( { replacement, replacement, replacement } ) );
+		test.expect( decode( "\xE0\x9F\xBF" ) == events( { replacement, replacement, replacement } ) );
+		test.expect( decode( "\xF0\x8F\xBF\xBF" ) == events( { replacement, replacement, replacement, replacement } ) );
+		test.expect( decode( "\xED\xA0\x80" ) == events( { replacement, replacement, replacement } ) );
+		test.expect( decode( "\xF4\x90\x80\x80" ) == events( { replacement, replacement, replacement, replacement } ) );
+
+		// The shortest encodings of the same lengths are fine.
+		test.expect( decode( "\xE0\xA0\x80\xF0\x90\x80\x80\xF4\x8F\xBF\xBF" ) == events( { character( U'\u0800' ),
+				character( U'\U00010000' ), character( U'\U0010FFFF' ) } ) );
+	};
+
+	"Cursor and function key sequences decode, with their modifiers."_test <=[]( TestState test )
+	{
+		test.expect( decode( "\e[A\eOB\e[1;5C\e[3~\e[5;2~\e[24~\eOP\e[Z" ) == events(
+		{
+			key( Key::up ),
+			key( Key::down ),
+			key( Key::right, Alepha::control ),
+			key( Key::del ),
+			key( Key::page_up, Alepha::shift ),
+			key( Key::f12 ),
+			key( Key::f1 ),
+			key( Key::tab, Alepha::shift ),
+		} ) );
+	};
+
+	"An ESC before a key is alt."_test <=[]( TestState test )
+	{
+		test.expect( decode( "\ex\e\e[D" ) == events( { character( U'x', Alepha::alt ), key( Key::escape ), key( Key::left ) } ) );
+	};
+
+	"A lone ESC waits for a flush."_test <=[]( TestState test )
+	{
+		Alepha::InputDecoder decoder;
+		std::vector< InputEvent > decoded;
+		decoder.feed( "\e", decoded );
+		test.expect( decoded.empty() );
+		test.expect( decoder.pending() );
+
+		decoder.flush( decoded );
+		test.expect( decoded == events( { key( Key::escape ) } ) );
+		test.expect( not decoder.pending() );
+	};
+
+	"Sequences split across reads decode as though they were not."_test <=[]( TestState test )
+	{
+		test.expect( decode( { "\e", "[1;", "3", "A\xE6\x97", "\xA5" } ) == events( { key( Key::up, Alepha::alt ), character( U'日' ) } ) );
+	};
+
+	"Unknown sequences are dropped."_test <=[]( TestState test )
+	{
+		test.expect( decode( "\e[?1;2c\e[99~\e[1;2X!" ) == events( { character( U'!' ) } ) );
+	};
+
+	"An overlong sequence is dropped whole, up to its final byte."_test <=[]( TestState test )
+	{
+		const std::string parameters( 40, '1' );
+		test.expect( decode( "\e[" + parameters + ";5A!" ) == events( { character( U'!' ) } ) );
+		test.expect( decode( { "\e[" + parameters, ";5", "A!" } ) == events( { character( U'!' ) } ) );
+
+		// A control character still cancels it, and is a key itself.
+		test.expect( decode( "\e[" + parameters + "\r5A" ) == events( { key( Key::enter ), character( U'5' ), character( U'A' ) } ) );
+	};
+
+	"A bracketed paste is one event, escapes and all."_test <=[]( TestState test )
+	{
+		test.expect( decode( "\e[200~a\e[Ab\e[20\e[201~c" ) == events( { PasteEvent{ "a\e[Ab\e[20" }, character( U'c' ) } ) );
+		test.expect( decode( { "\e[200~one", " two\e[2", "01~" } ) == events( { PasteEvent{ "one two" } } ) );
+	};
+
+	"Mouse reports decode in both encodings."_test <=[]( TestState test )
+	{
+		test.expect( decode( "\e[<0;12;34M\e[<0;12;34m\e[<34;5;6M\e[<65;1;2M\e[<16;7;8M" ) == events(
+		{
+			MouseEvent{ MouseEvent::press, 1, 12, 34 },
+			MouseEvent{ MouseEvent::release, 1, 12, 34 },
+			MouseEvent{ MouseEvent::motion, 3, 5, 6 },
+			MouseEvent{ MouseEvent::press, 5, 1, 2 },
+			MouseEvent{ MouseEvent::press, 1, 7, 8, Alepha::control },
+		} ) );
+
+		test.expect( decode( "\e[M !\"\e[M#!\"" ) == events(
+		{
+			MouseEvent{ MouseEvent::press, 1, 1, 2 },
+			MouseEvent{ MouseEvent::release, 0, 1, 2 },
+		} ) );
+	};
+
+	"A position report is only decoded while one is expected."_test <=[]( TestState test )
+	{
+		Alepha::InputDecoder decoder;
+		std::vector< InputEvent > decoded;
+		decoder.expectPositionReport();
+		decoder.feed( "\e[12;40R\e[1;2R", decoded );
+		test.expect( decoded == events( { Alepha::PositionReport{ 40, 12 }, key( Key::f3, Alepha::shift ) } ) );
+		test.expect( decoder.positionReportsExpected() == 0 );
+
+		// Nor once the reports expected have been given up on.
+		decoded.clear();
+		decoder.expectPositionReport();
+		decoder.expectPositionReport();
+		decoder.forgetPositionReports( 1 );
+		decoder.feed( "\e[3;4R\e[1;2R", decoded );
+		test.expect( decoded == events( { Alepha::PositionReport{ 4, 3 }, key( Key::f3, Alepha::shift ) } ) );
+		decoder.forgetPositionReports( 1 );
+		test.expect( decoder.positionReportsExpected() == 0 );
+	};
+};
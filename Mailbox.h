@@ -0,0 +1,302 @@
+static_assert( __cplusplus > 2020'00 );
+
+#pragma once
+
+#include <Alepha/Alepha.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/noncopyable.hpp>
+
+#include <Alepha/AutoRAII.h>
+
+namespace Alepha::inline Cavorite  ::detail::  mailbox
+{
+	inline namespace exports
+	{
+		enum class Producers { single, multiple };
+
+		template< typename T, Producers producers > class Mailbox;
+
+		template< typename T > using SpscMailbox= Mailbox< T, Producers::single >;
+		template< typename T > using MpscMailbox= Mailbox< T, Producers::multiple >;
+	}
+
+	namespace C
+	{
+		const std::size_t defaultSlots= 1024;
+
+		// Keeps the producer and consumer indices on separate cache lines.
+		const std::size_t cacheLine= 64;
+	}
+
+	/*!
+	 * A bounded, lock-free, single-consumer queue, whose capacity is measured in weight.
+	 *
+	 * The weight of an item is given by `mailboxWeight( item )`, found by ADL.  For `Blob` objects, that is
+	 * their size, so a `Mailbox< Blob >` bounds the number of bytes in flight between threads, rather than the
+	 * number of items.  (See `BlobMailbox.h`.)  A push which would exceed the capacity is refused (or blocks), which gives producers
+	 * backpressure.  So that an item heavier than the whole capacity cannot deadlock the mailbox, an empty
+	 * mailbox always accepts one item.
+	 *
+	 * There is also a limit on the number of items (`slots`), as the items are held in a ring.
+	 *
+	 * With `Producers::single`, exactly one thread may push.  With `Producers::multiple`, any number may.  In
+	 * both cases, exactly one thread may pop.  The ring is Vyukov's bounded queue: each slot carries a sequence
+	 * number which tells producers and the consumer whose turn it is, so no locks are taken.  The blocking
+	 * operations wait on (and are woken by) C++20 atomic notifications.
+	 */
+	template< typename T, Producers producers >
+	class exports::Mailbox
+		: boost::noncopyable
+	{
+		private:
+			struct Slot
+			{
+				std::atomic< std::size_t > sequence;
+				std::optional< T > item;
+			};
+
+			const std::size_t capacity;
+			const std::size_t mask;
+			std::unique_ptr< Slot[] > slots;
+
+			alignas( C::cacheLine ) std::atomic< std::size_t > tail= 0; // Next position to push into.
+			alignas( C::cacheLine ) std::size_t head= 0; // Next position to pop from.  Only touched by the consumer.
+
+			alignas( C::cacheLine ) std::atomic< std::size_t > weight= 0;
+			std::atomic< bool > closed= false;
+
+			// These only exist to be waited upon by the blocking operations.
+			std::atomic< std::uint32_t > pushes= 0;
+			std::atomic< std::uint32_t > pops= 0;
+
+			bool
+			reserveWeight( const std::size_t amount ) noexcept
+			{
+				std::size_t current= weight.load( std::memory_order_relaxed );
+				do
+				{
+					if( current != 0 and current + amount > capacity ) return false;
+				}
+				while( not weight.compare_exchange_weak( current, current + amount, std::memory_order_relaxed ) );
+
+				return true;
+			}
+
+			Slot *
+			claimSlot() noexcept
+			{
+				std::size_t position= tail.load( std::memory_order_relaxed );
+				while( true )
+				{
+					Slot &slot= slots[ position & mask ];
+					const std::size_t sequence= slot.sequence.load( std::memory_order_acquire );
+					if( sequence < position ) return nullptr; // The ring is full.
+					if( sequence == position )
+					{
+						if constexpr( producers == Producers::single )
+						{
+							tail.store( position + 1, std::memory_order_relaxed );
+							return &slot;
+						}
+						else if( tail.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) ) return &slot;
+					}
+					else position= tail.load( std::memory_order_relaxed );
+				}
+			}
+
+			void
+			notifyPush() noexcept
+			{
+				pushes.fetch_add( 1, std::memory_order_release );
+				pushes.notify_one();
+			}
+
+			void
+			notifyPop() noexcept
+			{
+				pops.fetch_add( 1, std::memory_order_release );
+				pops.notify_all();
+			}
+
+		public:
+			/*!
+			 * Construct an empty mailbox.
+			 *
+			 * @param capacity The total weight of items which may be held at once.
+			 * @param slotCount The number of items which may be held at once.  Rounded up to a power of two.
+			 */
+			explicit
+			Mailbox( const std::size_t capacity, const std::size_t slotCount= C::defaultSlots )
+				: capacity( capacity ),
+				mask( std::bit_ceil( std::max< std::size_t >( slotCount, 2 ) ) - 1 ),
+				slots( new Slot[ mask + 1 ] )
+			{
+				for( std::size_t i= 0; i <= mask; ++i ) slots[ i ].sequence.store( i, std::memory_order_relaxed );
+			}
+
+			/*!
+			 * Push an item, if there is room for it.
+			 *
+			 * @param item The item to push.  It is only moved from if the push succeeds.
+			 * @return `true` if the item was pushed, and `false` if the mailbox was too full (or closed).
+			 */
+			[[nodiscard]] bool
+			tryPush( T &item )
+			{
+				if( closed.load( std::memory_order_relaxed ) ) return false;
+
+				const std::size_t itemWeight= mailboxWeight( item );
+				if( not reserveWeight( itemWeight ) ) return false;
+
+				Slot *const slot= claimSlot();
+				if( not slot )
+				{
+					weight.fetch_sub( itemWeight, std::memory_order_relaxed );
+					return false;
+				}
+
+				slot->item.emplace( std::move( item ) );
+				slot->sequence.store( slot->sequence.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+				notifyPush();
+				return true;
+			}
+
+			/*!
+			 * Push an item, waiting for room if necessary.
+			 *
+			 * @throws std::logic_error if the mailbox is closed.
+			 */
+			void
+			push( T item )
+			{
+				while( true )
+				{
+					const auto seen= pops.load( std::memory_order_acquire );
+					if( tryPush( item ) ) return;
+					if( closed.load( std::memory_order_relaxed ) ) throw std::logic_error( "Pushed to a closed `Mailbox`." );
+					pops.wait( seen, std::memory_order_acquire );
+				}
+			}
+
+			/*!
+			 * Pop an item, if one is available.
+			 *
+			 * @note Only the single consumer thread may call this.
+			 */
+			[[nodiscard]] std::optional< T >
+			tryPop()
+			{
+				Slot &slot= slots[ head & mask ];
+				if( slot.sequence.load( std::memory_order_acquire ) != head + 1 ) return std::nullopt;
+
+				std::optional< T > rv= std::move( slot.item );
+				slot.item.reset();
+				slot.sequence.store( head + mask + 1, std::memory_order_release );
+				++head;
+
+				weight.fetch_sub( mailboxWeight( *rv ), std::memory_order_relaxed );
+				notifyPop();
+				return rv;
+			}
+
+			/*!
+			 * Pop an item, waiting for one if necessary.
+			 *
+			 * @return The item, or `std::nullopt` if the mailbox has been closed and is empty.
+			 *
+			 * @note Only the single consumer thread may call this.
+			 */
+			[[nodiscard]] std::optional< T >
+			pop()
+			{
+				while( true )
+				{
+					const auto seen= pushes.load( std::memory_order_acquire );
+					if( auto rv= tryPop() ) return rv;
+					if( closed.load( std::memory_order_acquire ) ) return tryPop();
+					pushes.wait( seen, std::memory_order_acquire );
+				}
+			}
+
+			/*!
+			 * Pop every item which is available, handing each to `sink`, in order.
+			 *
+			 * The weight is released, and waiting producers are woken, once for the whole batch.  If `sink` throws,
+			 * the items popped so far (including the one it threw on) are still released.
+			 *
+			 * @param sink A function which is called with each item (as an rvalue).
+			 * @param limit The maximum number of items to pop.
+			 * @return The number of items popped.
+			 *
+			 * @note Only the single consumer thread may call this.
+			 */
+			template< typename Sink >
+			std::size_t
+			drain( Sink sink, const std::size_t limit= -1 )
+			{
+				std::size_t count= 0;
+				std::size_t drained= 0;
+
+				// Items already popped are released even if `sink` throws (before `count` counts that item).
+				const auto first= head;
+				const AutoRAII release
+				{
+					[]{},
+					[&]
+					{
+						if( head == first ) return;
+						weight.fetch_sub( drained, std::memory_order_relaxed );
+						notifyPop();
+					}
+				};
+
+				for( ; count < limit; ++count )
+				{
+					Slot &slot= slots[ head & mask ];
+					if( slot.sequence.load( std::memory_order_acquire ) != head + 1 ) break;
+
+					T item= std::move( *slot.item );
+					slot.item.reset();
+					slot.sequence.store( head + mask + 1, std::memory_order_release );
+					++head;
+
+					drained+= mailboxWeight( item );
+					sink( std::move( item ) );
+				}
+
+				return count;
+			}
+
+			/*!
+			 * Refuse further pushes, and wake every waiting thread.
+			 *
+			 * Items which are already in the mailbox can still be popped.
+			 */
+			void
+			close() noexcept
+			{
+				closed.store( true, std::memory_order_release );
+				notifyPush();
+				notifyPop();
+			}
+
+			// The total weight currently held.  This is only a snapshot, when other threads are active.
+			std::size_t currentWeight() const noexcept { return weight.load( std::memory_order_relaxed ); }
+	};
+}
+
+namespace Alepha::Cavorite::inline exports::inline mailbox
+{
+	using namespace detail::mailbox::exports;
+}
@@ -0,0 +1,269 @@
+static_assert( __cplusplus > 2020'00 );
+
+#include <Alepha/Mailbox.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Alepha/Testing/test.h>
+#include <Alepha/Utility/evaluation_helpers.h>
+
+namespace
+{
+	using namespace std::literals::chrono_literals;
+
+	struct Parcel
+	{
+		int producer= 0;
+		int sequence= 0;
+		std::size_t weight= 1;
+		std::string payload;
+
+		friend std::size_t mailboxWeight( const Parcel &parcel ) noexcept { return parcel.weight; }
+	};
+
+	Parcel weighing( const std::size_t weight ) { return { .weight= weight }; }
+}
+
+static auto init= Alepha::Utility::enroll <=[]
+{
+	using namespace Alepha::Testing::exports::literals;
+	using Alepha::Testing::exports::TestState;
+
+	using Alepha::MpscMailbox;
+	using Alepha::SpscMailbox;
+
+	"Items come out in the order they went in."_test <=[]( TestState test )
+	{
+		SpscMailbox< Parcel > mailbox{ 100 };
+		int pushed= 0;
+		for( int i= 0; i < 10; ++i )
+		{
+			Parcel parcel{ .sequence= i };
+			pushed+= mailbox.tryPush( parcel );
+		}
+		test.expect( pushed == 10 );
+		test.expect( mailbox.currentWeight() == 10 );
+
+		std::vector< int > popped;
+		while( const auto parcel= mailbox.tryPop() ) popped.push_back( parcel->sequence );
+		test.expect( popped == std::vector{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 } );
+		test.expect( mailbox.currentWeight() == 0 );
+	};
+
+	"Pushes beyond the capacity in weight are refused, until there is room."_test <=[]( TestState test )
+	{
+		SpscMailbox< Parcel > mailbox{ 10 };
+		Parcel six= weighing( 6 );
+		Parcel five= weighing( 5 );
+		Parcel four= weighing( 4 );
+
+		test.expect( mailbox.tryPush( six ) );
+		test.expect( not mailbox.tryPush( five ) );
+		test.expect( mailbox.tryPush( four ) );
+		test.expect( mailbox.currentWeight() == 10 );
+
+		const auto first= mailbox.tryPop();
+		test.expect( first and first->weight == 6 );
+		test.expect( mailbox.tryPush( five ) );
+		test.expect( mailbox.currentWeight() == 9 );
+	};
+
+	"An empty mailbox accepts one item heavier than its whole capacity."_test <=[]( TestState test )
+	{
+		SpscMailbox< Parcel > mailbox{ 10 };
+		Parcel heavy= weighing( 100 );
+		Parcel light= weighing( 1 );
+
+		test.expect( mailbox.tryPush( heavy ) );
+		test.expect( not mailbox.tryPush( light ) );
+		test.expect( mailbox.tryPop().has_value() );
+		test.expect( mailbox.tryPush( light ) );
+	};
+
+	"Pushes beyond the number of slots are refused."_test <=[]( TestState test )
+	{
+		SpscMailbox< Parcel > mailbox{ 100, 2 };
+		Parcel parcel;
+		test.expect( mailbox.tryPush( parcel ) );
+		test.expect( mailbox.tryPush( parcel ) );
+		test.expect( not mailbox.tryPush( parcel ) );
+		test.expect( mailbox.currentWeight() == 2 );
+	};
+
+	"A refused item is not moved from."_test <=[]( TestState test )
+	{
+		SpscMailbox< Parcel > mailbox{ 1 };
+		Parcel first= weighing( 1 );
+		Parcel second{ .payload= "still here" };
+		std::ignore= mailbox.tryPush( first );
+
+		test.expect( not mailbox.tryPush( second ) );
+		test.expect( second.payload == "still here" );
+	};
+
+	"A blocking push waits until a pop makes room."_test <=[]( TestState test )
+	{
+		SpscMailbox< Parcel > mailbox{ 10 };
+		mailbox.push( weighing( 10 ) );
+
+		std::atomic< bool > pushed= false;
+		std::thread producer{ [&]
+		{
+			mailbox.push( weighing( 5 ) );
+			pushed= true;
+		} };
+
+		std::this_thread::sleep_for( 50ms );
+		const bool pushedWhileFull= pushed;
+		const auto popped= mailbox.pop();
+		producer.join();
+
+		test.expect( not pushedWhileFull );
+		test.expect( popped and popped->weight == 10 );
+		test.expect( pushed );
+		test.expect( mailbox.currentWeight() == 5 );
+	};
+
+	"A closed mailbox refuses pushes, but gives up what it holds."_test <=[]( TestState test )
+	{
+		SpscMailbox< Parcel > mailbox{ 10 };
+		mailbox.push( Parcel{ .sequence= 1 } );
+		mailbox.push( Parcel{ .sequence= 2 } );
+		mailbox.close();
+
+		Parcel late;
+		test.expect( not mailbox.tryPush( late ) );
+
+		bool threw= false;
+		try
+		{
+			mailbox.push( Parcel{} );
+		}
+		catch( const std::logic_error & )
+		{
+			threw= true;
+		}
+		test.expect( threw );
+
+		const auto first= mailbox.pop();
+		const auto second= mailbox.pop();
+		const auto none= mailbox.pop();
+		test.expect( first and first->sequence == 1 );
+		test.expect( second and second->sequence == 2 );
+		test.expect( not none );
+	};
+
+	"Closing wakes a consumer waiting on an empty mailbox."_test <=[]( TestState test )
+	{
+		SpscMailbox< Parcel > mailbox{ 10 };
+		std::optional< Parcel > popped{ Parcel{} };
+		std::thread consumer{ [&]{ popped= mailbox.pop(); } };
+
+		std::this_thread::sleep_for( 10ms );
+		mailbox.close();
+		consumer.join();
+		test.expect( not popped );
+	};
+
+	"Draining pops in order, up to a limit, and releases the weight."_test <=[]( TestState test )
+	{
+		SpscMailbox< Parcel > mailbox{ 100 };
+		for( int i= 0; i < 5; ++i ) mailbox.push( Parcel{ .sequence= i, .weight= 3 } );
+
+		std::vector< int > drained;
+		const auto first= mailbox.drain( [&]( Parcel &&parcel ) { drained.push_back( parcel.sequence ); }, 3 );
+		test.expect( first == 3 );
+		test.expect( mailbox.currentWeight() == 6 );
+
+		const auto rest= mailbox.drain( [&]( Parcel &&parcel ) { drained.push_back( parcel.sequence ); } );
+		test.expect( rest == 2 );
+		test.expect( drained == std::vector{ 0, 1, 2, 3, 4 } );
+		test.expect( mailbox.currentWeight() == 0 );
+	};
+
+	"A sink which throws still releases the weight of what was drained, and the rest stay."_test <=[]( TestState test )
+	{
+		SpscMailbox< Parcel > mailbox{ 100 };
+		for( int i= 0; i < 5; ++i ) mailbox.push( Parcel{ .sequence= i, .weight= 3 } );
+
+		std::vector< int > drained;
+		const auto sink= [&]( Parcel &&parcel )
+		{
+			drained.push_back( parcel.sequence );
+			if( parcel.sequence == 1 ) throw std::runtime_error( "Sink failed." );
+		};
+		bool thrown= false;
+		try
+		{
+			mailbox.drain( sink );
+		}
+		catch( const std::runtime_error & )
+		{
+			thrown= true;
+		}
+		test.expect( thrown );
+		test.expect( mailbox.currentWeight() == 9 );
+
+		const auto rest= mailbox.drain( [&]( Parcel &&parcel ) { drained.push_back( parcel.sequence ); } );
+		test.expect( rest == 3 );
+		test.expect( drained == std::vector{ 0, 1, 2, 3, 4 } );
+		test.expect( mailbox.currentWeight() == 0 );
+	};
+
+	"A single producer's stream arrives whole and in order, through a small mailbox."_test <=[]( TestState test )
+	{
+		const int count= 100'000;
+		SpscMailbox< Parcel > mailbox{ 8, 4 };
+		std::thread producer{ [&]
+		{
+			for( int i= 0; i < count; ++i ) mailbox.push( Parcel{ .sequence= i } );
+			mailbox.close();
+		} };
+
+		int received= 0;
+		bool ordered= true;
+		while( const auto parcel= mailbox.pop() ) ordered= ordered and parcel->sequence == received++;
+		producer.join();
+
+		test.expect( received == count );
+		test.expect( ordered );
+	};
+
+	"Many producers' streams each arrive whole and in order."_test <=[]( TestState test )
+	{
+		const int producerCount= 4;
+		const int count= 50'000;
+		MpscMailbox< Parcel > mailbox{ 64, 16 };
+
+		std::vector< std::thread > producers;
+		std::atomic< int > finished= 0;
+		for( int id= 0; id < producerCount; ++id )
+		{
+			producers.emplace_back( [&, id]
+			{
+				for( int i= 0; i < count; ++i ) mailbox.push( Parcel{ .producer= id, .sequence= i, .weight= 1 + std::size_t( i % 7 ) } );
+				if( ++finished == producerCount ) mailbox.close();
+			} );
+		}
+
+		std::vector< int > next( producerCount, 0 );
+		bool ordered= true;
+		bool withinCapacity= true;
+		while( const auto parcel= mailbox.pop() )
+		{
+			ordered= ordered and parcel->sequence == next[ parcel->producer ]++;
+			withinCapacity= withinCapacity and mailbox.currentWeight() <= 64;
+		}
+		for( auto &producer: producers ) producer.join();
+
+		test.expect( ordered );
+		test.expect( withinCapacity );
+		test.expect( next == std::vector( producerCount, count ) );
+		test.expect( mailbox.currentWeight() == 0 );
+	};
+};
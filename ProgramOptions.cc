@@ -2,9 +2,22 @@ static_assert( __cplusplus > 2020'00 );
 
 #include "ProgramOptions.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cctype>
+
 #include <set>
 #include <exception>
+#include <forward_list>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
 
+#include <Alepha/AutoRAII.h>
 #include <Alepha/Console.h>
 #include <Alepha/word_wrap.h>
 #include <Alepha/StaticValue.h>
@@ -19,6 +32,9 @@ namespace Alepha::Cavorite  ::detail::  program_options
 			const bool debug= false;
 			const bool debugMatching= false or C::debug;
 			const bool debugExclusions= false or C::debug;
+
+			// Response files may name other response files, but not without limit.
+			const int maxResponseFileDepth= 16;
 		}
 
 		using namespace std::literals::string_literals;
@@ -42,7 +58,7 @@ namespace Alepha::Cavorite  ::detail::  program_options
 	struct impl::ProgramOption
 	{
 		std::function< void ( std::optional< std::string > ) > handler;
-		std::ostringstream help;
+		HelpText help;
 		std::function< std::string () > defaultBuilder= [] { return ""; };
 
 		std::map< std::type_index, std::set< const DomainBase * > > domains;
@@ -91,7 +107,7 @@ namespace Alepha::Cavorite  ::detail::  program_options
 		return *this;
 	}
 
-	std::ostream &
+	HelpText &
 	OptionBinding::operator << ( std::function< void () > core ) const
 	{
 		// So that users do not have to implement their own checking for argument absent,
@@ -108,7 +124,7 @@ namespace Alepha::Cavorite  ::detail::  program_options
 		return registerHandler( handler );
 	}
 
-	std::ostream &
+	HelpText &
 	OptionBinding::operator << ( std::function< void ( std::string ) > core ) const
 	{
 		// So that users do not have to implement their own checking for argument present,
@@ -127,13 +143,28 @@ namespace Alepha::Cavorite  ::detail::  program_options
 		option->defaultBuilder= builder;
 	}
 
-	std::ostream &
+	HelpText &
 	OptionBinding::registerHandler( std::function< void ( std::optional< std::string > ) > handler ) const
 	{
 		option->handler= handler;
 		return option->help;
 	}
 
+	std::string
+	HelpText::str() const
+	{
+		std::ostringstream oss;
+		for( const auto &segment: segments )
+		{
+			std::visit( [&]( const auto &piece )
+			{
+				if constexpr( std::is_invocable_v< decltype( piece ), std::ostream & > ) piece( oss );
+				else oss << piece;
+			}, segment );
+		}
+		return std::move( oss ).str();
+	}
+
 	namespace
 	{
 		std::string
@@ -251,7 +282,7 @@ namespace Alepha::Cavorite  ::detail::  program_options
 	}
 
 	// The options which set boolean flags can be 
-	std::ostream &
+	HelpText &
 	OptionBinding::operator << ( bool &flag ) const
 	{
 		--OptionString{ "no-" + name.substr( 2 ) }
@@ -276,6 +307,240 @@ namespace Alepha::Cavorite  ::detail::  program_options
 		return OptionBinding{ name, &programOptions()[ name ] };
 	}
 
+	namespace
+	{
+		using OptionEntry= std::pair< const std::string, impl::ProgramOption >;
+
+		// An argument which names an option, split into that option and the option's argument.
+		struct OptionMatch
+		{
+			OptionEntry *option;
+			std::optional< std::string > argument;
+		};
+
+		/*!
+		 * Finds the option which an argument names.
+		 *
+		 * An argument is split once, at its first `=` or `:`, and the name before that is looked up in a hash table
+		 * of every registered option.  A name which isn't registered, but which is a prefix of exactly one
+		 * option's name, is taken as an abbreviation of that option.
+		 */
+		class OptionIndex
+		{
+			private:
+				std::unordered_map< std::string_view, OptionEntry * > options;
+
+			public:
+				OptionIndex()
+				{
+					// The keys view the names held by `programOptions`, whose nodes never move.
+					options.reserve( programOptions().size() );
+					for( auto &entry: programOptions() ) options.emplace( entry.first, &entry );
+				}
+
+				std::optional< OptionMatch >
+				find( const std::string_view param ) const
+				{
+					const auto split= param.find_first_of( "=:" );
+					const auto name= param.substr( 0, split );
+					auto argument= evaluate <=[&]() -> std::optional< std::string >
+					{
+						if( split == std::string_view::npos ) return std::nullopt;
+						return std::string{ param.substr( split + 1 ) };
+					};
+
+					if( const auto found= options.find( name ); found != end( options ) )
+					{
+						return OptionMatch{ found->second, std::move( argument ) };
+					}
+
+					// Only something spelled like an option can abbreviate one.
+					if( not name.starts_with( "--" ) or name.size() == 2 ) return std::nullopt;
+
+					auto &opts= programOptions();
+					const auto first= opts.lower_bound( std::string{ name } );
+					if( first == end( opts ) or not first->first.starts_with( name ) ) return std::nullopt;
+
+					if( const auto second= std::next( first ); second != end( opts ) and second->first.starts_with( name ) )
+					{
+						std::string candidates;
+						for( auto candidate= first; candidate != end( opts ) and candidate->first.starts_with( name ); ++candidate )
+						{
+							if( not candidates.empty() ) candidates+= ", ";
+							candidates+= '`' + candidate->first + '`';
+						}
+						throw std::runtime_error( "`" + std::string{ param } + "` is ambiguous.  It could be any of: " + candidates + "." );
+					}
+
+					if( C::debugMatching ) error() << "Taking `" << name << "` as short for `" << first->first << "`" << std::endl;
+					return OptionMatch{ &*first, std::move( argument ) };
+				}
+		};
+	}
+
+	namespace
+	{
+		// A response file, mapped privately, so that it can be tokenized where it lies.
+		class MappedFile
+		{
+			private:
+				char *data= nullptr;
+				std::size_t size= 0;
+				std::pair< ::dev_t, ::ino_t > identity_;
+
+			public:
+				explicit
+				MappedFile( const std::string &path )
+				{
+					const int fd= ::open( path.c_str(), O_RDONLY | O_CLOEXEC );
+					if( fd < 0 ) throw std::system_error{ errno, std::generic_category(), "Unable to open response file `" + path + "`" };
+					AutoRAII closer{ [fd] { return fd; }, []( const int fd ) { ::close( fd ); } };
+
+					struct stat status;
+					if( ::fstat( fd, &status ) < 0 )
+					{
+						throw std::system_error{ errno, std::generic_category(), "Unable to read response file `" + path + "`" };
+					}
+					identity_= { status.st_dev, status.st_ino };
+					if( status.st_size == 0 ) return;
+
+					void *const mapping= ::mmap( nullptr, status.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+					if( mapping == MAP_FAILED )
+					{
+						throw std::system_error{ errno, std::generic_category(), "Unable to map response file `" + path + "`" };
+					}
+					std::ignore= ::madvise( mapping, status.st_size, MADV_SEQUENTIAL );
+
+					data= static_cast< char * >( mapping );
+					size= status.st_size;
+				}
+
+				~MappedFile() { if( data ) ::munmap( data, size ); }
+
+				MappedFile( const MappedFile & )= delete;
+				MappedFile &operator= ( const MappedFile & )= delete;
+
+				char *begin() const noexcept { return data; }
+				char *end() const noexcept { return data + size; }
+
+				// The file itself, however it was named.
+				std::pair< ::dev_t, ::ino_t > identity() const noexcept { return identity_; }
+		};
+
+		/*!
+		 * Split some text into arguments, in place.
+		 *
+		 * Arguments are separated by whitespace.  Single quotes group text literally, double quotes group text
+		 * in which a backslash escapes the next character, and outside of quotes a backslash escapes the next
+		 * character, too.  Removing the quotes and backslashes shifts each argument down within the text, so every
+		 * argument is handed to `sink` as a view of the text itself.
+		 */
+		template< typename Sink >
+		void
+		tokenize( char *const text, const std::size_t size, const std::string &source, Sink sink )
+		{
+			std::size_t in= 0;
+			while( true )
+			{
+				while( in < size and std::isspace( static_cast< unsigned char >( text[ in ] ) ) ) ++in;
+				if( in == size ) return;
+
+				const std::size_t start= in;
+				std::size_t out= in;
+				char quote= 0;
+				for( ; in < size; ++in )
+				{
+					const char ch= text[ in ];
+					if( quote == '\'' )
+					{
+						if( ch == quote ) quote= 0;
+						else text[ out++ ]= ch;
+					}
+					else if( ch == '\\' and in + 1 < size ) text[ out++ ]= text[ ++in ];
+					else if( quote == '"' )
+					{
+						if( ch == quote ) quote= 0;
+						else text[ out++ ]= ch;
+					}
+					else if( ch == '\'' or ch == '"' ) quote= ch;
+					else if( std::isspace( static_cast< unsigned char >( ch ) ) ) break;
+					else text[ out++ ]= ch;
+				}
+				if( quote ) throw std::runtime_error( "Unterminated quote in " + source + "." );
+
+				sink( std::string_view{ text + start, out - start } );
+			}
+		}
+
+		/*!
+		 * The program arguments, after expanding `@file` response files and prepending the options from the
+		 * environment.
+		 *
+		 * The arguments are views into `argv`, the mapped response files, or a copy of the environment variable,
+		 * all of which this owns.
+		 */
+		class ExpandedArguments
+		{
+			private:
+				std::string environment;
+				std::forward_list< MappedFile > files;
+				std::vector< std::string_view > arguments;
+
+				// Response files are not expanded after the `--` which ends the options.
+				bool terminated= false;
+
+				// The response files being expanded, to catch one which names itself.
+				std::set< std::pair< ::dev_t, ::ino_t > > open;
+
+				void
+				add( const std::string_view argument, const int depth )
+				{
+					if( terminated or argument.size() < 2 or not argument.starts_with( '@' ) )
+					{
+						if( argument == "--" ) terminated= true;
+						arguments.push_back( argument );
+						return;
+					}
+
+					const std::string path{ argument.substr( 1 ) };
+					if( depth == C::maxResponseFileDepth )
+					{
+						throw std::runtime_error( "Response files are nested too deeply, at `" + path + "`." );
+					}
+
+					const auto &file= files.emplace_front( path );
+					if( not open.insert( file.identity() ).second )
+					{
+						throw std::runtime_error( "Response file `" + path + "` includes itself." );
+					}
+					tokenize( file.begin(), file.end() - file.begin(), "response file `" + path + "`",
+							[&]( const std::string_view token ) { add( token, depth + 1 ); } );
+					open.erase( file.identity() );
+				}
+
+			public:
+				explicit
+				ExpandedArguments( const std::vector< std::string > &args )
+				{
+					const auto variable= applicationName() + "_OPTIONS";
+					if( const char *const text= ::getenv( variable.c_str() ) )
+					{
+						environment= text;
+						tokenize( environment.data(), environment.size(), "`" + variable + "`",
+								[&]( const std::string_view token ) { add( token, 0 ); } );
+
+						// A `--` there would end the command line's options too, which cannot be what was meant.
+						if( terminated ) throw std::runtime_error( "`" + variable + "` may not contain `--`." );
+					}
+
+					arguments.reserve( arguments.size() + args.size() );
+					for( const auto &arg: args ) add( arg, 0 );
+				}
+
+				const std::vector< std::string_view > &get() const noexcept { return arguments; }
+		};
+	}
+
 	[[noreturn]] void
 	impl::usage( const std::string &helpMessage, const std::optional< std::string > &canonicalName )
 	{
@@ -301,56 +566,67 @@ namespace Alepha::Cavorite  ::detail::  program_options
 	{
 		--"help"_option << usageFunction << "Print this help message (program usage).";
 
+		return processOptions( args );
+	}
+
+	std::vector< std::string >
+	impl::processOptions( const std::vector< std::string > &args )
+	{
 		// The unprocessed program arguments will be collected into this vector
 		std::vector< std::string > rv;
 
-		const auto &opts= programOptions();
+		const ExpandedArguments expanded{ args };
+		const auto &allArgs= expanded.get();
 
 		// The arguments end at the first `--` token (by itself), or when there's no more.
-		const auto endOfArgs= std::find( begin( args ), end( args ), "--" );
+		const auto endOfArgs= std::find( begin( allArgs ), end( allArgs ), "--" );
+
+		const std::vector< std::string_view > argsToProcess{ begin( allArgs ), endOfArgs };
+
+		// Every argument is matched to its option up front, so that an abbreviated `--help` is seen, below.
+		const OptionIndex index;
+		std::vector< std::optional< OptionMatch > > matches;
+		matches.reserve( argsToProcess.size() );
+		for( const auto &param: argsToProcess ) matches.push_back( index.find( param ) );
+
+		const auto isHelp= []( const std::optional< OptionMatch > &match )
+		{
+			return match.has_value() and match->option->first == "--help" and not match->argument.has_value();
+		};
 
 		// Because `--help` needs to expand certain variables, options which can affect it need to be processed
 		// before handling `--help`
-		const bool helpRequested= std::find( begin( args ), endOfArgs, "--help" ) != endOfArgs;
+		const bool helpRequested= std::any_of( begin( matches ), end( matches ), isHelp );
 
 		// Each time a required domain is seen, we put that requirement into this set.
 		// If all required options are passed, then this set should match the list of
 		// required option domains.
 		std::set< const DomainBase * > requiredOptionsSeen;
 
-		const std::vector< std::string > argsToProcess{ begin( args ), endOfArgs };
-
 		// An option that requires an argument might have been type-o'ed as `--option arg`
 		// instead of `--option=arg`.  By tracking the next option, we can print helpful
 		// diagnostics in the error messages.
 		auto next= begin( argsToProcess );
+		auto match= begin( matches );
 
 		for( const auto &param: argsToProcess )
 		try
 		{
 			++next;
+			const auto &found= *match++;
+
 			// Because `--help` has a special relationship with the rest of the options,
 			// we skip it in this pass.
-			if( helpRequested and param == "--help" ) continue;
+			if( helpRequested and isHelp( found ) ) continue;
 
-			// Match up each argument.
+			// Apply the matched option.
 			const bool matched= evaluate <=[&]
 			{
-				// TODO: Make this into direct map lookups.
-				// It requires modifying `--` options as passed, to strip `=` before
-				// doing a map lookup.
-				for( const auto &[ name, def ]: opts )
+				if( found.has_value() )
 				{
-					if( C::debugMatching ) error() << "Attempting to match `" << name << "` to `" << param << "`" << std::endl;
-
+					const auto &[ name, def ]= *found->option;
 					const auto &handler= def.handler;
-					std::optional< std::string > argument;
-					if( param == name ) argument= std::nullopt;
-					else if( param.starts_with( name ) and "=:"s.find( param.at( name.size() ) ) != std::string::npos )
-					{
-						argument= param.substr( name.size() + 1 );
-					}
-					else continue;
+					const auto &argument= found->argument;
 
 					// Skip options that do not affect help, when we're doing a `--help` run.
 					if( helpRequested and not def.domains.contains( typeid( PreHelpDomain ) ) ) return true;
@@ -392,21 +668,21 @@ namespace Alepha::Cavorite  ::detail::  program_options
 			};
 			if( C::debugMatching and not matched ) error() << "No match for `" << param << "` was found." << std::endl;
 			if( matched ) continue;
-			rv.push_back( param );
+			rv.emplace_back( param );
 
 			if( param.starts_with( "--" ) )
 			{
 				// TODO: 
-				throw std::runtime_error( "`" + param + "` is an unrecognized option." );
+				throw std::runtime_error( "`" + std::string{ param } + "` is an unrecognized option." );
 			}
 		}
 		catch( const OptionMissingArgumentError &e )
 		{
 			if( next == end( argsToProcess ) or next->starts_with( "--" ) ) throw;
-			throw std::runtime_error( e.what() + " did you mean: `"s + param + "=" + *next + "`?" );
+			throw std::runtime_error( e.what() + " did you mean: `"s + std::string{ param } + "=" + std::string{ *next } + "`?" );
 		}
 
-		if( endOfArgs != end( args ) ) std::copy( endOfArgs + 1, end( args ), back_inserter( rv ) );
+		if( endOfArgs != end( allArgs ) ) rv.insert( end( rv ), endOfArgs + 1, end( allArgs ) );
 
 		if( helpRequested ) programOptions().at( "--help" ).handler( std::nullopt );
 
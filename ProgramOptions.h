@@ -9,10 +9,12 @@ static_assert( __cplusplus > 2020'00 );
  * The `Alepha::program_options` namespace defines a simple DSEL for adding commandline options
  * to a program.  Options are defined using `--"name"_option` operations and then "streaming"
  * an option handler into the option name, followed by streaming in any help text.  The result
- * type of `operator <<` between an option name and a handler is a `std::ostream &` which can
- * be used to build the option help string.  The help text can use a variable-expansion feature
- * to allow for options help to be dynamically kept in sync with program development.  The
- * variables `"!program-name!"` or `"!option-name!"` will expand to the text one would expect.
+ * type of `operator <<` between an option name and a handler is a `HelpText &` which can
+ * be used to build the option help string.  Anything which can be written to a `std::ostream`
+ * can be written to a `HelpText`, but it is only formatted if `--help` is passed.  The help
+ * text can use a variable-expansion feature to allow for options help to be dynamically kept
+ * in sync with program development.  The variables `"!program-name!"` or `"!option-name!"`
+ * will expand to the text one would expect.
  * The variable `"!default!"` will expand to an example usage which initializes the option
  * as-if the option were never passed.
  *
@@ -27,7 +29,13 @@ static_assert( __cplusplus > 2020'00 );
  *
  * If a `std::vector< T >` variable is passed as an option handler, then each time the option
  * is encountered, its argument will be appended to that `std::vector`.  Parsing will use
- * `operator >> ( std::istream &, T & )`.
+ * `operator >> ( std::istream &, T & )`.  For integral `T`, each argument may be a comma separated list of
+ * integers and ranges, such as `1-5,7`, and every value in each range is appended.
+ *
+ * If an `Alepha::RangeSet< T >` variable is passed as an option handler, then the integers and ranges in
+ * each argument are added to that set, without expanding them.  This is the form to use when ranges may be
+ * large, such as `--ports=1-65535`.  A function taking a `RangeSet< T >` is handed the set parsed from
+ * each argument.
  *
  * If a single instance variable is passed as an option handler, then each time the option
  * is encountered, its argument will be parsed and replace the value stored in that variable.
@@ -43,6 +51,17 @@ static_assert( __cplusplus > 2020'00 );
  *
  * A `"--help"` and option and handler will be automatically generated.
  *
+ * An argument of the form `@file` is replaced by the arguments in that file, which are separated by
+ * whitespace, and may be quoted with `'` or `"`, or escaped with `\`.  Response files may name other
+ * response files.  The options in the environment variable named by `applicationName()` with `_OPTIONS`
+ * appended (such as `ALEPHA_OPTIONS`) are read the same way, and are processed before the command line.
+ * Response files are not expanded after a `--` argument.  The environment variable may not contain `--`
+ * (even from a response file), since it would end the options on the command line too; that is an error.  A
+ * response file which names itself, directly or through others, is an error.
+ *
+ * An option may be abbreviated to any prefix of its name which no other option shares, so `--proc=x` will
+ * work for `--process-file=x`, until some `--proc...` option is added.  An ambiguous abbreviation is an error.
+ *
  * Example:
  *
  * ```
@@ -80,16 +99,24 @@ static_assert( __cplusplus > 2020'00 );
 
 #include <Alepha/Alepha.h>
 
+#include <cstddef>
+
 #include <string>
+#include <string_view>
 #include <typeindex>
 #include <exception>
 #include <stdexcept>
 #include <optional>
+#include <functional>
+#include <ostream>
+#include <type_traits>
+#include <variant>
 #include <vector>
 
 #include <boost/lexical_cast.hpp>
 
 #include <Alepha/Concepts.h>
+#include <Alepha/RangeSet.h>
 #include <Alepha/string_algorithms.h>
 
 #include <Alepha/IOStreams/String.h>
@@ -182,6 +209,67 @@ namespace Alepha::inline Cavorite  ::detail::  program_options
 		void checkArgument( const std::optional< std::string > &opt, const std::string &name );
 	}
 
+	/*!
+	 * The help text of an option, held as written, and only formatted when the help is printed.
+	 *
+	 * Options are defined during static initialization, in every linked library, but their help is almost
+	 * never printed.  So string literals are held by reference, other strings are copied, and anything else is
+	 * held by value, to be written out to a stream later.
+	 *
+	 * @note A `const char` array is taken to be a string literal, and is held by reference.  A writable `char`
+	 * array is copied, as is a `std::string` or a `const char *`, so text in a local buffer is safe.
+	 */
+	class HelpText
+	{
+		private:
+			using Segment= std::variant< std::string_view, std::string, std::function< void ( std::ostream & ) > >;
+
+			std::vector< Segment > segments;
+
+		public:
+			// String literals.
+			template< std::size_t size >
+			HelpText &
+			operator << ( const char (&literal)[ size ] )
+			{
+				segments.emplace_back( std::string_view{ literal } );
+				return *this;
+			}
+
+			// A writable buffer may change before the help is printed.
+			template< std::size_t size >
+			HelpText &
+			operator << ( char (&buffer)[ size ] )
+			{
+				segments.emplace_back( std::string{ buffer } );
+				return *this;
+			}
+
+			template< typename T >
+			HelpText &
+			operator << ( const T &value )
+			{
+				if constexpr( std::is_convertible_v< const T &, std::string_view > )
+				{
+					segments.emplace_back( std::string{ std::string_view{ value } } );
+				}
+				else segments.emplace_back( std::function< void ( std::ostream & ) >{ [value]( std::ostream &os ) { os << value; } } );
+
+				return *this;
+			}
+
+			// Manipulators, such as `std::endl`.
+			HelpText &
+			operator << ( std::ostream &(*const manipulator)( std::ostream & ) )
+			{
+				segments.emplace_back( std::function< void ( std::ostream & ) >{ manipulator } );
+				return *this;
+			}
+
+			// Format the text.
+			std::string str() const;
+	};
+
 	class OptionBinding
 	{
 		public:
@@ -190,7 +278,7 @@ namespace Alepha::inline Cavorite  ::detail::  program_options
 
 			// The `operator <<` forms are used to define options.
 			// These are not `std::ostream` operators directly,
-			// except that the end of a chain will return the `std::ostream`
+			// except that the end of a chain will return the `HelpText`
 			// object used to construct the help for that option.
 
 		private:
@@ -199,7 +287,7 @@ namespace Alepha::inline Cavorite  ::detail::  program_options
 			const auto &self() const { return *this; }
 
 			using option_handler= std::function< void ( std::optional< std::string > ) >;
-			[[nodiscard]] std::ostream &registerHandler( option_handler handler ) const;
+			[[nodiscard]] HelpText &registerHandler( option_handler handler ) const;
 
 			void setDefaultBuilder( std::function< std::string () > ) const;
 
@@ -214,15 +302,15 @@ namespace Alepha::inline Cavorite  ::detail::  program_options
 			}
 
 			// This installs a custom handler that has to do its own string parsing.
-			[[nodiscard]] std::ostream &operator << ( std::function< void ( std::string ) > core ) const;
+			[[nodiscard]] HelpText &operator << ( std::function< void ( std::string ) > core ) const;
 
 			// This installs a custom handler that takes no arguments.
-			[[nodiscard]] std::ostream &operator << ( std::function< void () > core ) const;
+			[[nodiscard]] HelpText &operator << ( std::function< void () > core ) const;
 
 			// Handler generator -- parses the string arguments in an option and puts the at the end of the
 			// specified `vector`.
 			template< typename T >
-			[[nodiscard]] std::ostream &
+			[[nodiscard]] HelpText &
 			operator << ( std::vector< T > &list ) const
 			{
 				return self() << [&list, name= name]( const std::string param )
@@ -232,7 +320,7 @@ namespace Alepha::inline Cavorite  ::detail::  program_options
 						if constexpr( Integral< T > )
 						{
 							const auto parsedRange= parseRange< T >( argumentFromString< std::string >( datum, name, name + "=" + param ) );
-							list.insert( back( list ), begin( parsedRange ), end( parsedRange ) );
+							list.insert( end( list ), begin( parsedRange ), end( parsedRange ) );
 						}
 						else
 						{
@@ -242,10 +330,19 @@ namespace Alepha::inline Cavorite  ::detail::  program_options
 				};
 			}
 
+			// Handler generator -- parses the integers and ranges in an option's argument and adds them to the
+			// specified `RangeSet`, without expanding them.
+			template< typename T >
+			[[nodiscard]] HelpText &
+			operator << ( RangeSet< T > &set ) const
+			{
+				return self() << [&set]( const RangeSet< T > parsed ) { set.insert( parsed ); };
+			}
+
 			// Handler generator -- This builds a parser for the specified value, and installs the value to an optional
 			// when the option and its argument are seen.
 			template< typename T >
-			[[nodiscard]] std::ostream &
+			[[nodiscard]] HelpText &
 			operator << ( std::optional< T > &value ) const
 			{
 				return self() << [&value, name= name]( const std::string datum )
@@ -256,10 +353,10 @@ namespace Alepha::inline Cavorite  ::detail::  program_options
 
 			// Boolean flag options are a special case of the value-binding system.
 			// They generate `--no-` forms of the option as well.
-			std::ostream &operator << ( bool &flag ) const;
+			HelpText &operator << ( bool &flag ) const;
 
 			template< NotFunctional T >
-			[[nodiscard]] std::ostream &
+			[[nodiscard]] HelpText &
 			operator << ( T &value ) const
 			{
 				// This is used in help generation to print out the "default" value chosen by the programmer, by referencing the
@@ -281,7 +378,7 @@ namespace Alepha::inline Cavorite  ::detail::  program_options
 				};
 			}
 
-			[[nodiscard]] std::ostream &
+			[[nodiscard]] HelpText &
 			operator << ( UnaryFunction auto handler ) const
 			{
 				using arg_type= get_arg_t< std::decay_t< decltype( handler ) >, 0 >;
@@ -303,7 +400,7 @@ namespace Alepha::inline Cavorite  ::detail::  program_options
 								{
 									const auto parsedRange= parseRange< parse_type >( argumentFromString< std::string >( value, name,
 											name + "=" + argument.value() ) );
-									rv.insert( back( rv ), begin( parsedRange ), end( parsedRange ) );
+									rv.insert( end( rv ), begin( parsedRange ), end( parsedRange ) );
 								}
 								else rv.push_back( argumentFromString< parse_type >( value, name, name + "=" + argument.value() ) );
 							}
@@ -313,6 +410,29 @@ namespace Alepha::inline Cavorite  ::detail::  program_options
 					};
 					return registerHandler( handler );
 				}
+				else if constexpr( SpecializationOf< arg_type, RangeSet > )
+				{
+					using parse_type= typename arg_type::value_type;
+					auto wrapped= [handler, name= name]( std::optional< std::string > argument )
+					{
+						impl::checkArgument( argument, name );
+
+						const auto parsed= evaluate <=[&]
+						{
+							try
+							{
+								return parseRangeSet< parse_type >( argument.value() );
+							}
+							catch( const std::exception &ex )
+							{
+								throw std::runtime_error( "Error parsing option `" + name + "`, with parameter string: `"
+										+ argument.value() + "` (" + ex.what() + ")" );
+							}
+						};
+						handler( parsed );
+					};
+					return registerHandler( wrapped );
+				}
 				else
 				{
 					auto wrapped= [handler, name= name]( std::optional< std::string > argument )
@@ -351,6 +471,10 @@ namespace Alepha::inline Cavorite  ::detail::  program_options
 	{
 		[[noreturn]] void usage( const std::string &, const std::optional< std::string > & );
 		[[nodiscard]] std::vector< std::string > handleOptions( const std::vector< std::string > &, std::function< void () > );
+
+		// Everything `handleOptions` does after defining `--help`: the arguments are matched to the options
+		// defined so far, and their handlers are run.  (This can be run more than once, as the tests do.)
+		[[nodiscard]] std::vector< std::string > processOptions( const std::vector< std::string > & );
 	}
 
 	template< typename Supplement >
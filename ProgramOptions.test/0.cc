@@ -0,0 +1,240 @@
+static_assert( __cplusplus > 2020'00 );
+
+#include "../ProgramOptions.h"
+
+#include <cstdlib>
+
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <Alepha/Console.h>
+#include <Alepha/RangeSet.h>
+
+#include <Alepha/Testing/test.h>
+#include <Alepha/Utility/evaluation_helpers.h>
+
+namespace
+{
+	using namespace Alepha::literals::option_literals;
+	using namespace Alepha::Utility::exports::evaluation_helpers;
+
+	// The test program's `main` has already handled its options, and defined `--help` as it did.  These tests
+	// handle more, without defining it again.
+	using Alepha::Cavorite::detail::program_options::impl::processOptions;
+
+	int widgetCount= 0;
+	std::string widgetColour;
+	bool widgetVerbose= false;
+	std::vector< int > widgetValues;
+	Alepha::RangeSet< int > widgetPorts;
+	std::vector< std::string > widgetNames;
+
+	char helpBuffer[ 16 ]= "buffered";
+	std::string helpText;
+
+	auto init= enroll <=[]
+	{
+		--"widget-count"_option << widgetCount << "How many widgets.";
+		--"widget-colour"_option << widgetColour << "The colour of the widgets.";
+		--"widget-verbose"_option << widgetVerbose << "Describe the widgets.";
+		--"widget-value"_option << widgetValues << "Add values.";
+		--"widget-ports"_option << widgetPorts << "Add ports.";
+		--"widget-name"_option << widgetNames << "Add a name.";
+
+		const int limit= 7;
+		auto &help= --"widget-help"_option << []{} << "Literal, " << helpBuffer << ", " << std::string{ "string" } << ", " << limit;
+		helpBuffer[ 0 ]= 'X';
+		helpText= help.str();
+	};
+
+	void
+	reset()
+	{
+		widgetCount= 0;
+		widgetColour.clear();
+		widgetVerbose= false;
+		widgetValues.clear();
+		widgetPorts= {};
+		widgetNames.clear();
+	}
+
+	// The message of the error which handling these arguments throws, if any.
+	std::optional< std::string >
+	errorFrom( const std::vector< std::string > &args )
+	{
+		try
+		{
+			std::ignore= processOptions( args );
+			return std::nullopt;
+		}
+		catch( const std::exception &ex )
+		{
+			return ex.what();
+		}
+	}
+
+	struct ResponseFile
+	{
+		std::string path= "/tmp/ProgramOptions.test.XXXXXX";
+
+		ResponseFile() { ::close( ::mkstemp( path.data() ) ); }
+		~ResponseFile() { ::unlink( path.c_str() ); }
+
+		void write( const std::string &contents ) const { std::ofstream{ path } << contents; }
+
+		std::string argument() const { return '@' + path; }
+	};
+
+	// Sets the application's options variable, for as long as this lives.
+	struct OptionsVariable
+	{
+		std::string name= Alepha::applicationName() + "_OPTIONS";
+
+		explicit OptionsVariable( const std::string &value ) { ::setenv( name.c_str(), value.c_str(), true ); }
+		~OptionsVariable() { ::unsetenv( name.c_str() ); }
+	};
+}
+
+static auto tests= enroll <=[]
+{
+	using namespace Alepha::Testing::exports::literals;
+	using Alepha::Testing::exports::TestState;
+
+	"Options are matched by name, with `=` arguments, and the rest are returned."_test <=[]( TestState test )
+	{
+		reset();
+		const auto rest= processOptions( { "--widget-count=3", "first", "--widget-colour=blue", "--", "--widget-count=4" } );
+		test.expect( widgetCount == 3 );
+		test.expect( widgetColour == "blue" );
+		test.expect( rest == std::vector< std::string >{ "first", "--widget-count=4" } );
+	};
+
+	"A unique prefix abbreviates an option, and an ambiguous one is an error."_test <=[]( TestState test )
+	{
+		reset();
+		std::ignore= processOptions( { "--widget-cou=5", "--widget-verb" } );
+		test.expect( widgetCount == 5 );
+		test.expect( widgetVerbose );
+
+		const auto error= errorFrom( { "--widget-c=5" } );
+		test.expect( error.has_value() and error->find( "ambiguous" ) != std::string::npos );
+		test.expect( error.has_value() and error->find( "`--widget-colour`" ) != std::string::npos );
+		test.expect( error.has_value() and error->find( "`--widget-count`" ) != std::string::npos );
+
+		test.expect( errorFrom( { "--widget-unknown" } ).has_value() );
+	};
+
+	"A flag's `--no-` form clears it, and options apply from left to right."_test <=[]( TestState test )
+	{
+		reset();
+		std::ignore= processOptions( { "--widget-verbose", "--no-widget-verbose" } );
+		test.expect( not widgetVerbose );
+
+		std::ignore= processOptions( { "--no-widget-verbose", "--widget-verbose" } );
+		test.expect( widgetVerbose );
+
+		test.expect( errorFrom( { "--widget-verbose=yes" } ).has_value() );
+	};
+
+	"Ranges go into a vector expanded, and into a RangeSet as they are."_test <=[]( TestState test )
+	{
+		reset();
+		std::ignore= processOptions( { "--widget-value=1-3,7", "--widget-ports=1-100000000", "--widget-ports=200000000" } );
+		test.expect( widgetValues == std::vector{ 1, 2, 3, 7 } );
+		test.expect( widgetPorts.intervals().size() == 2 );
+		test.expect( widgetPorts.size() == 100'000'001 );
+		test.expect( widgetPorts.contains( 54'321 ) and widgetPorts.contains( 200'000'000 ) );
+
+		test.expect( errorFrom( { "--widget-ports=5-3" } ).has_value() );
+	};
+
+	"Response files are split on whitespace, with quotes and escapes, and may nest."_test <=[]( TestState test )
+	{
+		reset();
+		const ResponseFile inner;
+		inner.write( "--widget-count=9\n" );
+		const ResponseFile outer;
+		outer.write( "--widget-name='two  words' \"--widget-name=say \\\"hi\\\"\"\n--widget-name=back\\ slash " + inner.argument() + " rest" );
+
+		const auto rest= processOptions( { outer.argument(), "--", inner.argument() } );
+		test.expect( widgetNames == std::vector< std::string >{ "two  words", "say \"hi\"", "back slash" } );
+		test.expect( widgetCount == 9 );
+		test.expect( rest == std::vector< std::string >{ "rest", inner.argument() } );
+	};
+
+	"A response file which includes itself is an error, as is an unterminated quote."_test <=[]( TestState test )
+	{
+		const ResponseFile self;
+		self.write( "--widget-count=1 " + self.argument() );
+		const auto selfError= errorFrom( { self.argument() } );
+		test.expect( selfError.has_value() and selfError->find( "includes itself" ) != std::string::npos );
+
+		const ResponseFile first;
+		const ResponseFile second;
+		first.write( second.argument() );
+		second.write( first.argument() );
+		const auto cycleError= errorFrom( { first.argument() } );
+		test.expect( cycleError.has_value() and cycleError->find( "includes itself" ) != std::string::npos );
+
+		// The same file twice, but not within itself, is fine.
+		const ResponseFile twice;
+		twice.write( "--widget-name=again" );
+		reset();
+		test.expect( not errorFrom( { twice.argument(), twice.argument() } ) );
+		test.expect( widgetNames == std::vector< std::string >{ "again", "again" } );
+
+		const ResponseFile quoted;
+		quoted.write( "--widget-name='open" );
+		test.expect( errorFrom( { quoted.argument() } ).has_value() );
+	};
+
+	"Options from the environment come first."_test <=[]( TestState test )
+	{
+		reset();
+		const ResponseFile file;
+		file.write( "--widget-colour=red" );
+
+		const OptionsVariable variable{ "--widget-count=11 --widget-name=env" };
+		const auto rest= processOptions( { "--widget-count=12", file.argument(), "positional" } );
+		test.expect( widgetCount == 12 );
+		test.expect( widgetNames == std::vector< std::string >{ "env" } );
+		test.expect( widgetColour == "red" );
+		test.expect( rest == std::vector< std::string >{ "positional" } );
+	};
+
+	"A `--` in the environment, or in a response file named there, is an error."_test <=[]( TestState test )
+	{
+		const auto direct= evaluate <=[]
+		{
+			const OptionsVariable variable{ "--widget-count=11 -- --widget-name=literal" };
+			return errorFrom( {} );
+		};
+		test.expect( direct.has_value() and direct->find( "may not contain `--`" ) != std::string::npos );
+
+		const ResponseFile file;
+		file.write( "--widget-count=11 --" );
+		const auto viaFile= evaluate <=[&]
+		{
+			const OptionsVariable variable{ file.argument() };
+			return errorFrom( {} );
+		};
+		test.expect( viaFile.has_value() and viaFile->find( "may not contain `--`" ) != std::string::npos );
+
+		// On the command line, after the environment, it still ends the options.
+		reset();
+		const OptionsVariable variable{ "--widget-count=11" };
+		test.expect( processOptions( { "--", "--widget-name=literal" } ) == std::vector< std::string >{ "--widget-name=literal" } );
+		test.expect( widgetCount == 11 );
+		test.expect( widgetNames.empty() );
+	};
+
+	"Help text is only formatted when asked for, and copies writable buffers."_test <=[]( TestState test )
+	{
+		test.expect( helpText == "Literal, buffered, string, 7" );
+	};
+};
@@ -0,0 +1,195 @@
+static_assert( __cplusplus > 2020'00 );
+
+#pragma once
+
+#include <Alepha/Alepha.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <Alepha/Concepts.h>
+#include <Alepha/string_algorithms.h>
+
+namespace Alepha::Hydrogen  ::detail::  range_set
+{
+	inline namespace exports
+	{
+		template< typename T > class RangeSet;
+	}
+
+	/*!
+	 * A set of integers, held as sorted, disjoint intervals.
+	 *
+	 * This is a compact form of what `parseRange` expands.  A set of `1-100000000` is one interval, not a hundred
+	 * million values.  Inserting an interval merges it with any intervals it overlaps or touches.  Membership
+	 * is a binary search over the intervals.  Iteration visits each value, in ascending order.
+	 */
+	template< typename T >
+	class exports::RangeSet
+	{
+		static_assert( Integral< T > );
+
+		public:
+			using value_type= T;
+
+			// An inclusive interval, `[ low, high ]`.
+			struct Interval
+			{
+				T low;
+				T high;
+
+				friend bool operator == ( const Interval &, const Interval & )= default;
+			};
+
+		private:
+			std::vector< Interval > intervals_;
+
+		public:
+			class iterator
+			{
+				private:
+					using Position= typename std::vector< Interval >::const_iterator;
+
+					Position interval;
+					Position last;
+					T value{};
+
+					friend RangeSet;
+
+					explicit
+					iterator( const Position interval, const Position last ) noexcept
+						: interval( interval ), last( last ), value( interval == last ? T{} : interval->low )
+					{}
+
+				public:
+					using iterator_category= std::forward_iterator_tag;
+					using value_type= T;
+					using difference_type= std::ptrdiff_t;
+					using pointer= const T *;
+					using reference= T;
+
+					iterator()= default;
+
+					T operator *() const noexcept { return value; }
+
+					iterator &
+					operator ++() noexcept
+					{
+						// Comparing before incrementing avoids overflow at the top of `T`'s range.
+						if( value != interval->high ) ++value;
+						else if( ++interval != last ) value= interval->low;
+						else value= T{};
+
+						return *this;
+					}
+
+					iterator operator ++( int ) noexcept { auto rv= *this; ++*this; return rv; }
+
+					friend bool operator == ( const iterator &, const iterator & )= default;
+			};
+
+			RangeSet()= default;
+
+			/*!
+			 * Add every value in `[ low, high ]` to this set.
+			 *
+			 * @throws std::invalid_argument if `low` is greater than `high`.
+			 */
+			void
+			insert( T low, T high )
+			{
+				if( low > high ) throw std::invalid_argument( "A range's low bound must not exceed its high bound." );
+
+				// The first interval which could merge with the new one: it ends at (or just before) `low`, or later.
+				// (Each `+ 1` and `- 1` is only reached when it cannot overflow.)
+				auto first= std::lower_bound( intervals_.begin(), intervals_.end(), low,
+						[]( const Interval &interval, const T value ) { return interval.high < value and interval.high + 1 < value; } );
+
+				// One past the last interval which could merge: it starts at (or just after) `high`, or earlier.
+				auto last= first;
+				while( last != intervals_.end() and ( last->low <= high or last->low - 1 <= high ) ) ++last;
+
+				if( first != last )
+				{
+					low= std::min( low, first->low );
+					high= std::max( high, std::prev( last )->high );
+					first= intervals_.erase( first, last );
+				}
+				intervals_.insert( first, Interval{ low, high } );
+			}
+
+			void insert( const T value ) { insert( value, value ); }
+
+			void insert( const RangeSet &other ) { for( const auto &[ low, high ]: other.intervals_ ) insert( low, high ); }
+
+			bool
+			contains( const T value ) const noexcept
+			{
+				const auto found= std::lower_bound( intervals_.begin(), intervals_.end(), value,
+						[]( const Interval &interval, const T v ) { return interval.high < v; } );
+				return found != intervals_.end() and found->low <= value;
+			}
+
+			bool empty() const noexcept { return intervals_.empty(); }
+
+			// The number of values in the set.
+			std::uintmax_t
+			size() const noexcept
+			{
+				std::uintmax_t rv= 0;
+				using Unsigned= std::make_unsigned_t< T >;
+				for( const auto &[ low, high ]: intervals_ ) rv+= std::uintmax_t( Unsigned( Unsigned( high ) - Unsigned( low ) ) ) + 1;
+				return rv;
+			}
+
+			const std::vector< Interval > &intervals() const noexcept { return intervals_; }
+
+			iterator begin() const noexcept { return iterator{ intervals_.begin(), intervals_.end() }; }
+			iterator end() const noexcept { return iterator{ intervals_.end(), intervals_.end() }; }
+
+			// Every value in the set, in ascending order.  This costs memory in proportion to `size()`.
+			std::vector< T >
+			expand() const
+			{
+				std::vector< T > rv;
+				rv.reserve( size() );
+				std::copy( begin(), end(), back_inserter( rv ) );
+				return rv;
+			}
+
+			friend bool operator == ( const RangeSet &, const RangeSet & )= default;
+	};
+
+	namespace exports
+	{
+		/*!
+		 * Parses a comma separated list of integers and ranges (such as `"1-5,7,10-12"`) into a `RangeSet`.
+		 *
+		 * Each item has the form accepted by `parseRange`.
+		 */
+		template< Integral T >
+		RangeSet< T >
+		parseRangeSet( const std::string_view text )
+		{
+			RangeSet< T > rv;
+			for( const auto item: parseCommasView( text ) )
+			{
+				const auto [ low, high ]= parseInterval< T >( std::string{ item } );
+				rv.insert( low, high );
+			}
+			return rv;
+		}
+	}
+}
+
+namespace Alepha::Hydrogen::inline exports::inline range_set
+{
+	using namespace detail::range_set::exports;
+}
@@ -0,0 +1,85 @@
+static_assert( __cplusplus > 2020'00 );
+
+#include "../RangeSet.h"
+
+#include <limits>
+#include <stdexcept>
+
+#include <Alepha/Testing/test.h>
+#include <Alepha/Testing/TableTest.h>
+#include <Alepha/Utility/evaluation_helpers.h>
+
+namespace
+{
+	using namespace Alepha::Testing::literals::test_literals;
+	using Alepha::Testing::TableTest;
+	using Alepha::Testing::exports::TestState;
+
+	std::vector< int > expand( const std::string text ) { return Alepha::parseRangeSet< int >( text ).expand(); }
+
+	std::size_t intervalCount( const std::string text ) { return Alepha::parseRangeSet< int >( text ).intervals().size(); }
+}
+
+static auto init= Alepha::Utility::enroll <=[]
+{
+	"A parsed range expands to every value in it."_test <=TableTest< Alepha::parseRange< int > >::Cases
+	{
+		{ "Single value", { "7" }, { 7 } },
+		{ "Negative value", { "-3" }, { -3 } },
+		{ "Range", { "3-5" }, { 3, 4, 5 } },
+		{ "One-value range", { "4-4" }, { 4 } },
+	};
+
+	"A reversed range is an error."_test <=TableTest< Alepha::parseRange< int > >::ExceptionCases
+	{
+		{ "Reversed", { "5-3" }, std::type_identity< std::runtime_error >{} },
+		{ "Forward", { "3-5" }, std::nothrow },
+	};
+
+	"Overlapping and adjacent ranges merge."_test <=TableTest< intervalCount >::Cases
+	{
+		{ "Disjoint", { "1-3,5-7" }, 2 },
+		{ "Adjacent", { "1-3,4-7" }, 1 },
+		{ "Overlapping", { "1-5,3-7" }, 1 },
+		{ "Out of order", { "10-12,1-2,3-4" }, 2 },
+		{ "Bridged", { "1-2,8-9,3-7" }, 1 },
+	};
+
+	"A set iterates over its values in order."_test <=TableTest< expand >::Cases
+	{
+		{ "Single value", { "4" }, { 4 } },
+		{ "Mixed", { "9,1-3,5" }, { 1, 2, 3, 5, 9 } },
+		{ "Duplicates", { "2,2,1-3" }, { 1, 2, 3 } },
+	};
+
+	"A huge range is held without expanding it."_test <=[]( TestState test )
+	{
+		const auto set= Alepha::parseRangeSet< int >( "1-100000000" );
+		test.expect( set.intervals().size() == 1 );
+		test.expect( set.size() == 100'000'000 );
+		test.expect( set.contains( 1 ) );
+		test.expect( set.contains( 54'321'987 ) );
+		test.expect( set.contains( 100'000'000 ) );
+		test.expect( not set.contains( 0 ) );
+		test.expect( not set.contains( 100'000'001 ) );
+	};
+
+	"Ranges at the limits of the type do not overflow."_test <=[]( TestState test )
+	{
+		using limits= std::numeric_limits< unsigned char >;
+		Alepha::RangeSet< unsigned char > set;
+		set.insert( limits::max() - 1, limits::max() );
+		set.insert( limits::min(), limits::min() + 1 );
+		set.insert( limits::max() );
+		test.expect( set.intervals().size() == 2 );
+		test.expect( set.size() == 4 );
+
+		set.insert( limits::min(), limits::max() );
+		test.expect( set.intervals().size() == 1 );
+		test.expect( set.size() == 256 );
+
+		std::size_t count= 0;
+		for( [[maybe_unused]] const auto value: set ) ++count;
+		test.expect( count == 256 );
+	};
+};
@@ -96,10 +96,16 @@ namespace Alepha::Hydrogen::Utility::detail::stackable_streambuf
 		return 1;
 	}
 
+	void
+	StackableStreambuf::writeChunk( const std::string_view chunk )
+	{
+		for( const char ch: chunk ) writeChar( ch );
+	}
+
 	std::streamsize
 	StackableStreambuf::xsputn( const char *const data, const std::streamsize amt )
 	{
-		for( std::streamsize i= 0; i< amt; ++i ) overflow( data[ i ] );
+		writeChunk( { data, std::size_t( amt ) } );
 		return amt;
 	}
 }
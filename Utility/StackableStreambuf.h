@@ -9,6 +9,7 @@ static_assert( __cplusplus > 2020'00 );
 #include <stdexcept>
 #include <memory>
 #include <stack>
+#include <string_view>
 
 namespace Alepha::Hydrogen::Utility  ::detail::  stackable_streambuf
 {
@@ -37,6 +38,14 @@ namespace Alepha::Hydrogen::Utility  ::detail::  stackable_streambuf
 			virtual void writeChar( char ch )= 0;
 			virtual void drain()= 0;
 
+			/*!
+			 * Write a whole run of characters.
+			 *
+			 * All multi-character writes to the stream arrive here, in one call.  The default writes each
+			 * character with `writeChar`; children should override this to scan the run as a whole.
+			 */
+			virtual void writeChunk( std::string_view chunk );
+
 			int overflow( const int ch ) override;
 
 			std::streamsize xsputn( const char *data, std::streamsize amt ) override;
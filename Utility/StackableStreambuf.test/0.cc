@@ -14,6 +14,7 @@ namespace
 {
 	using namespace Alepha::Testing::literals::test_literals;;
 	using Alepha::Testing::TableTest;
+	using Alepha::Testing::exports::TestState;
 }
 
 static auto init= Alepha::Utility::enroll <=[]
@@ -36,4 +37,21 @@ static auto init= Alepha::Utility::enroll <=[]
 		std::cout << oss.str() << std::flush;
 		assert( oss.str() == "First wrapping\nSecond \nwrapping\nThird wrapping more \nthan 20\n" );
 	};
+
+	"Chunked writes match character-at-a-time writes through stacked streambufs."_test <=[]( TestState test )
+	{
+		const std::string text= "A line of text which will need wrapping twice over.\nAnd another.\n";
+
+		std::ostringstream chunked;
+		chunked << Alepha::StartWrap{ 20 } << Alepha::StartWrap{ 12, 2 };
+		chunked << text;
+		chunked << Alepha::EndWrap << Alepha::EndWrap;
+
+		std::ostringstream single;
+		single << Alepha::StartWrap{ 20 } << Alepha::StartWrap{ 12, 2 };
+		for( const char ch: text ) single.put( ch );
+		single << Alepha::EndWrap << Alepha::EndWrap;
+
+		test.expect( chunked.str() == single.str() );
+	};
 };
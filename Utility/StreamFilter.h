@@ -0,0 +1,126 @@
+static_assert( __cplusplus > 2020'00 );
+
+#pragma once
+
+#include <Alepha/Alepha.h>
+
+#include <cstddef>
+
+#include <ostream>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include <Alepha/Utility/StackableStreambuf.h>
+
+namespace Alepha::Hydrogen::Utility  ::detail::  stream_filter
+{
+	inline namespace exports
+	{
+		/*!
+		 * A text filter which can be fused into a `FilterStreambuf` pipeline.
+		 *
+		 * A filter is handed its input a span at a time, by `filter( text, sink )`, and passes its output on by
+		 * calling `sink( std::string_view )` as often as it likes (including not at all).  When the pipeline is
+		 * popped, `drain( sink )` is called, to flush whatever the filter was holding back.
+		 *
+		 * The sink is a template parameter, so each stage calls the next one directly, with no virtual dispatch.
+		 */
+		template< typename Filter >
+		concept StreamFilter= requires( Filter &filter, const std::string_view text, void (&sink)( std::string_view ) )
+		{
+			filter.filter( text, sink );
+			filter.drain( sink );
+		};
+
+		template< StreamFilter ... Filters > class FilterStreambuf;
+
+		template< StreamFilter ... Filters >
+		struct Pipeline_params
+		{
+			std::tuple< Filters... > filters;
+
+			explicit Pipeline_params( Filters ... filters ) : filters( std::move( filters )... ) {}
+		};
+
+		template< StreamFilter ... Filters >
+		using StartPipeline= PushStack< Pipeline_params< Filters... > >;
+
+		constexpr PopStack EndPipeline;
+
+		/*!
+		 * Build a pipeline of filters, to be pushed onto a stream.
+		 *
+		 * Text written to the stream passes through the filters in the order given here, so
+		 * `os << pipeline( a, b )` behaves like `os << StartB << StartA` would, for stackable equivalents of
+		 * `a` and `b`.  Pop the pipeline with `EndPipeline`.
+		 */
+		template< StreamFilter ... Filters >
+		StartPipeline< Filters... >
+		pipeline( Filters ... filters )
+		{
+			return StartPipeline< Filters... >{ std::move( filters )... };
+		}
+	}
+
+	/*!
+	 * A single stackable streambuf which runs text through a fixed sequence of filters.
+	 *
+	 * Each write to the stream is handed to the first filter as one chunk, and every stage calls the next one
+	 * directly.  Stacking the same filters as separate `StackableStreambuf` layers would instead pass each
+	 * chunk down through a virtual `sputn` call per layer.
+	 */
+	template< StreamFilter ... Filters >
+	class exports::FilterStreambuf
+		: public StackableStreambuf
+	{
+		private:
+			std::tuple< Filters... > filters;
+
+			template< std::size_t index >
+			void
+			run( const std::string_view text )
+			{
+				if constexpr( index == sizeof...( Filters ) ) underlying->sputn( text.data(), text.size() );
+				else std::get< index >( filters ).filter( text, [this]( const std::string_view out ) { run< index + 1 >( out ); } );
+			}
+
+			template< std::size_t index >
+			void
+			flush()
+			{
+				if constexpr( index < sizeof...( Filters ) )
+				{
+					std::get< index >( filters ).drain( [this]( const std::string_view out ) { run< index + 1 >( out ); } );
+					flush< index + 1 >();
+				}
+			}
+
+		public:
+			explicit
+			FilterStreambuf( std::ostream &os, std::tuple< Filters... > &&filters )
+				: StackableStreambuf( os ), filters( std::move( filters ) )
+			{}
+
+			void writeChar( const char ch ) override { run< 0 >( { &ch, 1 } ); }
+
+			void writeChunk( const std::string_view chunk ) override { run< 0 >( chunk ); }
+
+			void drain() override { flush< 0 >(); }
+	};
+
+	inline namespace impl
+	{
+		template< StreamFilter ... Filters >
+		void
+		build_streambuf( std::ostream &os, StartPipeline< Filters... > &&params )
+		{
+			new FilterStreambuf< Filters... >( os, std::move( params.filters ) );
+		}
+	}
+}
+
+namespace Alepha::Hydrogen::Utility::inline exports::inline stream_filter
+{
+	using namespace detail::stream_filter::exports;
+}
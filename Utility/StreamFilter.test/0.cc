@@ -0,0 +1,69 @@
+static_assert( __cplusplus > 2020'00 );
+
+#include "../StreamFilter.h"
+
+#include <sstream>
+#include <stdexcept>
+
+#include <Alepha/Testing/test.h>
+#include <Alepha/Utility/evaluation_helpers.h>
+
+#include <Alepha/word_wrap.h>
+#include <Alepha/string_algorithms.h>
+
+namespace
+{
+	using namespace Alepha::Testing::literals::test_literals;
+	using Alepha::Testing::exports::TestState;
+	using Alepha::Utility::exports::lambaste;
+
+	const Alepha::VariableMap variables{ { "name", lambaste<="world" }, { "long", lambaste<="a rather long value" } };
+	const std::string text= "Hello !name!, this is !long! which wraps.\nAnd a second line, !!escaped!!.\n";
+}
+
+static auto init= Alepha::Utility::enroll <=[]
+{
+	"A fused pipeline matches the equivalent stacked streambufs."_test <=[]( TestState test )
+	{
+		std::ostringstream stacked;
+		stacked << Alepha::StartWrap{ 16, 2 } << Alepha::StartSubstitutions{ '!', variables };
+		stacked << text;
+		stacked << Alepha::EndSubstitutions << Alepha::EndWrap;
+
+		std::ostringstream fused;
+		fused << Alepha::Utility::pipeline( Alepha::SubstitutionFilter{ '!', variables }, Alepha::WordWrapFilter{ 16, 2 } );
+		fused << text;
+		fused << Alepha::Utility::EndPipeline;
+
+		test.expect( fused.str() == stacked.str() );
+	};
+
+	"Pipelines can be fed a character at a time."_test <=[]( TestState test )
+	{
+		std::ostringstream whole;
+		whole << Alepha::Utility::pipeline( Alepha::WordWrapFilter{ 10 } ) << text << Alepha::Utility::EndPipeline;
+
+		std::ostringstream pieces;
+		pieces << Alepha::Utility::pipeline( Alepha::WordWrapFilter{ 10 } );
+		for( const char ch: text ) pieces.put( ch );
+		pieces << Alepha::Utility::EndPipeline;
+
+		test.expect( pieces.str() == whole.str() );
+	};
+
+	"An unterminated variable is reported when the pipeline is popped."_test <=[]( TestState test )
+	{
+		std::ostringstream oss;
+		oss << Alepha::Utility::pipeline( Alepha::SubstitutionFilter{ '!', variables } ) << "Hello !name";
+		bool thrown= false;
+		try
+		{
+			oss << Alepha::Utility::EndPipeline;
+		}
+		catch( const std::runtime_error & )
+		{
+			thrown= true;
+		}
+		test.expect( thrown );
+	};
+};
@@ -0,0 +1,37 @@
+static_assert( __cplusplus > 2020'00 );
+
+#pragma once
+
+#include <Alepha/Alepha.h>
+
+#include <cstdlib>
+
+#include <iostream>
+#include <source_location>
+
+namespace Alepha::inline Cavorite  ::detail::  assertions
+{
+	inline namespace exports
+	{
+		/*!
+		 * Check an invariant which must hold in every build.
+		 *
+		 * Unlike `assert`, this is not compiled out by `NDEBUG`.  A violated invariant is reported, with its
+		 * location, and the program is aborted -- it is a bug, not an error to be handled.
+		 */
+		constexpr void
+		assertion( const bool condition, const std::source_location location= std::source_location::current() ) noexcept
+		{
+			if( condition ) return;
+
+			std::cerr << location.file_name() << ':' << location.line() << ": Assertion failed in `"
+					<< location.function_name() << "`." << std::endl;
+			std::abort();
+		}
+	}
+}
+
+namespace Alepha::Cavorite::inline exports::inline assertions
+{
+	using namespace detail::assertions::exports;
+}
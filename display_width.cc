@@ -0,0 +1,430 @@
+static_assert( __cplusplus > 2020'00 );
+
+#include "display_width.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+
+namespace Alepha::Hydrogen  ::detail::  display_width_m
+{
+	namespace
+	{
+		struct Range
+		{
+			char32_t first;
+			char32_t last;
+		};
+
+		// Generated by `display_width_tables.py`, from Unicode 14.0.0.
+
+		// Combining marks, and other characters which occupy no column of their own.
+		constexpr std::array zeroWidth
+		{
+			Range{ 0x0300, 0x036F }, Range{ 0x0483, 0x0489 }, Range{ 0x0591, 0x05BD }, Range{ 0x05BF, 0x05BF },
+			Range{ 0x05C1, 0x05C2 }, Range{ 0x05C4, 0x05C5 }, Range{ 0x05C7, 0x05C7 }, Range{ 0x0600, 0x0605 },
+			Range{ 0x0610, 0x061A }, Range{ 0x061C, 0x061C }, Range{ 0x064B, 0x065F }, Range{ 0x0670, 0x0670 },
+			Range{ 0x06D6, 0x06DD }, Range{ 0x06DF, 0x06E4 }, Range{ 0x06E7, 0x06E8 }, Range{ 0x06EA, 0x06ED },
+			Range{ 0x070F, 0x070F }, Range{ 0x0711, 0x0711 }, Range{ 0x0730, 0x074A }, Range{ 0x07A6, 0x07B0 },
+			Range{ 0x07EB, 0x07F3 }, Range{ 0x07FD, 0x07FD }, Range{ 0x0816, 0x0819 }, Range{ 0x081B, 0x0823 },
+			Range{ 0x0825, 0x0827 }, Range{ 0x0829, 0x082D }, Range{ 0x0859, 0x085B }, Range{ 0x0890, 0x0891 },
+			Range{ 0x0898, 0x089F }, Range{ 0x08CA, 0x0902 }, Range{ 0x093A, 0x093A }, Range{ 0x093C, 0x093C },
+			Range{ 0x0941, 0x0948 }, Range{ 0x094D, 0x094D }, Range{ 0x0951, 0x0957 }, Range{ 0x0962, 0x0963 },
+			Range{ 0x0981, 0x0981 }, Range{ 0x09BC, 0x09BC }, Range{ 0x09C1, 0x09C4 }, Range{ 0x09CD, 0x09CD },
+			Range{ 0x09E2, 0x09E3 }, Range{ 0x09FE, 0x09FE }, Range{ 0x0A01, 0x0A02 }, Range{ 0x0A3C, 0x0A3C },
+			Range{ 0x0A41, 0x0A42 }, Range{ 0x0A47, 0x0A48 }, Range{ 0x0A4B, 0x0A4D }, Range{ 0x0A51, 0x0A51 },
+			Range{ 0x0A70, 0x0A71 }, Range{ 0x0A75, 0x0A75 }, Range{ 0x0A81, 0x0A82 }, Range{ 0x0ABC, 0x0ABC },
+			Range{ 0x0AC1, 0x0AC5 }, Range{ 0x0AC7, 0x0AC8 }, Range{ 0x0ACD, 0x0ACD }, Range{ 0x0AE2, 0x0AE3 },
+			Range{ 0x0AFA, 0x0AFF }, Range{ 0x0B01, 0x0B01 }, Range{ 0x0B3C, 0x0B3C }, Range{ 0x0B3F, 0x0B3F },
+			Range{ 0x0B41, 0x0B44 }, Range{ 0x0B4D, 0x0B4D }, Range{ 0x0B55, 0x0B56 }, Range{ 0x0B62, 0x0B63 },
+			Range{ 0x0B82, 0x0B82 }, Range{ 0x0BC0, 0x0BC0 }, Range{ 0x0BCD, 0x0BCD }, Range{ 0x0C00, 0x0C00 },
+			Range{ 0x0C04, 0x0C04 }, Range{ 0x0C3C, 0x0C3C }, Range{ 0x0C3E, 0x0C40 }, Range{ 0x0C46, 0x0C48 },
+			Range{ 0x0C4A, 0x0C4D }, Range{ 0x0C55, 0x0C56 }, Range{ 0x0C62, 0x0C63 }, Range{ 0x0C81, 0x0C81 },
+			Range{ 0x0CBC, 0x0CBC }, Range{ 0x0CBF, 0x0CBF }, Range{ 0x0CC6, 0x0CC6 }, Range{ 0x0CCC, 0x0CCD },
+			Range{ 0x0CE2, 0x0CE3 }, Range{ 0x0D00, 0x0D01 }, Range{ 0x0D3B, 0x0D3C }, Range{ 0x0D41, 0x0D44 },
+			Range{ 0x0D4D, 0x0D4D }, Range{ 0x0D62, 0x0D63 }, Range{ 0x0D81, 0x0D81 }, Range{ 0x0DCA, 0x0DCA },
+			Range{ 0x0DD2, 0x0DD4 }, Range{ 0x0DD6, 0x0DD6 }, Range{ 0x0E31, 0x0E31 }, Range{ 0x0E34, 0x0E3A },
+			Range{ 0x0E47, 0x0E4E }, Range{ 0x0EB1, 0x0EB1 }, Range{ 0x0EB4, 0x0EBC }, Range{ 0x0EC8, 0x0ECD },
+			Range{ 0x0F18, 0x0F19 }, Range{ 0x0F35, 0x0F35 }, Range{ 0x0F37, 0x0F37 }, Range{ 0x0F39, 0x0F39 },
+			Range{ 0x0F71, 0x0F7E }, Range{ 0x0F80, 0x0F84 }, Range{ 0x0F86, 0x0F87 }, Range{ 0x0F8D, 0x0F97 },
+			Range{ 0x0F99, 0x0FBC }, Range{ 0x0FC6, 0x0FC6 }, Range{ 0x102D, 0x1030 }, Range{ 0x1032, 0x1037 },
+			Range{ 0x1039, 0x103A }, Range{ 0x103D, 0x103E }, Range{ 0x1058, 0x1059 }, Range{ 0x105E, 0x1060 },
+			Range{ 0x1071, 0x1074 }, Range{ 0x1082, 0x1082 }, Range{ 0x1085, 0x1086 }, Range{ 0x108D, 0x108D },
+			Range{ 0x109D, 0x109D }, Range{ 0x1160, 0x11FF }, Range{ 0x135D, 0x135F }, Range{ 0x1712, 0x1714 },
+			Range{ 0x1732, 0x1733 }, Range{ 0x1752, 0x1753 }, Range{ 0x1772, 0x1773 }, Range{ 0x17B4, 0x17B5 },
+			Range{ 0x17B7, 0x17BD }, Range{ 0x17C6, 0x17C6 }, Range{ 0x17C9, 0x17D3 }, Range{ 0x17DD, 0x17DD },
+			Range{ 0x180B, 0x180F }, Range{ 0x1885, 0x1886 }, Range{ 0x18A9, 0x18A9 }, Range{ 0x1920, 0x1922 },
+			Range{ 0x1927, 0x1928 }, Range{ 0x1932, 0x1932 }, Range{ 0x1939, 0x193B }, Range{ 0x1A17, 0x1A18 },
+			Range{ 0x1A1B, 0x1A1B }, Range{ 0x1A56, 0x1A56 }, Range{ 0x1A58, 0x1A5E }, Range{ 0x1A60, 0x1A60 },
+			Range{ 0x1A62, 0x1A62 }, Range{ 0x1A65, 0x1A6C }, Range{ 0x1A73, 0x1A7C }, Range{ 0x1A7F, 0x1A7F },
+			Range{ 0x1AB0, 0x1ACE }, Range{ 0x1B00, 0x1B03 }, Range{ 0x1B34, 0x1B34 }, Range{ 0x1B36, 0x1B3A },
+			Range{ 0x1B3C, 0x1B3C }, Range{ 0x1B42, 0x1B42 }, Range{ 0x1B6B, 0x1B73 }, Range{ 0x1B80, 0x1B81 },
+			Range{ 0x1BA2, 0x1BA5 }, Range{ 0x1BA8, 0x1BA9 }, Range{ 0x1BAB, 0x1BAD }, Range{ 0x1BE6, 0x1BE6 },
+			Range{ 0x1BE8, 0x1BE9 }, Range{ 0x1BED, 0x1BED }, Range{ 0x1BEF, 0x1BF1 }, Range{ 0x1C2C, 0x1C33 },
+			Range{ 0x1C36, 0x1C37 }, Range{ 0x1CD0, 0x1CD2 }, Range{ 0x1CD4, 0x1CE0 }, Range{ 0x1CE2, 0x1CE8 },
+			Range{ 0x1CED, 0x1CED }, Range{ 0x1CF4, 0x1CF4 }, Range{ 0x1CF8, 0x1CF9 }, Range{ 0x1DC0, 0x1DFF },
+			Range{ 0x200B, 0x200F }, Range{ 0x202A, 0x202E }, Range{ 0x2060, 0x2064 }, Range{ 0x2066, 0x206F },
+			Range{ 0x20D0, 0x20F0 }, Range{ 0x2CEF, 0x2CF1 }, Range{ 0x2D7F, 0x2D7F }, Range{ 0x2DE0, 0x2DFF },
+			Range{ 0x302A, 0x302D }, Range{ 0x3099, 0x309A }, Range{ 0xA66F, 0xA672 }, Range{ 0xA674, 0xA67D },
+			Range{ 0xA69E, 0xA69F }, Range{ 0xA6F0, 0xA6F1 }, Range{ 0xA802, 0xA802 }, Range{ 0xA806, 0xA806 },
+			Range{ 0xA80B, 0xA80B }, Range{ 0xA825, 0xA826 }, Range{ 0xA82C, 0xA82C }, Range{ 0xA8C4, 0xA8C5 },
+			Range{ 0xA8E0, 0xA8F1 }, Range{ 0xA8FF, 0xA8FF }, Range{ 0xA926, 0xA92D }, Range{ 0xA947, 0xA951 },
+			Range{ 0xA980, 0xA982 }, Range{ 0xA9B3, 0xA9B3 }, Range{ 0xA9B6, 0xA9B9 }, Range{ 0xA9BC, 0xA9BD },
+			Range{ 0xA9E5, 0xA9E5 }, Range{ 0xAA29, 0xAA2E }, Range{ 0xAA31, 0xAA32 }, Range{ 0xAA35, 0xAA36 },
+			Range{ 0xAA43, 0xAA43 }, Range{ 0xAA4C, 0xAA4C }, Range{ 0xAA7C, 0xAA7C }, Range{ 0xAAB0, 0xAAB0 },
+			Range{ 0xAAB2, 0xAAB4 }, Range{ 0xAAB7, 0xAAB8 }, Range{ 0xAABE, 0xAABF }, Range{ 0xAAC1, 0xAAC1 },
+			Range{ 0xAAEC, 0xAAED }, Range{ 0xAAF6, 0xAAF6 }, Range{ 0xABE5, 0xABE5 }, Range{ 0xABE8, 0xABE8 },
+			Range{ 0xABED, 0xABED }, Range{ 0xD7B0, 0xD7FF }, Range{ 0xFB1E, 0xFB1E }, Range{ 0xFE00, 0xFE0F },
+			Range{ 0xFE20, 0xFE2F }, Range{ 0xFEFF, 0xFEFF }, Range{ 0xFFF9, 0xFFFB }, Range{ 0x101FD, 0x101FD },
+			Range{ 0x102E0, 0x102E0 }, Range{ 0x10376, 0x1037A }, Range{ 0x10A01, 0x10A03 }, Range{ 0x10A05, 0x10A06 },
+			Range{ 0x10A0C, 0x10A0F }, Range{ 0x10A38, 0x10A3A }, Range{ 0x10A3F, 0x10A3F }, Range{ 0x10AE5, 0x10AE6 },
+			Range{ 0x10D24, 0x10D27 }, Range{ 0x10EAB, 0x10EAC }, Range{ 0x10F46, 0x10F50 }, Range{ 0x10F82, 0x10F85 },
+			Range{ 0x11001, 0x11001 }, Range{ 0x11038, 0x11046 }, Range{ 0x11070, 0x11070 }, Range{ 0x11073, 0x11074 },
+			Range{ 0x1107F, 0x11081 }, Range{ 0x110B3, 0x110B6 }, Range{ 0x110B9, 0x110BA }, Range{ 0x110BD, 0x110BD },
+			Range{ 0x110C2, 0x110C2 }, Range{ 0x110CD, 0x110CD }, Range{ 0x11100, 0x11102 }, Range{ 0x11127, 0x1112B },
+			Range{ 0x1112D, 0x11134 }, Range{ 0x11173, 0x11173 }, Range{ 0x11180, 0x11181 }, Range{ 0x111B6, 0x111BE },
+			Range{ 0x111C9, 0x111CC }, Range{ 0x111CF, 0x111CF }, Range{ 0x1122F, 0x11231 }, Range{ 0x11234, 0x11234 },
+			Range{ 0x11236, 0x11237 }, Range{ 0x1123E, 0x1123E }, Range{ 0x112DF, 0x112DF }, Range{ 0x112E3, 0x112EA },
+			Range{ 0x11300, 0x11301 }, Range{ 0x1133B, 0x1133C }, Range{ 0x11340, 0x11340 }, Range{ 0x11366, 0x1136C },
+			Range{ 0x11370, 0x11374 }, Range{ 0x11438, 0x1143F }, Range{ 0x11442, 0x11444 }, Range{ 0x11446, 0x11446 },
+			Range{ 0x1145E, 0x1145E }, Range{ 0x114B3, 0x114B8 }, Range{ 0x114BA, 0x114BA }, Range{ 0x114BF, 0x114C0 },
+			Range{ 0x114C2, 0x114C3 }, Range{ 0x115B2, 0x115B5 }, Range{ 0x115BC, 0x115BD }, Range{ 0x115BF, 0x115C0 },
+			Range{ 0x115DC, 0x115DD }, Range{ 0x11633, 0x1163A }, Range{ 0x1163D, 0x1163D }, Range{ 0x1163F, 0x11640 },
+			Range{ 0x116AB, 0x116AB }, Range{ 0x116AD, 0x116AD }, Range{ 0x116B0, 0x116B5 }, Range{ 0x116B7, 0x116B7 },
+			Range{ 0x1171D, 0x1171F }, Range{ 0x11722, 0x11725 }, Range{ 0x11727, 0x1172B }, Range{ 0x1182F, 0x11837 },
+			Range{ 0x11839, 0x1183A }, Range{ 0x1193B, 0x1193C }, Range{ 0x1193E, 0x1193E }, Range{ 0x11943, 0x11943 },
+			Range{ 0x119D4, 0x119D7 }, Range{ 0x119DA, 0x119DB }, Range{ 0x119E0, 0x119E0 }, Range{ 0x11A01, 0x11A0A },
+			Range{ 0x11A33, 0x11A38 }, Range{ 0x11A3B, 0x11A3E }, Range{ 0x11A47, 0x11A47 }, Range{ 0x11A51, 0x11A56 },
+			Range{ 0x11A59, 0x11A5B }, Range{ 0x11A8A, 0x11A96 }, Range{ 0x11A98, 0x11A99 }, Range{ 0x11C30, 0x11C36 },
+			Range{ 0x11C38, 0x11C3D }, Range{ 0x11C3F, 0x11C3F }, Range{ 0x11C92, 0x11CA7 }, Range{ 0x11CAA, 0x11CB0 },
+			Range{ 0x11CB2, 0x11CB3 }, Range{ 0x11CB5, 0x11CB6 }, Range{ 0x11D31, 0x11D36 }, Range{ 0x11D3A, 0x11D3A },
+			Range{ 0x11D3C, 0x11D3D }, Range{ 0x11D3F, 0x11D45 }, Range{ 0x11D47, 0x11D47 }, Range{ 0x11D90, 0x11D91 },
+			Range{ 0x11D95, 0x11D95 }, Range{ 0x11D97, 0x11D97 }, Range{ 0x11EF3, 0x11EF4 }, Range{ 0x13430, 0x13438 },
+			Range{ 0x16AF0, 0x16AF4 }, Range{ 0x16B30, 0x16B36 }, Range{ 0x16F4F, 0x16F4F }, Range{ 0x16F8F, 0x16F92 },
+			Range{ 0x16FE4, 0x16FE4 }, Range{ 0x1BC9D, 0x1BC9E }, Range{ 0x1BCA0, 0x1BCA3 }, Range{ 0x1CF00, 0x1CF2D },
+			Range{ 0x1CF30, 0x1CF46 }, Range{ 0x1D167, 0x1D169 }, Range{ 0x1D173, 0x1D182 }, Range{ 0x1D185, 0x1D18B },
+			Range{ 0x1D1AA, 0x1D1AD }, Range{ 0x1D242, 0x1D244 }, Range{ 0x1DA00, 0x1DA36 }, Range{ 0x1DA3B, 0x1DA6C },
+			Range{ 0x1DA75, 0x1DA75 }, Range{ 0x1DA84, 0x1DA84 }, Range{ 0x1DA9B, 0x1DA9F }, Range{ 0x1DAA1, 0x1DAAF },
+			Range{ 0x1E000, 0x1E006 }, Range{ 0x1E008, 0x1E018 }, Range{ 0x1E01B, 0x1E021 }, Range{ 0x1E023, 0x1E024 },
+			Range{ 0x1E026, 0x1E02A }, Range{ 0x1E130, 0x1E136 }, Range{ 0x1E2AE, 0x1E2AE }, Range{ 0x1E2EC, 0x1E2EF },
+			Range{ 0x1E8D0, 0x1E8D6 }, Range{ 0x1E944, 0x1E94A }, Range{ 0x1F3FB, 0x1F3FF }, Range{ 0xE0001, 0xE0001 },
+			Range{ 0xE0020, 0xE007F }, Range{ 0xE0100, 0xE01EF },
+		};
+
+		// East Asian wide and fullwidth characters, including the emoji which terminals draw two columns wide.
+		constexpr std::array wide
+		{
+			Range{ 0x0378, 0x0379 }, Range{ 0x0380, 0x0383 }, Range{ 0x038B, 0x038B }, Range{ 0x038D, 0x038D },
+			Range{ 0x03A2, 0x03A2 }, Range{ 0x0530, 0x0530 }, Range{ 0x0557, 0x0558 }, Range{ 0x058B, 0x058C },
+			Range{ 0x0590, 0x0590 }, Range{ 0x05C8, 0x05CF }, Range{ 0x05EB, 0x05EE }, Range{ 0x05F5, 0x05FF },
+			Range{ 0x070E, 0x070E }, Range{ 0x074B, 0x074C }, Range{ 0x07B2, 0x07BF }, Range{ 0x07FB, 0x07FC },
+			Range{ 0x082E, 0x082F }, Range{ 0x083F, 0x083F }, Range{ 0x085C, 0x085D }, Range{ 0x085F, 0x085F },
+			Range{ 0x086B, 0x086F }, Range{ 0x088F, 0x088F }, Range{ 0x0892, 0x0897 }, Range{ 0x0984, 0x0984 },
+			Range{ 0x098D, 0x098E }, Range{ 0x0991, 0x0992 }, Range{ 0x09A9, 0x09A9 }, Range{ 0x09B1, 0x09B1 },
+			Range{ 0x09B3, 0x09B5 }, Range{ 0x09BA, 0x09BB }, Range{ 0x09C5, 0x09C6 }, Range{ 0x09C9, 0x09CA },
+			Range{ 0x09CF, 0x09D6 }, Range{ 0x09D8, 0x09DB }, Range{ 0x09DE, 0x09DE }, Range{ 0x09E4, 0x09E5 },
+			Range{ 0x09FF, 0x0A00 }, Range{ 0x0A04, 0x0A04 }, Range{ 0x0A0B, 0x0A0E }, Range{ 0x0A11, 0x0A12 },
+			Range{ 0x0A29, 0x0A29 }, Range{ 0x0A31, 0x0A31 }, Range{ 0x0A34, 0x0A34 }, Range{ 0x0A37, 0x0A37 },
+			Range{ 0x0A3A, 0x0A3B }, Range{ 0x0A3D, 0x0A3D }, Range{ 0x0A43, 0x0A46 }, Range{ 0x0A49, 0x0A4A },
+			Range{ 0x0A4E, 0x0A50 }, Range{ 0x0A52, 0x0A58 }, Range{ 0x0A5D, 0x0A5D }, Range{ 0x0A5F, 0x0A65 },
+			Range{ 0x0A77, 0x0A80 }, Range{ 0x0A84, 0x0A84 }, Range{ 0x0A8E, 0x0A8E }, Range{ 0x0A92, 0x0A92 },
+			Range{ 0x0AA9, 0x0AA9 }, Range{ 0x0AB1, 0x0AB1 }, Range{ 0x0AB4, 0x0AB4 }, Range{ 0x0ABA, 0x0ABB },
+			Range{ 0x0AC6, 0x0AC6 }, Range{ 0x0ACA, 0x0ACA }, Range{ 0x0ACE, 0x0ACF }, Range{ 0x0AD1, 0x0ADF },
+			Range{ 0x0AE4, 0x0AE5 }, Range{ 0x0AF2, 0x0AF8 }, Range{ 0x0B00, 0x0B00 }, Range{ 0x0B04, 0x0B04 },
+			Range{ 0x0B0D, 0x0B0E }, Range{ 0x0B11, 0x0B12 }, Range{ 0x0B29, 0x0B29 }, Range{ 0x0B31, 0x0B31 },
+			Range{ 0x0B34, 0x0B34 }, Range{ 0x0B3A, 0x0B3B }, Range{ 0x0B45, 0x0B46 }, Range{ 0x0B49, 0x0B4A },
+			Range{ 0x0B4E, 0x0B54 }, Range{ 0x0B58, 0x0B5B }, Range{ 0x0B5E, 0x0B5E }, Range{ 0x0B64, 0x0B65 },
+			Range{ 0x0B78, 0x0B81 }, Range{ 0x0B84, 0x0B84 }, Range{ 0x0B8B, 0x0B8D }, Range{ 0x0B91, 0x0B91 },
+			Range{ 0x0B96, 0x0B98 }, Range{ 0x0B9B, 0x0B9B }, Range{ 0x0B9D, 0x0B9D }, Range{ 0x0BA0, 0x0BA2 },
+			Range{ 0x0BA5, 0x0BA7 }, Range{ 0x0BAB, 0x0BAD }, Range{ 0x0BBA, 0x0BBD }, Range{ 0x0BC3, 0x0BC5 },
+			Range{ 0x0BC9, 0x0BC9 }, Range{ 0x0BCE, 0x0BCF }, Range{ 0x0BD1, 0x0BD6 }, Range{ 0x0BD8, 0x0BE5 },
+			Range{ 0x0BFB, 0x0BFF }, Range{ 0x0C0D, 0x0C0D }, Range{ 0x0C11, 0x0C11 }, Range{ 0x0C29, 0x0C29 },
+			Range{ 0x0C3A, 0x0C3B }, Range{ 0x0C45, 0x0C45 }, Range{ 0x0C49, 0x0C49 }, Range{ 0x0C4E, 0x0C54 },
+			Range{ 0x0C57, 0x0C57 }, Range{ 0x0C5B, 0x0C5C }, Range{ 0x0C5E, 0x0C5F }, Range{ 0x0C64, 0x0C65 },
+			Range{ 0x0C70, 0x0C76 }, Range{ 0x0C8D, 0x0C8D }, Range{ 0x0C91, 0x0C91 }, Range{ 0x0CA9, 0x0CA9 },
+			Range{ 0x0CB4, 0x0CB4 }, Range{ 0x0CBA, 0x0CBB }, Range{ 0x0CC5, 0x0CC5 }, Range{ 0x0CC9, 0x0CC9 },
+			Range{ 0x0CCE, 0x0CD4 }, Range{ 0x0CD7, 0x0CDC }, Range{ 0x0CDF, 0x0CDF }, Range{ 0x0CE4, 0x0CE5 },
+			Range{ 0x0CF0, 0x0CF0 }, Range{ 0x0CF3, 0x0CFF }, Range{ 0x0D0D, 0x0D0D }, Range{ 0x0D11, 0x0D11 },
+			Range{ 0x0D45, 0x0D45 }, Range{ 0x0D49, 0x0D49 }, Range{ 0x0D50, 0x0D53 }, Range{ 0x0D64, 0x0D65 },
+			Range{ 0x0D80, 0x0D80 }, Range{ 0x0D84, 0x0D84 }, Range{ 0x0D97, 0x0D99 }, Range{ 0x0DB2, 0x0DB2 },
+			Range{ 0x0DBC, 0x0DBC }, Range{ 0x0DBE, 0x0DBF }, Range{ 0x0DC7, 0x0DC9 }, Range{ 0x0DCB, 0x0DCE },
+			Range{ 0x0DD5, 0x0DD5 }, Range{ 0x0DD7, 0x0DD7 }, Range{ 0x0DE0, 0x0DE5 }, Range{ 0x0DF0, 0x0DF1 },
+			Range{ 0x0DF5, 0x0E00 }, Range{ 0x0E3B, 0x0E3E }, Range{ 0x0E5C, 0x0E80 }, Range{ 0x0E83, 0x0E83 },
+			Range{ 0x0E85, 0x0E85 }, Range{ 0x0E8B, 0x0E8B }, Range{ 0x0EA4, 0x0EA4 }, Range{ 0x0EA6, 0x0EA6 },
+			Range{ 0x0EBE, 0x0EBF }, Range{ 0x0EC5, 0x0EC5 }, Range{ 0x0EC7, 0x0EC7 }, Range{ 0x0ECE, 0x0ECF },
+			Range{ 0x0EDA, 0x0EDB }, Range{ 0x0EE0, 0x0EFF }, Range{ 0x0F48, 0x0F48 }, Range{ 0x0F6D, 0x0F70 },
+			Range{ 0x0F98, 0x0F98 }, Range{ 0x0FBD, 0x0FBD }, Range{ 0x0FCD, 0x0FCD }, Range{ 0x0FDB, 0x0FFF },
+			Range{ 0x10C6, 0x10C6 }, Range{ 0x10C8, 0x10CC }, Range{ 0x10CE, 0x10CF }, Range{ 0x1100, 0x115F },
+			Range{ 0x1249, 0x1249 }, Range{ 0x124E, 0x124F }, Range{ 0x1257, 0x1257 }, Range{ 0x1259, 0x1259 },
+			Range{ 0x125E, 0x125F }, Range{ 0x1289, 0x1289 }, Range{ 0x128E, 0x128F }, Range{ 0x12B1, 0x12B1 },
+			Range{ 0x12B6, 0x12B7 }, Range{ 0x12BF, 0x12BF }, Range{ 0x12C1, 0x12C1 }, Range{ 0x12C6, 0x12C7 },
+			Range{ 0x12D7, 0x12D7 }, Range{ 0x1311, 0x1311 }, Range{ 0x1316, 0x1317 }, Range{ 0x135B, 0x135C },
+			Range{ 0x137D, 0x137F }, Range{ 0x139A, 0x139F }, Range{ 0x13F6, 0x13F7 }, Range{ 0x13FE, 0x13FF },
+			Range{ 0x169D, 0x169F }, Range{ 0x16F9, 0x16FF }, Range{ 0x1716, 0x171E }, Range{ 0x1737, 0x173F },
+			Range{ 0x1754, 0x175F }, Range{ 0x176D, 0x176D }, Range{ 0x1771, 0x1771 }, Range{ 0x1774, 0x177F },
+			Range{ 0x17DE, 0x17DF }, Range{ 0x17EA, 0x17EF }, Range{ 0x17FA, 0x17FF }, Range{ 0x181A, 0x181F },
+			Range{ 0x1879, 0x187F }, Range{ 0x18AB, 0x18AF }, Range{ 0x18F6, 0x18FF }, Range{ 0x191F, 0x191F },
+			Range{ 0x192C, 0x192F }, Range{ 0x193C, 0x193F }, Range{ 0x1941, 0x1943 }, Range{ 0x196E, 0x196F },
+			Range{ 0x1975, 0x197F }, Range{ 0x19AC, 0x19AF }, Range{ 0x19CA, 0x19CF }, Range{ 0x19DB, 0x19DD },
+			Range{ 0x1A1C, 0x1A1D }, Range{ 0x1A5F, 0x1A5F }, Range{ 0x1A7D, 0x1A7E }, Range{ 0x1A8A, 0x1A8F },
+			Range{ 0x1A9A, 0x1A9F }, Range{ 0x1AAE, 0x1AAF }, Range{ 0x1ACF, 0x1AFF }, Range{ 0x1B4D, 0x1B4F },
+			Range{ 0x1B7F, 0x1B7F }, Range{ 0x1BF4, 0x1BFB }, Range{ 0x1C38, 0x1C3A }, Range{ 0x1C4A, 0x1C4C },
+			Range{ 0x1C89, 0x1C8F }, Range{ 0x1CBB, 0x1CBC }, Range{ 0x1CC8, 0x1CCF }, Range{ 0x1CFB, 0x1CFF },
+			Range{ 0x1F16, 0x1F17 }, Range{ 0x1F1E, 0x1F1F }, Range{ 0x1F46, 0x1F47 }, Range{ 0x1F4E, 0x1F4F },
+			Range{ 0x1F58, 0x1F58 }, Range{ 0x1F5A, 0x1F5A }, Range{ 0x1F5C, 0x1F5C }, Range{ 0x1F5E, 0x1F5E },
+			Range{ 0x1F7E, 0x1F7F }, Range{ 0x1FB5, 0x1FB5 }, Range{ 0x1FC5, 0x1FC5 }, Range{ 0x1FD4, 0x1FD5 },
+			Range{ 0x1FDC, 0x1FDC }, Range{ 0x1FF0, 0x1FF1 }, Range{ 0x1FF5, 0x1FF5 }, Range{ 0x1FFF, 0x1FFF },
+			Range{ 0x2065, 0x2065 }, Range{ 0x2072, 0x2073 }, Range{ 0x208F, 0x208F }, Range{ 0x209D, 0x209F },
+			Range{ 0x20C1, 0x20CF }, Range{ 0x20F1, 0x20FF }, Range{ 0x218C, 0x218F }, Range{ 0x231A, 0x231B },
+			Range{ 0x2329, 0x232A }, Range{ 0x23E9, 0x23EC }, Range{ 0x23F0, 0x23F0 }, Range{ 0x23F3, 0x23F3 },
+			Range{ 0x2427, 0x243F }, Range{ 0x244B, 0x245F }, Range{ 0x25FD, 0x25FE }, Range{ 0x2614, 0x2615 },
+			Range{ 0x2648, 0x2653 }, Range{ 0x267F, 0x267F }, Range{ 0x2693, 0x2693 }, Range{ 0x26A1, 0x26A1 },
+			Range{ 0x26AA, 0x26AB }, Range{ 0x26BD, 0x26BE }, Range{ 0x26C4, 0x26C5 }, Range{ 0x26CE, 0x26CE },
+			Range{ 0x26D4, 0x26D4 }, Range{ 0x26EA, 0x26EA }, Range{ 0x26F2, 0x26F3 }, Range{ 0x26F5, 0x26F5 },
+			Range{ 0x26FA, 0x26FA }, Range{ 0x26FD, 0x26FD }, Range{ 0x2705, 0x2705 }, Range{ 0x270A, 0x270B },
+			Range{ 0x2728, 0x2728 }, Range{ 0x274C, 0x274C }, Range{ 0x274E, 0x274E }, Range{ 0x2753, 0x2755 },
+			Range{ 0x2757, 0x2757 }, Range{ 0x2795, 0x2797 }, Range{ 0x27B0, 0x27B0 }, Range{ 0x27BF, 0x27BF },
+			Range{ 0x2B1B, 0x2B1C }, Range{ 0x2B50, 0x2B50 }, Range{ 0x2B55, 0x2B55 }, Range{ 0x2B74, 0x2B75 },
+			Range{ 0x2B96, 0x2B96 }, Range{ 0x2CF4, 0x2CF8 }, Range{ 0x2D26, 0x2D26 }, Range{ 0x2D28, 0x2D2C },
+			Range{ 0x2D2E, 0x2D2F }, Range{ 0x2D68, 0x2D6E }, Range{ 0x2D71, 0x2D7E }, Range{ 0x2D97, 0x2D9F },
+			Range{ 0x2DA7, 0x2DA7 }, Range{ 0x2DAF, 0x2DAF }, Range{ 0x2DB7, 0x2DB7 }, Range{ 0x2DBF, 0x2DBF },
+			Range{ 0x2DC7, 0x2DC7 }, Range{ 0x2DCF, 0x2DCF }, Range{ 0x2DD7, 0x2DD7 }, Range{ 0x2DDF, 0x2DDF },
+			Range{ 0x2E5E, 0x3029 }, Range{ 0x302E, 0x303E }, Range{ 0x3040, 0x3098 }, Range{ 0x309B, 0x3247 },
+			Range{ 0x3250, 0x4DBF }, Range{ 0x4E00, 0xA4CF }, Range{ 0xA62C, 0xA63F }, Range{ 0xA6F8, 0xA6FF },
+			Range{ 0xA7CB, 0xA7CF }, Range{ 0xA7D2, 0xA7D2 }, Range{ 0xA7D4, 0xA7D4 }, Range{ 0xA7DA, 0xA7F1 },
+			Range{ 0xA82D, 0xA82F }, Range{ 0xA83A, 0xA83F }, Range{ 0xA878, 0xA87F }, Range{ 0xA8C6, 0xA8CD },
+			Range{ 0xA8DA, 0xA8DF }, Range{ 0xA954, 0xA95E }, Range{ 0xA960, 0xA97F }, Range{ 0xA9CE, 0xA9CE },
+			Range{ 0xA9DA, 0xA9DD }, Range{ 0xA9FF, 0xA9FF }, Range{ 0xAA37, 0xAA3F }, Range{ 0xAA4E, 0xAA4F },
+			Range{ 0xAA5A, 0xAA5B }, Range{ 0xAAC3, 0xAADA }, Range{ 0xAAF7, 0xAB00 }, Range{ 0xAB07, 0xAB08 },
+			Range{ 0xAB0F, 0xAB10 }, Range{ 0xAB17, 0xAB1F }, Range{ 0xAB27, 0xAB27 }, Range{ 0xAB2F, 0xAB2F },
+			Range{ 0xAB6C, 0xAB6F }, Range{ 0xABEE, 0xABEF }, Range{ 0xABFA, 0xD7AF }, Range{ 0xF900, 0xFAFF },
+			Range{ 0xFB07, 0xFB12 }, Range{ 0xFB18, 0xFB1C }, Range{ 0xFB37, 0xFB37 }, Range{ 0xFB3D, 0xFB3D },
+			Range{ 0xFB3F, 0xFB3F }, Range{ 0xFB42, 0xFB42 }, Range{ 0xFB45, 0xFB45 }, Range{ 0xFBC3, 0xFBD2 },
+			Range{ 0xFD90, 0xFD91 }, Range{ 0xFDC8, 0xFDCE }, Range{ 0xFDD0, 0xFDEF }, Range{ 0xFE10, 0xFE1F },
+			Range{ 0xFE30, 0xFE6F }, Range{ 0xFE75, 0xFE75 }, Range{ 0xFEFD, 0xFEFE }, Range{ 0xFF00, 0xFF60 },
+			Range{ 0xFFBF, 0xFFC1 }, Range{ 0xFFC8, 0xFFC9 }, Range{ 0xFFD0, 0xFFD1 }, Range{ 0xFFD8, 0xFFD9 },
+			Range{ 0xFFDD, 0xFFE7 }, Range{ 0xFFEF, 0xFFF8 }, Range{ 0xFFFE, 0xFFFF }, Range{ 0x1000C, 0x1000C },
+			Range{ 0x10027, 0x10027 }, Range{ 0x1003B, 0x1003B }, Range{ 0x1003E, 0x1003E }, Range{ 0x1004E, 0x1004F },
+			Range{ 0x1005E, 0x1007F }, Range{ 0x100FB, 0x100FF }, Range{ 0x10103, 0x10106 }, Range{ 0x10134, 0x10136 },
+			Range{ 0x1018F, 0x1018F }, Range{ 0x1019D, 0x1019F }, Range{ 0x101A1, 0x101CF }, Range{ 0x101FE, 0x1027F },
+			Range{ 0x1029D, 0x1029F }, Range{ 0x102D1, 0x102DF }, Range{ 0x102FC, 0x102FF }, Range{ 0x10324, 0x1032C },
+			Range{ 0x1034B, 0x1034F }, Range{ 0x1037B, 0x1037F }, Range{ 0x1039E, 0x1039E }, Range{ 0x103C4, 0x103C7 },
+			Range{ 0x103D6, 0x103FF }, Range{ 0x1049E, 0x1049F }, Range{ 0x104AA, 0x104AF }, Range{ 0x104D4, 0x104D7 },
+			Range{ 0x104FC, 0x104FF }, Range{ 0x10528, 0x1052F }, Range{ 0x10564, 0x1056E }, Range{ 0x1057B, 0x1057B },
+			Range{ 0x1058B, 0x1058B }, Range{ 0x10593, 0x10593 }, Range{ 0x10596, 0x10596 }, Range{ 0x105A2, 0x105A2 },
+			Range{ 0x105B2, 0x105B2 }, Range{ 0x105BA, 0x105BA }, Range{ 0x105BD, 0x105FF }, Range{ 0x10737, 0x1073F },
+			Range{ 0x10756, 0x1075F }, Range{ 0x10768, 0x1077F }, Range{ 0x10786, 0x10786 }, Range{ 0x107B1, 0x107B1 },
+			Range{ 0x107BB, 0x107FF }, Range{ 0x10806, 0x10807 }, Range{ 0x10809, 0x10809 }, Range{ 0x10836, 0x10836 },
+			Range{ 0x10839, 0x1083B }, Range{ 0x1083D, 0x1083E }, Range{ 0x10856, 0x10856 }, Range{ 0x1089F, 0x108A6 },
+			Range{ 0x108B0, 0x108DF }, Range{ 0x108F3, 0x108F3 }, Range{ 0x108F6, 0x108FA }, Range{ 0x1091C, 0x1091E },
+			Range{ 0x1093A, 0x1093E }, Range{ 0x10940, 0x1097F }, Range{ 0x109B8, 0x109BB }, Range{ 0x109D0, 0x109D1 },
+			Range{ 0x10A04, 0x10A04 }, Range{ 0x10A07, 0x10A0B }, Range{ 0x10A14, 0x10A14 }, Range{ 0x10A18, 0x10A18 },
+			Range{ 0x10A36, 0x10A37 }, Range{ 0x10A3B, 0x10A3E }, Range{ 0x10A49, 0x10A4F }, Range{ 0x10A59, 0x10A5F },
+			Range{ 0x10AA0, 0x10ABF }, Range{ 0x10AE7, 0x10AEA }, Range{ 0x10AF7, 0x10AFF }, Range{ 0x10B36, 0x10B38 },
+			Range{ 0x10B56, 0x10B57 }, Range{ 0x10B73, 0x10B77 }, Range{ 0x10B92, 0x10B98 }, Range{ 0x10B9D, 0x10BA8 },
+			Range{ 0x10BB0, 0x10BFF }, Range{ 0x10C49, 0x10C7F }, Range{ 0x10CB3, 0x10CBF }, Range{ 0x10CF3, 0x10CF9 },
+			Range{ 0x10D28, 0x10D2F }, Range{ 0x10D3A, 0x10E5F }, Range{ 0x10E7F, 0x10E7F }, Range{ 0x10EAA, 0x10EAA },
+			Range{ 0x10EAE, 0x10EAF }, Range{ 0x10EB2, 0x10EFF }, Range{ 0x10F28, 0x10F2F }, Range{ 0x10F5A, 0x10F6F },
+			Range{ 0x10F8A, 0x10FAF }, Range{ 0x10FCC, 0x10FDF }, Range{ 0x10FF7, 0x10FFF }, Range{ 0x1104E, 0x11051 },
+			Range{ 0x11076, 0x1107E }, Range{ 0x110C3, 0x110CC }, Range{ 0x110CE, 0x110CF }, Range{ 0x110E9, 0x110EF },
+			Range{ 0x110FA, 0x110FF }, Range{ 0x11135, 0x11135 }, Range{ 0x11148, 0x1114F }, Range{ 0x11177, 0x1117F },
+			Range{ 0x111E0, 0x111E0 }, Range{ 0x111F5, 0x111FF }, Range{ 0x11212, 0x11212 }, Range{ 0x1123F, 0x1127F },
+			Range{ 0x11287, 0x11287 }, Range{ 0x11289, 0x11289 }, Range{ 0x1128E, 0x1128E }, Range{ 0x1129E, 0x1129E },
+			Range{ 0x112AA, 0x112AF }, Range{ 0x112EB, 0x112EF }, Range{ 0x112FA, 0x112FF }, Range{ 0x11304, 0x11304 },
+			Range{ 0x1130D, 0x1130E }, Range{ 0x11311, 0x11312 }, Range{ 0x11329, 0x11329 }, Range{ 0x11331, 0x11331 },
+			Range{ 0x11334, 0x11334 }, Range{ 0x1133A, 0x1133A }, Range{ 0x11345, 0x11346 }, Range{ 0x11349, 0x1134A },
+			Range{ 0x1134E, 0x1134F }, Range{ 0x11351, 0x11356 }, Range{ 0x11358, 0x1135C }, Range{ 0x11364, 0x11365 },
+			Range{ 0x1136D, 0x1136F }, Range{ 0x11375, 0x113FF }, Range{ 0x1145C, 0x1145C }, Range{ 0x11462, 0x1147F },
+			Range{ 0x114C8, 0x114CF }, Range{ 0x114DA, 0x1157F }, Range{ 0x115B6, 0x115B7 }, Range{ 0x115DE, 0x115FF },
+			Range{ 0x11645, 0x1164F }, Range{ 0x1165A, 0x1165F }, Range{ 0x1166D, 0x1167F }, Range{ 0x116BA, 0x116BF },
+			Range{ 0x116CA, 0x116FF }, Range{ 0x1171B, 0x1171C }, Range{ 0x1172C, 0x1172F }, Range{ 0x11747, 0x117FF },
+			Range{ 0x1183C, 0x1189F }, Range{ 0x118F3, 0x118FE }, Range{ 0x11907, 0x11908 }, Range{ 0x1190A, 0x1190B },
+			Range{ 0x11914, 0x11914 }, Range{ 0x11917, 0x11917 }, Range{ 0x11936, 0x11936 }, Range{ 0x11939, 0x1193A },
+			Range{ 0x11947, 0x1194F }, Range{ 0x1195A, 0x1199F }, Range{ 0x119A8, 0x119A9 }, Range{ 0x119D8, 0x119D9 },
+			Range{ 0x119E5, 0x119FF }, Range{ 0x11A48, 0x11A4F }, Range{ 0x11AA3, 0x11AAF }, Range{ 0x11AF9, 0x11BFF },
+			Range{ 0x11C09, 0x11C09 }, Range{ 0x11C37, 0x11C37 }, Range{ 0x11C46, 0x11C4F }, Range{ 0x11C6D, 0x11C6F },
+			Range{ 0x11C90, 0x11C91 }, Range{ 0x11CA8, 0x11CA8 }, Range{ 0x11CB7, 0x11CFF }, Range{ 0x11D07, 0x11D07 },
+			Range{ 0x11D0A, 0x11D0A }, Range{ 0x11D37, 0x11D39 }, Range{ 0x11D3B, 0x11D3B }, Range{ 0x11D3E, 0x11D3E },
+			Range{ 0x11D48, 0x11D4F }, Range{ 0x11D5A, 0x11D5F }, Range{ 0x11D66, 0x11D66 }, Range{ 0x11D69, 0x11D69 },
+			Range{ 0x11D8F, 0x11D8F }, Range{ 0x11D92, 0x11D92 }, Range{ 0x11D99, 0x11D9F }, Range{ 0x11DAA, 0x11EDF },
+			Range{ 0x11EF9, 0x11FAF }, Range{ 0x11FB1, 0x11FBF }, Range{ 0x11FF2, 0x11FFE }, Range{ 0x1239A, 0x123FF },
+			Range{ 0x1246F, 0x1246F }, Range{ 0x12475, 0x1247F }, Range{ 0x12544, 0x12F8F }, Range{ 0x12FF3, 0x12FFF },
+			Range{ 0x1342F, 0x1342F }, Range{ 0x13439, 0x143FF }, Range{ 0x14647, 0x167FF }, Range{ 0x16A39, 0x16A3F },
+			Range{ 0x16A5F, 0x16A5F }, Range{ 0x16A6A, 0x16A6D }, Range{ 0x16ABF, 0x16ABF }, Range{ 0x16ACA, 0x16ACF },
+			Range{ 0x16AEE, 0x16AEF }, Range{ 0x16AF6, 0x16AFF }, Range{ 0x16B46, 0x16B4F }, Range{ 0x16B5A, 0x16B5A },
+			Range{ 0x16B62, 0x16B62 }, Range{ 0x16B78, 0x16B7C }, Range{ 0x16B90, 0x16E3F }, Range{ 0x16E9B, 0x16EFF },
+			Range{ 0x16F4B, 0x16F4E }, Range{ 0x16F88, 0x16F8E }, Range{ 0x16FA0, 0x16FE3 }, Range{ 0x16FE5, 0x1BBFF },
+			Range{ 0x1BC6B, 0x1BC6F }, Range{ 0x1BC7D, 0x1BC7F }, Range{ 0x1BC89, 0x1BC8F }, Range{ 0x1BC9A, 0x1BC9B },
+			Range{ 0x1BCA4, 0x1CEFF }, Range{ 0x1CF2E, 0x1CF2F }, Range{ 0x1CF47, 0x1CF4F }, Range{ 0x1CFC4, 0x1CFFF },
+			Range{ 0x1D0F6, 0x1D0FF }, Range{ 0x1D127, 0x1D128 }, Range{ 0x1D1EB, 0x1D1FF }, Range{ 0x1D246, 0x1D2DF },
+			Range{ 0x1D2F4, 0x1D2FF }, Range{ 0x1D357, 0x1D35F }, Range{ 0x1D379, 0x1D3FF }, Range{ 0x1D455, 0x1D455 },
+			Range{ 0x1D49D, 0x1D49D }, Range{ 0x1D4A0, 0x1D4A1 }, Range{ 0x1D4A3, 0x1D4A4 }, Range{ 0x1D4A7, 0x1D4A8 },
+			Range{ 0x1D4AD, 0x1D4AD }, Range{ 0x1D4BA, 0x1D4BA }, Range{ 0x1D4BC, 0x1D4BC }, Range{ 0x1D4C4, 0x1D4C4 },
+			Range{ 0x1D506, 0x1D506 }, Range{ 0x1D50B, 0x1D50C }, Range{ 0x1D515, 0x1D515 }, Range{ 0x1D51D, 0x1D51D },
+			Range{ 0x1D53A, 0x1D53A }, Range{ 0x1D53F, 0x1D53F }, Range{ 0x1D545, 0x1D545 }, Range{ 0x1D547, 0x1D549 },
+			Range{ 0x1D551, 0x1D551 }, Range{ 0x1D6A6, 0x1D6A7 }, Range{ 0x1D7CC, 0x1D7CD }, Range{ 0x1DA8C, 0x1DA9A },
+			Range{ 0x1DAA0, 0x1DAA0 }, Range{ 0x1DAB0, 0x1DEFF }, Range{ 0x1DF1F, 0x1DFFF }, Range{ 0x1E007, 0x1E007 },
+			Range{ 0x1E019, 0x1E01A }, Range{ 0x1E022, 0x1E022 }, Range{ 0x1E025, 0x1E025 }, Range{ 0x1E02B, 0x1E0FF },
+			Range{ 0x1E12D, 0x1E12F }, Range{ 0x1E13E, 0x1E13F }, Range{ 0x1E14A, 0x1E14D }, Range{ 0x1E150, 0x1E28F },
+			Range{ 0x1E2AF, 0x1E2BF }, Range{ 0x1E2FA, 0x1E2FE }, Range{ 0x1E300, 0x1E7DF }, Range{ 0x1E7E7, 0x1E7E7 },
+			Range{ 0x1E7EC, 0x1E7EC }, Range{ 0x1E7EF, 0x1E7EF }, Range{ 0x1E7FF, 0x1E7FF }, Range{ 0x1E8C5, 0x1E8C6 },
+			Range{ 0x1E8D7, 0x1E8FF }, Range{ 0x1E94C, 0x1E94F }, Range{ 0x1E95A, 0x1E95D }, Range{ 0x1E960, 0x1EC70 },
+			Range{ 0x1ECB5, 0x1ED00 }, Range{ 0x1ED3E, 0x1EDFF }, Range{ 0x1EE04, 0x1EE04 }, Range{ 0x1EE20, 0x1EE20 },
+			Range{ 0x1EE23, 0x1EE23 }, Range{ 0x1EE25, 0x1EE26 }, Range{ 0x1EE28, 0x1EE28 }, Range{ 0x1EE33, 0x1EE33 },
+			Range{ 0x1EE38, 0x1EE38 }, Range{ 0x1EE3A, 0x1EE3A }, Range{ 0x1EE3C, 0x1EE41 }, Range{ 0x1EE43, 0x1EE46 },
+			Range{ 0x1EE48, 0x1EE48 }, Range{ 0x1EE4A, 0x1EE4A }, Range{ 0x1EE4C, 0x1EE4C }, Range{ 0x1EE50, 0x1EE50 },
+			Range{ 0x1EE53, 0x1EE53 }, Range{ 0x1EE55, 0x1EE56 }, Range{ 0x1EE58, 0x1EE58 }, Range{ 0x1EE5A, 0x1EE5A },
+			Range{ 0x1EE5C, 0x1EE5C }, Range{ 0x1EE5E, 0x1EE5E }, Range{ 0x1EE60, 0x1EE60 }, Range{ 0x1EE63, 0x1EE63 },
+			Range{ 0x1EE65, 0x1EE66 }, Range{ 0x1EE6B, 0x1EE6B }, Range{ 0x1EE73, 0x1EE73 }, Range{ 0x1EE78, 0x1EE78 },
+			Range{ 0x1EE7D, 0x1EE7D }, Range{ 0x1EE7F, 0x1EE7F }, Range{ 0x1EE8A, 0x1EE8A }, Range{ 0x1EE9C, 0x1EEA0 },
+			Range{ 0x1EEA4, 0x1EEA4 }, Range{ 0x1EEAA, 0x1EEAA }, Range{ 0x1EEBC, 0x1EEEF }, Range{ 0x1EEF2, 0x1EFFF },
+			Range{ 0x1F004, 0x1F004 }, Range{ 0x1F02C, 0x1F02F }, Range{ 0x1F094, 0x1F09F }, Range{ 0x1F0AF, 0x1F0B0 },
+			Range{ 0x1F0C0, 0x1F0C0 }, Range{ 0x1F0CF, 0x1F0D0 }, Range{ 0x1F0F6, 0x1F0FF }, Range{ 0x1F18E, 0x1F18E },
+			Range{ 0x1F191, 0x1F19A }, Range{ 0x1F1AE, 0x1F1E5 }, Range{ 0x1F200, 0x1F320 }, Range{ 0x1F32D, 0x1F335 },
+			Range{ 0x1F337, 0x1F37C }, Range{ 0x1F37E, 0x1F393 }, Range{ 0x1F3A0, 0x1F3CA }, Range{ 0x1F3CF, 0x1F3D3 },
+			Range{ 0x1F3E0, 0x1F3F0 }, Range{ 0x1F3F4, 0x1F3F4 }, Range{ 0x1F3F8, 0x1F3FA }, Range{ 0x1F400, 0x1F43E },
+			Range{ 0x1F440, 0x1F440 }, Range{ 0x1F442, 0x1F4FC }, Range{ 0x1F4FF, 0x1F53D }, Range{ 0x1F54B, 0x1F54E },
+			Range{ 0x1F550, 0x1F567 }, Range{ 0x1F57A, 0x1F57A }, Range{ 0x1F595, 0x1F596 }, Range{ 0x1F5A4, 0x1F5A4 },
+			Range{ 0x1F5FB, 0x1F64F }, Range{ 0x1F680, 0x1F6C5 }, Range{ 0x1F6CC, 0x1F6CC }, Range{ 0x1F6D0, 0x1F6D2 },
+			Range{ 0x1F6D5, 0x1F6DF }, Range{ 0x1F6EB, 0x1F6EF }, Range{ 0x1F6F4, 0x1F6FF }, Range{ 0x1F774, 0x1F77F },
+			Range{ 0x1F7D9, 0x1F7FF }, Range{ 0x1F80C, 0x1F80F }, Range{ 0x1F848, 0x1F84F }, Range{ 0x1F85A, 0x1F85F },
+			Range{ 0x1F888, 0x1F88F }, Range{ 0x1F8AE, 0x1F8AF }, Range{ 0x1F8B2, 0x1F8FF }, Range{ 0x1F90C, 0x1F93A },
+			Range{ 0x1F93C, 0x1F945 }, Range{ 0x1F947, 0x1F9FF }, Range{ 0x1FA54, 0x1FA5F }, Range{ 0x1FA6E, 0x1FAFF },
+			Range{ 0x1FB93, 0x1FB93 }, Range{ 0x1FBCB, 0x1FBEF }, Range{ 0x1FBFA, 0xE0000 }, Range{ 0xE0002, 0xE001F },
+			Range{ 0xE0080, 0xE00FF }, Range{ 0xE01F0, 0xEFFFF }, Range{ 0xFFFFE, 0xFFFFF }, Range{ 0x10FFFE, 0x10FFFF },
+		};
+
+		template< std::size_t size >
+		constexpr bool
+		sorted( const std::array< Range, size > &table )
+		{
+			for( std::size_t i= 1; i < size; ++i ) if( table[ i - 1 ].last >= table[ i ].first ) return false;
+			return true;
+		}
+		static_assert( sorted( zeroWidth ) );
+		static_assert( sorted( wide ) );
+
+		template< std::size_t size >
+		bool
+		contains( const std::array< Range, size > &table, const char32_t codePoint ) noexcept
+		{
+			const auto found= std::lower_bound( begin( table ), end( table ), codePoint,
+					[]( const Range &range, const char32_t cp ) { return range.last < cp; } );
+			return found != end( table ) and found->first <= codePoint;
+		}
+
+		// True when all eight bytes of `word` are printable ASCII.
+		bool
+		printable( const std::uint64_t word ) noexcept
+		{
+			const std::uint64_t ones= 0x0101'0101'0101'0101;
+			const std::uint64_t highs= 0x8080'8080'8080'8080;
+
+			const std::uint64_t below= ( word - ones * 0x20 ) & ~word; // High bit set in bytes below 0x20.
+			const std::uint64_t above= ( word + ones * ( 0x7F - 0x7E ) ) | word; // ... and in bytes above 0x7E.
+			return not ( ( below | above ) & highs );
+		}
+
+		// Returns the position just past the escape sequence which starts at `position`.
+		std::size_t
+		skipEscape( const std::string_view text, std::size_t position ) noexcept
+		{
+			if( ++position == text.size() ) return position;
+
+			const char introducer= text[ position++ ];
+			if( introducer == '[' )
+			{
+				// A CSI sequence (which includes SGR) ends with a byte in the range `@` through `~`.
+				while( position < text.size() and not ( text[ position ] >= '@' and text[ position ] <= '~' ) ) ++position;
+				return std::min( position + 1, text.size() );
+			}
+			if( introducer == ']' )
+			{
+				// An OSC sequence ends with BEL, or with ST (`ESC \`).
+				while( position < text.size() )
+				{
+					if( text[ position ] == '\a' ) return position + 1;
+					if( text[ position ] == '\x1b' and position + 1 < text.size() and text[ position + 1 ] == '\\' ) return position + 2;
+					++position;
+				}
+				return position;
+			}
+			return position;
+		}
+
+		std::size_t
+		decodedWidth( const std::string_view text ) noexcept
+		{
+			std::size_t rv= 0;
+			std::size_t position= 0;
+			while( position < text.size() )
+			{
+				const unsigned char lead= text[ position ];
+				if( lead == 0x1B )
+				{
+					position= skipEscape( text, position );
+					continue;
+				}
+				if( lead < 0x80 )
+				{
+					rv+= codePointWidth( lead );
+					++position;
+					continue;
+				}
+
+				const std::size_t length= lead >= 0xF8 ? 0 : lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC2 ? 2 : 0;
+				char32_t codePoint= lead & ( 0x7F >> length );
+				bool valid= length and position + length <= text.size();
+				for( std::size_t i= 1; valid and i < length; ++i )
+				{
+					const unsigned char continuation= text[ position + i ];
+					valid= ( continuation & 0xC0 ) == 0x80;
+					codePoint= codePoint << 6 | ( continuation & 0x3F );
+				}
+
+				if( not valid )
+				{
+					++rv;
+					++position;
+					continue;
+				}
+				rv+= codePointWidth( codePoint );
+				position+= length;
+			}
+
+			return rv;
+		}
+	}
+
+	std::size_t
+	exports::codePointWidth( const char32_t codePoint ) noexcept
+	{
+		if( codePoint < 0x20 or ( codePoint >= 0x7F and codePoint < 0xA0 ) ) return 0;
+		if( codePoint < 0x300 ) return 1;
+		if( contains( zeroWidth, codePoint ) ) return 0;
+		if( contains( wide, codePoint ) ) return 2;
+		return 1;
+	}
+
+	std::size_t
+	exports::displayWidth( const std::string_view text ) noexcept
+	{
+		std::size_t position= 0;
+		for( ; position + sizeof( std::uint64_t ) <= text.size(); position+= sizeof( std::uint64_t ) )
+		{
+			std::uint64_t word;
+			std::memcpy( &word, text.data() + position, sizeof( word ) );
+			if( not printable( word ) ) return position + decodedWidth( text.substr( position ) );
+		}
+
+		for( ; position < text.size(); ++position )
+		{
+			const char ch= text[ position ];
+			if( ch < 0x20 or ch > 0x7E ) return position + decodedWidth( text.substr( position ) );
+		}
+
+		return text.size();
+	}
+}
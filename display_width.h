@@ -0,0 +1,38 @@
+static_assert( __cplusplus > 2020'00 );
+
+#pragma once
+
+#include <Alepha/Alepha.h>
+
+#include <cstddef>
+
+#include <string_view>
+
+namespace Alepha::Hydrogen  ::detail::  display_width_m
+{
+	inline namespace exports
+	{
+		/*!
+		 * Returns the number of terminal columns which some text occupies.
+		 *
+		 * The text is decoded as UTF-8.  East Asian wide and fullwidth characters count as two columns, while
+		 * combining marks, zero-width characters, and control characters count as none.  ANSI escape sequences
+		 * (such as the SGR sequences which `Console`'s `Style` emits) count as none, too.  Bytes which are not valid
+		 * UTF-8 count as one column each.
+		 *
+		 * Text which is pure ASCII, without escapes, is measured without decoding.
+		 *
+		 * @note Newlines and tabs are treated as any other control character; this measures a single run of text,
+		 * not the layout of a whole page.
+		 */
+		std::size_t displayWidth( std::string_view text ) noexcept;
+
+		// Returns the number of columns occupied by a single code point.
+		std::size_t codePointWidth( char32_t codePoint ) noexcept;
+	}
+}
+
+namespace Alepha::Hydrogen::inline exports::inline display_width_m
+{
+	using namespace detail::display_width_m::exports;
+}
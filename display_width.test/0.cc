@@ -0,0 +1,61 @@
+static_assert( __cplusplus > 2020'00 );
+
+#include "../display_width.h"
+
+#include <Alepha/Testing/test.h>
+#include <Alepha/Testing/TableTest.h>
+#include <Alepha/Utility/evaluation_helpers.h>
+
+namespace
+{
+	using namespace Alepha::Testing::literals::test_literals;
+	using Alepha::Testing::TableTest;
+
+	std::size_t width( const std::string text ) { return Alepha::displayWidth( text ); }
+}
+
+static auto init= Alepha::Utility::enroll <=[]
+{
+	"Plain ASCII is one column per character."_test <=TableTest< width >::Cases
+	{
+		{ "Empty", { "" }, 0 },
+		{ "Short", { "Hello" }, 5 },
+		{ "Longer than one word of the fast path", { "Hello, this is a somewhat longer line." }, 38 },
+	};
+
+	"Escape sequences occupy no columns."_test <=TableTest< width >::Cases
+	{
+		{ "SGR around a word", { "\e[1;31mHello\e[0m" }, 5 },
+		{ "SGR in a long line", { "A long line with \e[38;5;208msome colour\e[0m in it." }, 35 },
+		{ "OSC title", { "\e]0;title\aText" }, 4 },
+		{ "Unterminated CSI", { "Text\e[1" }, 4 },
+	};
+
+	"UTF-8 text is measured in columns, not bytes."_test <=TableTest< width >::Cases
+	{
+		{ "Accented", { "caf\xC3\xA9" }, 4 },
+		{ "Combining accent", { "cafe\xCC\x81" }, 4 },
+		{ "CJK is double width", { "\xE6\x97\xA5\xE6\x9C\xAC" }, 4 },
+		{ "Emoji is double width", { "ok \xF0\x9F\x98\x80" }, 5 },
+		{ "Invalid bytes are one column each", { "a\xFF\xC3" }, 3 },
+	};
+
+	"Every combining mark is zero width, and East Asian wide characters are two."_test <=TableTest< Alepha::codePointWidth >::Cases
+	{
+		{ "Syriac mark", { U'\u0730' }, 0 },
+		{ "Syriac mark, at the end of its run", { U'\u074A' }, 0 },
+		{ "Bengali candrabindu", { U'\u0981' }, 0 },
+		{ "Gurmukhi adak bindi", { U'\u0A01' }, 0 },
+		{ "Tamil virama", { U'\u0BCD' }, 0 },
+		{ "Arabic mark", { U'\u08E3' }, 0 },
+		{ "Arabic mark, at the end of its run", { U'\u08FF' }, 0 },
+		{ "Zero width joiner", { U'\u200D' }, 0 },
+		{ "Variation selector", { U'\uFE0F' }, 0 },
+		{ "Hangul syllable", { U'\uAC00' }, 2 },
+		{ "Unassigned CJK extension", { U'\U0002FFF0' }, 2 },
+		{ "Fullwidth letter", { U'\uFF21' }, 2 },
+		{ "Latin letter", { U'a' }, 1 },
+		{ "Soft hyphen", { U'\u00AD' }, 1 },
+		{ "Bengali letter", { U'\u0985' }, 1 },
+	};
+};
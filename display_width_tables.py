@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+#
+# Generates the `zeroWidth` and `wide` tables in `display_width.cc` from the Unicode Character Database which ships
+# with Python (`unicodedata`).  Paste the output over the two tables, when moving to a newer Unicode version.
+#
+# Zero width: general categories Mn, Me and Cf, plus the conjoining Hangul vowels and final consonants, and the
+# emoji skin tone modifiers.  (Everything below U+0300, such as SOFT HYPHEN, is handled before the tables.)
+#
+# Wide: East Asian Width W and F, plus the ranges which EastAsianWidth.txt makes W even where unassigned.
+
+import sys
+import unicodedata
+
+FIRST= 0x300
+LAST= 0x10FFFF
+
+EXTRA_ZERO_WIDTH= [
+	( 0x1160, 0x11FF ), # Hangul Jamo medial vowels and final consonants.
+	( 0xD7B0, 0xD7FF ), # Hangul Jamo Extended-B.
+	( 0x1F3FB, 0x1F3FF ), # Emoji modifiers, which merge with the emoji before them.
+]
+
+DEFAULT_WIDE= [
+	( 0x3400, 0x4DBF ),
+	( 0x4E00, 0x9FFF ),
+	( 0xF900, 0xFAFF ),
+	( 0x20000, 0x2FFFD ),
+	( 0x30000, 0x3FFFD ),
+]
+
+
+def within( ranges, cp ):
+	return any( first <= cp <= last for first, last in ranges )
+
+
+def isZeroWidth( cp ):
+	return unicodedata.category( chr( cp ) ) in ( 'Mn', 'Me', 'Cf' ) or within( EXTRA_ZERO_WIDTH, cp )
+
+
+def isWide( cp ):
+	return not isZeroWidth( cp ) and ( unicodedata.east_asian_width( chr( cp ) ) in ( 'W', 'F' ) or within( DEFAULT_WIDE, cp ) )
+
+
+def ranges( predicate ):
+	rv= []
+	for cp in range( FIRST, LAST + 1 ):
+		if not predicate( cp ): continue
+		if rv and rv[ -1 ][ 1 ] == cp - 1: rv[ -1 ][ 1 ]= cp
+		else: rv.append( [ cp, cp ] )
+	return rv
+
+
+def table( name, comment, predicate ):
+	entries= [ 'Range{ 0x%04X, 0x%04X }' % ( first, last ) for first, last in ranges( predicate ) ]
+	lines= [ '\t\t// ' + comment, '\t\tconstexpr std::array ' + name, '\t\t{' ]
+	for i in range( 0, len( entries ), 4 ):
+		lines.append( '\t\t\t' + ', '.join( entries[ i : i + 4 ] ) + ',' )
+	lines.append( '\t\t};' )
+	return '\n'.join( lines )
+
+
+print( '\t\t// Generated by `display_width_tables.py`, from Unicode %s.' % unicodedata.unidata_version )
+print()
+print( table( 'zeroWidth', 'Combining marks, and other characters which occupy no column of their own.', isZeroWidth ) )
+print()
+print( table( 'wide', 'East Asian wide and fullwidth characters, including the emoji which terminals draw two columns wide.', isWide ) )
@@ -0,0 +1,42 @@
+static_assert( __cplusplus > 2020'00 );
+
+#pragma once
+
+#include <Alepha/Alepha.h>
+
+#include <cstring>
+
+#include <new>
+#include <type_traits>
+
+namespace Alepha::inline Cavorite  ::detail::  lifetime
+{
+	inline namespace exports
+	{
+		/*!
+		 * Begin the lifetime of a `T` in storage which already holds its object representation.
+		 *
+		 * This stands in for C++23's `std::start_lifetime_as`, for implicit-lifetime types.  The bytes are left
+		 * as they were; the (elided) `memmove` is what permits the compiler to assume a `T` lives there.
+		 */
+		template< typename T >
+		T *
+		start_lifetime_as( void *const storage ) noexcept
+		{
+			static_assert( std::is_trivially_copyable_v< std::remove_cv_t< T > > );
+			return std::launder( static_cast< T * >( std::memmove( storage, storage, sizeof( T ) ) ) );
+		}
+
+		template< typename T >
+		const T *
+		start_lifetime_as( const void *const storage ) noexcept
+		{
+			return start_lifetime_as< const T >( const_cast< void * >( storage ) );
+		}
+	}
+}
+
+namespace Alepha::Cavorite::inline exports::inline lifetime
+{
+	using namespace detail::lifetime::exports;
+}
@@ -0,0 +1,200 @@
+static_assert( __cplusplus > 2020'00 );
+
+#pragma once
+
+#include <Alepha/Alepha.h>
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <Alepha/ConstexprString.h>
+
+namespace Alepha::Hydrogen  ::detail::  sgr_names
+{
+	inline namespace exports
+	{
+		/*!
+		 * Translates the SGR Name language (such as `"bold ext:rgb520"`) into the codes of an SGR sequence.
+		 *
+		 * The language is a space separated list of tokens.  Each token is either an effect keyword (`bold`,
+		 * `italic`, `underline`, and so on) or a foreground color, optionally prefixed with `fg:`:
+		 *
+		 *  - `ansi:N`, one of the 8 basic colors, for `N` from 0 to 7;
+		 *  - `ext:N`, one of the 256 extended colors;
+		 *  - `ext:rgbRGB`, an extended color from the 6x6x6 color cube, with each digit from 0 to 5;
+		 *  - `ext:greyN`, an extended greyscale color, for `N` from 0 to 23;
+		 *  - `#RGB` or `#RRGGBB`, a true color, in hex.
+		 *
+		 * This can run at compile time, where a malformed name is a compile error, and at runtime, where it
+		 * throws `std::runtime_error`.  The codes are built into a `Codes`: a `ConstexprString` (the default) can
+		 * be held in a constant, but is limited in size, so names from elsewhere, such as the environment, should
+		 * be parsed into a `std::string`.
+		 */
+		template< typename Codes= ConstexprString >
+		constexpr Codes parseSgrNames( std::string_view text );
+	}
+
+	namespace C
+	{
+		// The effect keywords, sorted, with their SGR codes.
+		constexpr std::array< std::pair< std::string_view, std::string_view >, 16 > keywords
+		{{
+			{ "blink", "5" },
+			{ "bold", "1" },
+			{ "dim", "2" },
+			{ "doubleunder", "21" },
+			{ "doubleunderline", "21" },
+			{ "encircled", "52" },
+			{ "faint", "2" },
+			{ "framed", "51" },
+			{ "italic", "3" },
+			{ "overline", "53" },
+			{ "reset", "0" },
+			{ "strike", "9" },
+			{ "strikethrough", "9" },
+			{ "strikethru", "9" },
+			{ "under", "4" },
+			{ "underline", "4" },
+		}};
+
+		static_assert( std::is_sorted( keywords.begin(), keywords.end(),
+				[]( const auto &lhs, const auto &rhs ) { return lhs.first < rhs.first; } ) );
+	}
+
+	// This is not `constexpr`, so reaching it at compile time is an error, which names it.
+	[[noreturn]] inline void
+	badToken( const std::string_view token )
+	{
+		throw std::runtime_error{ "Unrecognized SGR Name keyword: `" + std::string{ token } + "`" };
+	}
+
+	constexpr void
+	append( ConstexprString &out, const std::string_view text )
+	{
+		out= out + ConstexprString{ text.data(), text.size() };
+	}
+
+	constexpr void append( std::string &out, const std::string_view text ) { out+= text; }
+
+	template< typename Codes >
+	constexpr void
+	appendNumber( Codes &out, int number )
+	{
+		std::array< char, 8 > digits{};
+		std::size_t count= 0;
+		do digits[ count++ ]= char( '0' + number % 10 );
+		while( number/= 10 );
+
+		std::reverse( digits.begin(), digits.begin() + count );
+		append( out, { digits.data(), count } );
+	}
+
+	// Parses `text` as a number in `base`, which must be no greater than `limit`, on behalf of `token`.
+	constexpr int
+	parseNumber( const std::string_view text, const int base, const int limit, const std::string_view token )
+	{
+		if( text.empty() ) badToken( token );
+
+		int rv= 0;
+		for( const char ch: text )
+		{
+			const int digit= ch >= '0' and ch <= '9' ? ch - '0'
+					: ch >= 'a' and ch <= 'f' ? ch - 'a' + 10
+					: ch >= 'A' and ch <= 'F' ? ch - 'A' + 10
+					: base;
+			if( digit >= base ) badToken( token );
+			rv= rv * base + digit;
+			if( rv > limit ) badToken( token );
+		}
+		return rv;
+	}
+
+	// Appends the SGR code for a single token.
+	template< typename Codes >
+	constexpr void
+	appendCode( Codes &out, const std::string_view token )
+	{
+		const auto keyword= std::lower_bound( C::keywords.begin(), C::keywords.end(), token,
+				[]( const auto &entry, const std::string_view name ) { return entry.first < name; } );
+		if( keyword != C::keywords.end() and keyword->first == token ) return append( out, keyword->second );
+
+		std::string_view color= token;
+		if( color.starts_with( "fg:" ) ) color.remove_prefix( 3 );
+
+		if( color.starts_with( "ansi:" ) )
+		{
+			append( out, "3" );
+			return appendNumber( out, parseNumber( color.substr( 5 ), 10, 7, token ) );
+		}
+		if( color.starts_with( "ext:grey" ) )
+		{
+			append( out, "38;5;" );
+			return appendNumber( out, 232 + parseNumber( color.substr( 8 ), 10, 23, token ) );
+		}
+		if( color.starts_with( "ext:rgb" ) )
+		{
+			auto rgb= color.substr( 7 );
+			if( rgb.size() != 3 ) badToken( token );
+
+			int index= 16;
+			for( const int radix: { 36, 6, 1 } )
+			{
+				index+= radix * parseNumber( rgb.substr( 0, 1 ), 10, 5, token );
+				rgb.remove_prefix( 1 );
+			}
+			append( out, "38;5;" );
+			return appendNumber( out, index );
+		}
+		if( color.starts_with( "ext:" ) )
+		{
+			append( out, "38;5;" );
+			return appendNumber( out, parseNumber( color.substr( 4 ), 10, 255, token ) );
+		}
+		if( color.starts_with( '#' ) )
+		{
+			const auto hex= color.substr( 1 );
+			if( hex.size() != 3 and hex.size() != 6 ) badToken( token );
+
+			// Each digit of the short form stands for a pair of the same digit.
+			const std::size_t width= hex.size() / 3;
+			const int scale= width == 1 ? 17 : 1;
+
+			append( out, "38;2" );
+			for( std::size_t i= 0; i < 3; ++i )
+			{
+				append( out, ";" );
+				appendNumber( out, scale * parseNumber( hex.substr( i * width, width ), 16, 255, token ) );
+			}
+			return;
+		}
+
+		badToken( token );
+	}
+
+	template< typename Codes >
+	constexpr Codes
+	exports::parseSgrNames( std::string_view text )
+	{
+		Codes rv;
+		while( not text.empty() )
+		{
+			const auto space= text.find( ' ' );
+			const auto token= text.substr( 0, space );
+			text.remove_prefix( space == std::string_view::npos ? text.size() : space + 1 );
+			if( token.empty() ) continue;
+
+			if( not rv.empty() ) append( rv, ";" );
+			appendCode( rv, token );
+		}
+		return rv;
+	}
+}
+
+namespace Alepha::Hydrogen::inline exports::inline sgr_names
+{
+	using namespace detail::sgr_names::exports;
+}
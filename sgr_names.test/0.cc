@@ -0,0 +1,67 @@
+static_assert( __cplusplus > 2020'00 );
+
+#include "../sgr_names.h"
+
+#include <Alepha/Console.h>
+
+#include <string>
+#include <string_view>
+
+#include <Alepha/Testing/test.h>
+#include <Alepha/Testing/TableTest.h>
+#include <Alepha/Utility/evaluation_helpers.h>
+
+namespace
+{
+	using namespace Alepha::Testing::literals::test_literals;
+	using Alepha::Testing::TableTest;
+	using Alepha::Testing::exports::TestState;
+
+	std::string codes( const std::string text ) { return Alepha::parseSgrNames< std::string >( text ); }
+
+	// The same names are parsed at compile time.
+	static_assert( std::string_view{ Alepha::parseSgrNames( "bold ext:rgb520" ).c_str() } == "1;38;5;208" );
+	static_assert( Alepha::parseSgrNames( "" ).empty() );
+}
+
+static auto init= Alepha::Utility::enroll <=[]
+{
+	"Effect keywords have their SGR codes."_test <=TableTest< codes >::Cases
+	{
+		{ "Bold", { "bold" }, "1" },
+		{ "Synonyms", { "dim faint" }, "2;2" },
+		{ "Overline", { "overline" }, "53" },
+		{ "Extra spaces", { " bold  italic " }, "1;3" },
+	};
+
+	"Colors have their SGR codes."_test <=TableTest< codes >::Cases
+	{
+		{ "Basic", { "ansi:5" }, "35" },
+		{ "Extended", { "ext:208" }, "38;5;208" },
+		{ "Color cube", { "ext:rgb235" }, "38;5;111" },
+		{ "Greyscale", { "ext:grey4" }, "38;5;236" },
+		{ "True color", { "#ff8000" }, "38;2;255;128;0" },
+		{ "Short true color", { "#f80" }, "38;2;255;136;0" },
+		{ "Foreground prefix", { "fg:ansi:1" }, "31" },
+	};
+
+	"Names longer than a constant string can hold parse at runtime."_test <=TableTest< codes >::Cases
+	{
+		{ "Eight true colors", { "#ffffff #ffffff #ffffff #ffffff #ffffff #ffffff #ffffff #ffffff" },
+				"38;2;255;255;255;38;2;255;255;255;38;2;255;255;255;38;2;255;255;255;"
+				"38;2;255;255;255;38;2;255;255;255;38;2;255;255;255;38;2;255;255;255" },
+	};
+
+	"Malformed names are rejected."_test <=TableTest< codes >::Cases
+	{
+		{ "Unknown keyword", { "boldest" }, std::runtime_error{ "Unrecognized SGR Name keyword: `boldest`" } },
+		{ "Color out of range", { "ext:rgb600" }, std::runtime_error{ "Unrecognized SGR Name keyword: `ext:rgb600`" } },
+		{ "Not a number", { "ext:red" }, std::runtime_error{ "Unrecognized SGR Name keyword: `ext:red`" } },
+	};
+
+	"The `_sgr` literal is parsed at compile time."_test <=[]( TestState test )
+	{
+		using namespace Alepha;
+		test.expect( ( "italic ansi:5"_sgr ).code == "3;35" );
+	};
+};
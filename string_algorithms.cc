@@ -2,6 +2,8 @@ static_assert( __cplusplus > 2020'00 );
 
 #include "string_algorithms.h"
 
+#include <cstring>
+
 #include <memory>
 #include <algorithm>
 #include <exception>
@@ -25,63 +27,89 @@ namespace Alepha::Hydrogen  ::detail::  string_algorithms
 			: public Utility::StackableStreambuf
 		{
 			public:
-				VarMap substitutions;
-				std::stringbuf varName;
-				char sigil;
-				enum { Symbol= 1, Normal= 0 } mode= Normal;
-				int throws= 0;
+				SubstitutionFilter expander;
 
 				explicit
 				VariableExpansionStreambuf( std::ostream &os, VarMap &&substitutions, const char sigil )
-					: StackableStreambuf( os ), substitutions( std::move( substitutions ) ), sigil( sigil )
+					: StackableStreambuf( os ), expander( sigil, std::move( substitutions ) )
 				{}
 
+				void writeChar( const char ch ) override { writeChunk( { &ch, 1 } ); }
+
+				// Text without variables is forwarded as it is, in a single call.  When a variable is unknown, the
+				// text before it is still written, just as it was when expansion went a character at a time.
 				void
-				writeChar( const char ch ) override
+				writeChunk( const std::string_view chunk ) override
 				{
-					std::ostream current{ underlying };
-
-					if( mode == Normal and ch == sigil )
+					std::string_view out;
+					try
 					{
-						mode= Symbol;
-						varName.str( "" );
-						return;
+						out= expander.process( chunk );
 					}
-					if( mode == Symbol and ch == sigil )
+					catch( const std::runtime_error & )
 					{
-						mode= Normal;
-						const std::string name( varName.view() );
-						if( not name.empty() )
-						{
-							if( not substitutions.contains( name ) )
-							{
-								throw std::runtime_error{ "No such variable: `" + name +"`" };
-							}
-							if( C::debugExpansion ) error() << "Expanding variable with name `" << name << "`" << std::endl;
-							current << substitutions.at( name )();
-						}
-						else current << sigil;
-						return;
+						out= expander.expanded();
+						underlying->sputn( out.data(), out.size() );
+						throw;
 					}
-
-					if( mode == Symbol ) current.rdbuf( &varName );
-					current << ch;
+					underlying->sputn( out.data(), out.size() );
 				}
 
-				void
-				drain()
-				{
-					if( C::debugIOStreamLifecycle ) error() << "Drain called, and mode is: " << mode << std::endl;
-					if( mode != Normal )
-					{
-						if( C::debugIOStreamLifecycle ) error() << "Mode not being normal, we're throwing (" << ++throws << " times now)..." << std::endl;
-						mode= Normal;
-						throw std::runtime_error{ "Unterminated variable `" + varName.str() + " in expansion." };
-					}
-				}
+				void drain() override { expander.finish(); }
 		};
 	}
 
+	std::string_view
+	SubstitutionFilter::process( const std::string_view input )
+	{
+		if( mode == Normal and input.find( sigil ) == std::string_view::npos ) return input;
+
+		output.clear();
+
+		std::size_t position= 0;
+		while( position < input.size() )
+		{
+			const auto found= input.find( sigil, position );
+			const auto run= input.substr( position, found - position );
+			( mode == Normal ? output : varName )+= run;
+			if( found == std::string_view::npos ) break;
+			position= found + 1;
+
+			if( mode == Normal )
+			{
+				mode= Symbol;
+				varName.clear();
+				continue;
+			}
+
+			mode= Normal;
+			if( varName.empty() )
+			{
+				output+= sigil;
+				continue;
+			}
+
+			const auto var= substitutions.find( varName );
+			if( var == end( substitutions ) ) throw std::runtime_error{ "No such variable: `" + varName +"`" };
+			if( C::debugExpansion ) error() << "Expanding variable with name `" << varName << "`" << std::endl;
+			output+= var->second();
+		}
+
+		return output;
+	}
+
+	void
+	SubstitutionFilter::finish()
+	{
+		if( C::debugIOStreamLifecycle ) error() << "Drain called, and mode is: " << mode << std::endl;
+		if( mode != Normal )
+		{
+			if( C::debugIOStreamLifecycle ) error() << "Mode not being normal, we're throwing..." << std::endl;
+			mode= Normal;
+			throw std::runtime_error{ "Unterminated variable `" + varName + " in expansion." };
+		}
+	}
+
 	void
 	impl::build_streambuf( std::ostream &os, StartSubstitutions &&params )
 	{
@@ -91,79 +119,159 @@ namespace Alepha::Hydrogen  ::detail::  string_algorithms
 	std::string
 	exports::expandVariables( const std::string &text, const VarMap &vars, const char sigil )
 	{
-		std::ostringstream oss;
-
-		oss << StartSubstitutions{ sigil, vars };
-		oss << text;
-		oss << EndSubstitutions;
-
-		return std::move( oss ).str();
+		return CompiledTemplate{ text, sigil }.render( vars );
 	}
 
-	std::vector< std::string >
-	exports::parseCommas( const std::string &string )
+	CompiledTemplate::CompiledTemplate( const std::string_view text, const char sigil )
 	{
-		enum { Text, Backslash } state= Text;
+		// Literal text is gathered into one buffer, so that adjacent literals (including escaped sigils) merge
+		// into a single segment.
+		literals.reserve( text.size() );
+		const auto addLiteral= [&]( const std::string_view piece )
+		{
+			if( piece.empty() ) return;
+			if( not segments.empty() and segments.back().slot == literal ) segments.back().length+= piece.size();
+			else segments.push_back( { literals.size(), piece.size(), literal } );
+			literals+= piece;
+		};
 
-		std::vector< std::string > rv;
-		std::string next;
-		for( const char ch: string )
+		std::size_t position= 0;
+		while( true )
 		{
-			if( state == Backslash )
+			const auto open= text.find( sigil, position );
+			addLiteral( text.substr( position, open - position ) );
+			if( open == std::string_view::npos ) break;
+
+			const auto close= text.find( sigil, open + 1 );
+			if( close == std::string_view::npos )
 			{
-				state= Text;
-				next+= ch;
+				throw std::runtime_error{ "Unterminated variable `" + std::string( text.substr( open + 1 ) ) + " in expansion." };
 			}
-			else if( state == Text )
+			position= close + 1;
+
+			const auto name= text.substr( open + 1, close - open - 1 );
+			if( name.empty() )
 			{
-				if( ch == '\\' ) state= Backslash;
-				else if( ch == ',' )
-				{
-					if( C::debugCommas ) error() << "Parsed from commas: `" << next << "`" << std::endl;
-					rv.push_back( std::move( next ) );
-					next.clear();
-				}
-				else next+= ch;
+				addLiteral( { &sigil, 1 } );
+				continue;
 			}
-		}
 
-		if( C::debugCommas ) error() << "Final parsed from commas: `" << next << "`" << std::endl;
-		rv.push_back( std::move( next ) );
+			const auto found= std::find( begin( names ), end( names ), name );
+			segments.push_back( { 0, 0, std::size_t( found - begin( names ) ) } );
+			if( found == end( names ) ) names.emplace_back( name );
+		}
+	}
 
+	BoundTemplate
+	CompiledTemplate::bind( const VarMap &vars ) const
+	{
+		BoundTemplate rv{ *this };
+		rv.values.reserve( names.size() );
+		for( const auto &name: names )
+		{
+			const auto found= vars.find( name );
+			if( found == end( vars ) ) throw std::runtime_error{ "No such variable: `" + name +"`" };
+			if( C::debugExpansion ) error() << "Binding variable with name `" << name << "`" << std::endl;
+			rv.values.push_back( &found->second );
+		}
 		return rv;
 	}
 
-	std::vector< std::string >
-	exports::split( const std::string &s, const char token )
+	std::string
+	CompiledTemplate::render( const VarMap &vars ) const
 	{
-		std::vector< std::string > rv;
-		std::string next;
-		for( const char ch: s )
+		return bind( vars ).render();
+	}
+
+	void
+	BoundTemplate::renderInto( std::string &out ) const
+	{
+		std::vector< std::string > expansions;
+		expansions.reserve( values.size() );
+		for( const auto *const value: values ) expansions.push_back( ( *value )() );
+
+		std::size_t total= 0;
+		for( const auto &segment: compiled->segments )
 		{
-			if( ch != token )
+			total+= segment.slot == CompiledTemplate::literal ? segment.length : expansions[ segment.slot ].size();
+		}
+		out.reserve( out.size() + total );
+
+		for( const auto &segment: compiled->segments )
+		{
+			if( segment.slot == CompiledTemplate::literal ) out.append( compiled->literals, segment.offset, segment.length );
+			else out+= expansions[ segment.slot ];
+		}
+	}
+
+	void
+	CommaView::iterator::advance()
+	{
+		if( next > text.size() )
+		{
+			ended= true;
+			return;
+		}
+
+		owned= false;
+
+		// Each of the two characters is found with `memchr`, which is vectorized, and the nearer one wins.  An
+		// escape only matters before the comma, so the search for one stops there.
+		const char *const start= text.data() + next;
+		const std::size_t remaining= text.size() - next;
+		const auto *const comma= static_cast< const char * >( std::memchr( start, ',', remaining ) );
+		const std::size_t untilComma= comma ? comma - start : remaining;
+		const auto *const escape= static_cast< const char * >( std::memchr( start, '\\', untilComma ) );
+		const std::size_t found= escape ? next + ( escape - start ) : comma ? next + untilComma : std::string_view::npos;
+		if( found == std::string_view::npos or text[ found ] == ',' )
+		{
+			piece= text.substr( next, found - next );
+			next= found == std::string_view::npos ? text.size() + 1 : found + 1;
+			return;
+		}
+
+		// This piece has escapes, so it must be unescaped into the buffer.
+		owned= true;
+		buffer.assign( text.substr( next, found - next ) );
+		std::size_t position= found;
+		while( position < text.size() and text[ position ] != ',' )
+		{
+			if( text[ position ] == '\\' )
 			{
-				next+= ch;
-				continue;
+				if( position + 1 < text.size() ) buffer+= text[ position + 1 ];
+				position+= 2;
 			}
-			rv.push_back( std::move( next ) );
-			next.clear();
+			else buffer+= text[ position++ ];
 		}
-		rv.push_back( std::move( next ) );
-		return rv;
+		next= position + 1;
 	}
 
 	std::vector< std::string >
-	exports::split( std::string s, const std::string &delim )
+	exports::parseCommas( const std::string &string )
 	{
 		std::vector< std::string > rv;
-		while( true )
+		for( const auto piece: parseCommasView( string ) )
 		{
-			const auto pos= s.find( delim );
-			rv.push_back( s.substr( 0, pos ) );
-			if( pos == std::string::npos ) break;
-			s= s.substr( pos + delim.size() );
+			if( C::debugCommas ) error() << "Parsed from commas: `" << piece << "`" << std::endl;
+			rv.emplace_back( piece );
 		}
 
 		return rv;
 	}
+
+	std::vector< std::string >
+	exports::split( const std::string &s, const char token )
+	{
+		std::vector< std::string > rv;
+		for( const auto piece: splitView( s, token ) ) rv.emplace_back( piece );
+		return rv;
+	}
+
+	std::vector< std::string >
+	exports::split( std::string s, const std::string &delim )
+	{
+		std::vector< std::string > rv;
+		for( const auto piece: splitView( s, delim ) ) rv.emplace_back( piece );
+		return rv;
+	}
 }
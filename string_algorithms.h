@@ -5,13 +5,18 @@ static_assert( __cplusplus > 2020'00 );
 #include <Alepha/Alepha.h>
 
 #include <cassert>
+#include <cstring>
 
 #include <iostream>
+#include <iterator>
+#include <ranges>
 #include <functional>
 #include <algorithm>
 #include <numeric>
+#include <utility>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <map>
 
 #include <boost/lexical_cast.hpp>
@@ -37,9 +42,93 @@ namespace Alepha::Hydrogen  ::detail::  string_algorithms
 		 * @param vars A map of variable names to values to expand.
 		 * @param sigil A character which encloses the variable name.  (If the character is `'%'` for example,
 		 * then `"%variable%"` is a variable name.)
+		 *
+		 * @throws std::runtime_error if a variable is not in the map, or is left unterminated.
 		 */
 		std::string expandVariables( const std::string &text, const VarMap &vars, const char sigil );
 
+		class BoundTemplate;
+
+		/*!
+		 * A text-replacement template, parsed once, for rendering many times.
+		 *
+		 * The template is split into literal text and variable slots, in the syntax of `expandVariables`.  Each
+		 * distinct variable name gets one slot index, no matter how often it appears.
+		 *
+		 * Binding a template to a `VariableMap` (with `bind`) looks every variable up once.  Rendering a bound
+		 * template then calls each variable's function once, and builds the result with a single allocation.
+		 */
+		class CompiledTemplate
+		{
+			private:
+				struct Segment
+				{
+					std::size_t offset; // Into `literals`, for literal segments.
+					std::size_t length;
+					std::size_t slot; // `literal`, for literal segments.
+				};
+
+				static constexpr std::size_t literal= -1;
+
+				std::string literals;
+				std::vector< Segment > segments;
+				std::vector< std::string > names;
+
+				friend BoundTemplate;
+
+			public:
+				/*!
+				 * Parse a template.
+				 *
+				 * @param text The template text.
+				 * @param sigil The character which encloses variable names.  Two in a row stand for the sigil itself.
+				 *
+				 * @throws std::runtime_error if the text ends inside a variable name.
+				 */
+				explicit CompiledTemplate( std::string_view text, char sigil );
+
+				// The names of the variables used by this template, in slot order.
+				const std::vector< std::string > &variables() const noexcept { return names; }
+
+				/*!
+				 * Resolve the variables of this template against a map.
+				 *
+				 * @note The bound template refers to both this template and `vars`, which must outlive it.
+				 *
+				 * @throws std::runtime_error if a variable is not in the map.
+				 */
+				BoundTemplate bind( const VarMap &vars ) const;
+
+				// Bind and render, in one step.
+				std::string render( const VarMap &vars ) const;
+		};
+
+		/*!
+		 * A `CompiledTemplate` whose variables have been resolved.
+		 */
+		class BoundTemplate
+		{
+			private:
+				const CompiledTemplate *compiled;
+				std::vector< const std::function< std::string () > * > values;
+
+				friend CompiledTemplate;
+
+				explicit BoundTemplate( const CompiledTemplate &compiled ) : compiled( &compiled ) {}
+
+			public:
+				// Render the template, appending to `out`.
+				void renderInto( std::string &out ) const;
+
+				std::string
+				render() const
+				{
+					std::string rv;
+					renderInto( rv );
+					return rv;
+				}
+		};
+
 		struct StartSubstitutions_params
 		{
 			const char sigil;
@@ -62,6 +151,58 @@ namespace Alepha::Hydrogen  ::detail::  string_algorithms
 			void build_streambuf( std::ostream &, StartSubstitutions && );
 		}
 
+		/*!
+		 * The variable expansion behind `StartSubstitutions`, as a filter which can be fused into a
+		 * `Utility::pipeline`.
+		 *
+		 * Input is scanned a span at a time, for the sigil.  Spans without variables are passed on as they are.
+		 */
+		class SubstitutionFilter
+		{
+			private:
+				char sigil;
+				VarMap substitutions;
+
+				enum { Symbol= 1, Normal= 0 } mode= Normal;
+				std::string varName;
+				std::string output;
+
+			public:
+				explicit
+				SubstitutionFilter( const char sigil, VarMap substitutions )
+					: sigil( sigil ), substitutions( std::move( substitutions ) )
+				{}
+
+				/*!
+				 * Expand the variables in some more text.
+				 *
+				 * @return The expanded text which is ready to be written.  It remains valid until the next call,
+				 * and for as long as `input` does.
+				 *
+				 * @throws std::runtime_error if a variable is not in the map.
+				 */
+				std::string_view process( std::string_view input );
+
+				// The text which the last `process` call had expanded, when it threw.
+				std::string_view expanded() const noexcept { return output; }
+
+				/*!
+				 * Check that the text ended outside of a variable name.
+				 *
+				 * @throws std::runtime_error if a variable was left unterminated.
+				 */
+				void finish();
+
+				template< typename Sink >
+				void
+				filter( const std::string_view input, Sink &&sink )
+				{
+					if( const auto out= process( input ); not out.empty() ) sink( out );
+				}
+
+				template< typename Sink > void drain( Sink && ) { finish(); }
+		};
+
 		/*!
 		 * Returns a vector of strings parsed from a comma separated string.
 		 *
@@ -77,12 +218,185 @@ namespace Alepha::Hydrogen  ::detail::  string_algorithms
 
 		std::vector< std::string > split( std::string s, const std::string &delim );
 
+		template< typename Delimiter > class SplitView;
+
 		/*!
-		 * Parses an integral range description into a vector of values.
+		 * Returns a lazy range over the pieces of `text` between occurrences of `token`.
+		 *
+		 * The pieces are views into `text`, so nothing is copied or allocated.  The pieces are those which
+		 * `split` would return: an empty text has one (empty) piece, and adjacent delimiters have an empty
+		 * piece between them.
+		 */
+		SplitView< char > splitView( std::string_view text, char token ) noexcept;
+
+		// As above, splitting on a multi-character delimiter.
+		SplitView< std::string_view > splitView( std::string_view text, std::string_view delimiter ) noexcept;
+
+		class CommaView;
+
+		/*!
+		 * Returns a lazy range over the pieces which `parseCommas` would return.
+		 *
+		 * Pieces without backslashes are views into `text`.  A piece with backslash escapes is unescaped into a
+		 * buffer held by the iterator, so it is only valid until the iterator advances.
+		 */
+		CommaView parseCommasView( std::string_view text ) noexcept;
+
+		template< typename Delimiter >
+		class SplitView
+			: public std::ranges::view_interface< SplitView< Delimiter > >
+		{
+			private:
+				std::string_view text;
+				Delimiter delimiter;
+
+				std::size_t
+				find( const std::size_t from ) const noexcept
+				{
+					if constexpr( std::is_same_v< Delimiter, char > )
+					{
+						if( from >= text.size() ) return std::string_view::npos;
+						const void *const found= std::memchr( text.data() + from, delimiter, text.size() - from );
+						return found ? static_cast< const char * >( found ) - text.data() : std::string_view::npos;
+					}
+					else if( delimiter.empty() ) return std::string_view::npos; // Nothing to split on.
+					else return text.find( delimiter, from );
+				}
+
+				std::size_t
+				delimiterSize() const noexcept
+				{
+					if constexpr( std::is_same_v< Delimiter, char > ) return 1;
+					else return delimiter.size();
+				}
+
+			public:
+				class iterator
+				{
+					private:
+						const SplitView *view= nullptr;
+						std::size_t start= 0;
+						std::size_t stop= 0; // The position of the delimiter which ends this piece, or `npos`.
+						bool ended= true;
+
+						friend SplitView;
+
+						explicit
+						iterator( const SplitView &view ) noexcept
+							: view( &view ), stop( view.find( 0 ) ), ended( false )
+						{}
+
+					public:
+						using iterator_concept= std::forward_iterator_tag;
+						using value_type= std::string_view;
+						using difference_type= std::ptrdiff_t;
+
+						iterator()= default;
+
+						std::string_view
+						operator *() const noexcept
+						{
+							return view->text.substr( start, stop - start );
+						}
+
+						iterator &
+						operator ++() noexcept
+						{
+							if( stop == std::string_view::npos ) ended= true;
+							else
+							{
+								start= stop + view->delimiterSize();
+								stop= view->find( start );
+							}
+							return *this;
+						}
+
+						iterator operator ++( int ) noexcept { auto rv= *this; ++*this; return rv; }
+
+						friend bool
+						operator == ( const iterator &lhs, const iterator &rhs ) noexcept
+						{
+							if( lhs.ended or rhs.ended ) return lhs.ended == rhs.ended;
+							return lhs.start == rhs.start;
+						}
+
+						friend bool operator == ( const iterator &it, std::default_sentinel_t ) noexcept { return it.ended; }
+				};
+
+				explicit SplitView( const std::string_view text, const Delimiter delimiter ) noexcept
+					: text( text ), delimiter( delimiter )
+				{}
+
+				iterator begin() const noexcept { return iterator{ *this }; }
+				std::default_sentinel_t end() const noexcept { return {}; }
+		};
+
+		inline SplitView< char >
+		splitView( const std::string_view text, const char token ) noexcept
+		{
+			return SplitView< char >{ text, token };
+		}
+
+		inline SplitView< std::string_view >
+		splitView( const std::string_view text, const std::string_view delimiter ) noexcept
+		{
+			return SplitView< std::string_view >{ text, delimiter };
+		}
+
+		class CommaView
+			: public std::ranges::view_interface< CommaView >
+		{
+			private:
+				std::string_view text;
+
+			public:
+				class iterator
+				{
+					private:
+						std::string_view text;
+						std::size_t next= 0; // Where the piece after this one starts.
+						std::string_view piece;
+						std::string buffer; // The current piece, when it had to be unescaped.
+						bool owned= false;
+						bool ended= true;
+
+						friend CommaView;
+
+						explicit iterator( const std::string_view text ) : text( text ), ended( false ) { advance(); }
+
+						void advance();
+
+					public:
+						using iterator_concept= std::input_iterator_tag;
+						using value_type= std::string_view;
+						using difference_type= std::ptrdiff_t;
+
+						iterator()= default;
+
+						std::string_view operator *() const noexcept { return owned ? std::string_view{ buffer } : piece; }
+
+						iterator &operator ++() { advance(); return *this; }
+						void operator ++( int ) { advance(); }
+
+						friend bool operator == ( const iterator &it, std::default_sentinel_t ) noexcept { return it.ended; }
+				};
+
+				explicit CommaView( const std::string_view text ) noexcept : text( text ) {}
+
+				iterator begin() const { return iterator{ text }; }
+				std::default_sentinel_t end() const noexcept { return {}; }
+		};
+
+		inline CommaView parseCommasView( const std::string_view text ) noexcept { return CommaView{ text }; }
+
+		/*!
+		 * Parses an integral range description (`"low-high"`, or a single integer) into its inclusive bounds.
+		 *
+		 * @throws std::runtime_error if the text is not an integer or a range, or if the range is reversed.
 		 */
 		template< Integral T >
-		std::vector< T >
-		parseRange( const std::string &s )
+		std::pair< T, T >
+		parseInterval( const std::string &s )
 		{
 			auto tokens= split( s, "-" );
 			if( tokens.empty() or tokens.size() > 2 )
@@ -90,13 +404,37 @@ namespace Alepha::Hydrogen  ::detail::  string_algorithms
 				throw std::runtime_error( "Expected an integer or a range." );
 			}
 			// If there's no range, or we had a negative number, just emit that.
-			if( tokens.size() == 1 or tokens.at( 0 ).empty() ) return { boost::lexical_cast< T >( s ) };
+			if( tokens.size() == 1 or tokens.at( 0 ).empty() )
+			{
+				const auto value= boost::lexical_cast< T >( s );
+				return { value, value };
+			}
 
 			const auto low= boost::lexical_cast< T >( tokens.at( 0 ) );
-			const auto high= boost::lexical_cast< T >( tokens.at( 0 ) );
+			const auto high= boost::lexical_cast< T >( tokens.at( 1 ) );
+			if( low > high ) throw std::runtime_error( "The range `" + s + "` is reversed." );
 
-			std::vector< T > rv{ high - low + 1 };
-			std::iota( begin( rv ), end( rv ), low );
+			return { low, high };
+		}
+
+		/*!
+		 * Parses an integral range description into a vector of values.
+		 *
+		 * @note This expands the whole range.  See `parseRangeSet` for a compact form.
+		 */
+		template< Integral T >
+		std::vector< T >
+		parseRange( const std::string &s )
+		{
+			const auto [ low, high ]= parseInterval< T >( s );
+
+			std::vector< T > rv;
+			rv.reserve( std::size_t( high - low ) + 1 );
+			for( T value= low; ; ++value )
+			{
+				rv.push_back( value );
+				if( value == high ) break;
+			}
 
 			return rv;
 		}
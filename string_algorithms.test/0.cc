@@ -2,6 +2,9 @@ static_assert( __cplusplus > 2020'00 );
 
 #include "../string_algorithms.h"
 
+#include <sstream>
+#include <stdexcept>
+
 #include <Alepha/Testing/test.h>
 #include <Alepha/Testing/TableTest.h>
 
@@ -79,4 +82,114 @@ static auto init= enroll <=[]
 		{ "Alphabet string many tokens", { "a::b::c::d", "::" }, { "a", "b", "c", "d" } },
 		{ "Alphabet string many tokens", { "::a::b::c::d::", "::" }, { "", "a", "b", "c", "d", "" } },
 	};
+	"Does a `CompiledTemplate` render the same as `expandVariables`?"_test <=TableTest
+	<
+		[] ( const std::string text, const Alepha::VariableMap vars, const char sigil )
+		{
+			return Alepha::CompiledTemplate{ text, sigil }.render( vars );
+		}
+	>
+	::Cases
+	{
+		{ "Hello World", { "$H$ $W$", { { "H", lambaste<="Hello" }, { "W", lambaste<="World" } }, '$' }, "Hello World" },
+		{ "Escaped sigil", { "$H$ $$ $W$", { { "H", lambaste<="Hello" }, { "W", lambaste<="World" } }, '$' }, "Hello $ World" },
+		{ "Repeated variable", { "$H$, $H$!", { { "H", lambaste<="Hello" } }, '$' }, "Hello, Hello!" },
+		{ "No variables", { "Just text", {}, '$' }, "Just text" },
+	};
+
+	"A `CompiledTemplate` can be bound once and rendered many times."_test <=[]( TestState test )
+	{
+		int counter= 0;
+		const Alepha::VariableMap vars{ { "n", [&counter] { return std::to_string( ++counter ); } } };
+		const Alepha::CompiledTemplate compiled{ "[%n%:%n%]", '%' };
+		test.expect( compiled.variables() == std::vector< std::string >{ "n" } );
+
+		const auto bound= compiled.bind( vars );
+		const auto first= bound.render();
+		const auto second= bound.render();
+		test.expect( first == "[1:1]" );
+		test.expect( second == "[2:2]" );
+	};
+
+	"A `CompiledTemplate` rejects unknown and unterminated variables."_test <=TableTest
+	<
+		[] ( const std::string text, const Alepha::VariableMap vars, const char sigil )
+		{
+			return Alepha::CompiledTemplate{ text, sigil }.render( vars );
+		}
+	>
+	::ExceptionCases
+	{
+		{ "Unknown variable", { "$H$ $X$", { { "H", lambaste<="Hello" } }, '$' }, std::type_identity< std::runtime_error >{} },
+		{ "Unterminated variable", { "$H$ $W", { { "H", lambaste<="Hello" }, { "W", lambaste<="World" } }, '$' },
+				std::type_identity< std::runtime_error >{} },
+	};
+
+	"`expandVariables` throws for an unknown variable."_test <=TableTest< Alepha::expandVariables >::ExceptionCases
+	{
+		{ "Unknown variable", { "$H$ $X$", { { "H", lambaste<="Hello" } }, '$' }, std::type_identity< std::runtime_error >{} },
+		{ "Unknown variable, with no other", { "$X$", {}, '$' }, std::type_identity< std::runtime_error >{} },
+	};
+
+	"A substitution streambuf writes the text before an unknown variable, then fails the stream."_test <=[]( TestState test )
+	{
+		const Alepha::VariableMap vars{ { "H", lambaste<="Hello" } };
+
+		std::ostringstream oss;
+		oss << Alepha::StartSubstitutions{ '$', vars } << "Say $H$, then $X$ and more";
+		const bool failed= oss.bad();
+		oss << Alepha::EndSubstitutions;
+
+		test.expect( failed );
+		test.expect( oss.str() == "Say Hello, then " );
+	};
+
+	"A substitution streambuf reports an unterminated variable when it is popped."_test <=[]( TestState test )
+	{
+		const Alepha::VariableMap vars{ { "H", lambaste<="Hello" } };
+
+		std::ostringstream oss;
+		oss << Alepha::StartSubstitutions{ '$', vars } << "Say $H$, then $H";
+
+		bool thrown= false;
+		try
+		{
+			oss << Alepha::EndSubstitutions;
+		}
+		catch( const std::runtime_error & )
+		{
+			thrown= true;
+		}
+		test.expect( thrown );
+		test.expect( oss.str() == "Say Hello, then " );
+	};
+	"Does `parseCommas` handle escapes correctly?"_test <=TableTest< Alepha::parseCommas >::Cases
+	{
+		{ "Empty string", { "" }, { "" } },
+		{ "Plain list", { "a,b,c" }, { "a", "b", "c" } },
+		{ "Trailing comma", { "a," }, { "a", "" } },
+		{ "Escaped comma", { "a\\,b,c" }, { "a,b", "c" } },
+		{ "Escaped backslash", { "a\\\\,b" }, { "a\\", "b" } },
+		{ "Dangling backslash", { "a,b\\" }, { "a", "b" } },
+		{ "Escape after a plain piece", { "a,b\\,c,d" }, { "a", "b,c", "d" } },
+	};
+
+	"Are the lazy views ranges, which match their eager counterparts?"_test <=[]( TestState test )
+	{
+		static_assert( std::ranges::forward_range< Alepha::SplitView< char > > );
+		static_assert( std::ranges::input_range< Alepha::CommaView > );
+
+		const std::string text= "::a::b:::c:";
+		std::vector< std::string > pieces;
+		for( const auto piece: Alepha::splitView( text, ':' ) ) pieces.emplace_back( piece );
+		test.expect( pieces == Alepha::split( text, ':' ) );
+		test.expect( std::ranges::distance( Alepha::splitView( text, "::" ) ) == 4 );
+		test.expect( std::ranges::distance( Alepha::splitView( text, "" ) ) == 1 );
+
+		const std::string commas= "plain,esc\\,aped,,last";
+		pieces.clear();
+		for( const auto piece: Alepha::parseCommasView( commas ) ) pieces.emplace_back( piece );
+		test.expect( pieces == Alepha::parseCommas( commas ) );
+		test.expect( pieces == ( std::vector< std::string >{ "plain", "esc,aped", "", "last" } ) );
+	};
 };
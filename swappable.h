@@ -0,0 +1,54 @@
+static_assert( __cplusplus > 2020'00 );
+
+#pragma once
+
+#include <Alepha/Alepha.h>
+
+#include <tuple>
+#include <utility>
+
+#include <Alepha/Capabilities.h>
+
+namespace Alepha::inline Cavorite  ::detail::  swaps
+{
+	inline namespace exports
+	{
+		/*!
+		 * Capability for types which swap member-wise.
+		 *
+		 * A `swappable` type provides `swap_lens()`, which returns `swap_magma( members... )` over every member
+		 * which makes up its value.  The `swap` found (by ADL) for the type then swaps those members pairwise,
+		 * which gives a `noexcept` swap without writing one out by hand.  Move construction and assignment can
+		 * then be written in terms of `swap`.
+		 */
+		struct swappable {};
+
+		// Bundle references to the members which a `swappable` type swaps.
+		template< typename ... Members >
+		constexpr auto
+		swap_magma( Members &... members ) noexcept
+		{
+			return std::tie( members... );
+		}
+	}
+
+	template< typename T >
+	concept SwapLensable= Capability< T, swappable > and requires( T &t )
+	{
+		{ t.swap_lens() };
+	};
+
+	template< SwapLensable T >
+	constexpr void
+	swap( T &lhs, T &rhs ) noexcept
+	{
+		auto left= lhs.swap_lens();
+		auto right= rhs.swap_lens();
+		left.swap( right );
+	}
+}
+
+namespace Alepha::Cavorite::inline exports::inline swaps
+{
+	using namespace detail::swaps::exports;
+}
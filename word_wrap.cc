@@ -2,14 +2,20 @@ static_assert( __cplusplus > 2020 );
 
 #include "word_wrap.h"
 
+#include "display_width.h"
+
 #include <cassert>
+#include <cstdint>
 
-#include <tuple>
-#include <iostream>
-#include <iterator>
-#include <sstream>
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <memory>
 
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
+
 #include <Alepha/Utility/evaluation_helpers.h>
 
 namespace Alepha::Hydrogen  ::detail::  word_wrap_m
@@ -18,98 +24,247 @@ namespace Alepha::Hydrogen  ::detail::  word_wrap_m
 	{
 		using namespace Utility::exports::evaluation_helpers;
 
-		// Returns the number of chars in the line just written to.
-		std::size_t
-		applyWordToLine( const std::size_t maximumWidth, const std::size_t nextLineOffset, const std::size_t currentLineWidth, std::string &&word, std::ostream &result )
-		{
-			if( word.empty() ) return currentLineWidth;
-
-			const auto lineWidth= evaluate <=[&]
-			{
-				if( currentLineWidth + word.size() > maximumWidth )
-				{
-					result << "\n";
-					std::fill_n( std::ostream_iterator< char >( result ), nextLineOffset, ' ' );
-					return nextLineOffset;
-				}
-				else return currentLineWidth;
-			};
-
-			const auto rv= lineWidth + word.size();
-			result << std::move( word );
-			return rv;
-		}
-
 		struct WordWrapStreambuf
 			: public Utility::StackableStreambuf
 		{
 			public:
-				std::size_t maximumWidth= 0;
-				std::size_t nextLineOffset= 0;
-				std::size_t currentLineLength= 0;
-
-				std::string currentWord;
+				WordWrapFilter wrapper;
 
 				explicit
 				WordWrapStreambuf( std::ostream &os, const std::size_t width, const std::size_t offset )
-					: StackableStreambuf( os ), maximumWidth( width ), nextLineOffset( offset )
+					: StackableStreambuf( os ), wrapper( width, offset )
 				{}
 
-				void writeChar( const char ch ) override;
+				void writeChar( const char ch ) override { writeChunk( { &ch, 1 } ); }
+
+				void writeChunk( std::string_view chunk ) override;
 
 				void drain() override;
 		};
 	}
 
-	void
-	WordWrapStreambuf::writeChar( const char ch )
+	namespace
 	{
-		std::ostream outWrap{ underlying };
-		if( ch == '\n' )
+		namespace C
 		{
-			const auto prev= currentLineLength;
-			const auto size= currentWord.size();
-			currentLineLength= applyWordToLine( maximumWidth, nextLineOffset, currentLineLength, std::move( currentWord ), outWrap );
-			currentWord.clear();
-			outWrap << '\n';
-			if( currentLineLength == prev + size )
+			// The scanner classifies this many bytes at a time, one bit per byte.
+			const std::size_t blockSize= 64;
+		}
+
+		using BlockScan= std::uint64_t (*)( const char * );
+
+		// Mark the spaces and newlines in one whole block.
+		std::uint64_t
+		scalarScan( const char *const block )
+		{
+			std::uint64_t rv= 0;
+			for( std::size_t i= 0; i < C::blockSize; ++i )
 			{
-				std::fill_n( std::ostream_iterator< char >{ outWrap }, nextLineOffset, ' ' );
-				currentLineLength= nextLineOffset;
+				if( block[ i ] == ' ' or block[ i ] == '\n' ) rv|= std::uint64_t{ 1 } << i;
 			}
-			else currentLineLength= 0;
+			return rv;
 		}
-		else if( ch == ' ' )
+
+		#ifdef __SSE2__
+		std::uint64_t
+		sse2Scan( const char *const block )
 		{
-			currentLineLength= applyWordToLine( maximumWidth, nextLineOffset, currentLineLength, std::move( currentWord ), outWrap );
-			currentWord.clear();
-			if( currentLineLength < maximumWidth )
+			const __m128i space= _mm_set1_epi8( ' ' );
+			const __m128i newline= _mm_set1_epi8( '\n' );
+
+			std::uint64_t rv= 0;
+			for( std::size_t i= 0; i < C::blockSize; i+= 16 )
+			{
+				const __m128i bytes= _mm_loadu_si128( reinterpret_cast< const __m128i * >( block + i ) );
+				const __m128i hits= _mm_or_si128( _mm_cmpeq_epi8( bytes, space ), _mm_cmpeq_epi8( bytes, newline ) );
+				rv|= std::uint64_t( std::uint16_t( _mm_movemask_epi8( hits ) ) ) << i;
+			}
+			return rv;
+		}
+
+		__attribute__(( target( "avx2" ) ))
+		std::uint64_t
+		avx2Scan( const char *const block )
+		{
+			const __m256i space= _mm256_set1_epi8( ' ' );
+			const __m256i newline= _mm256_set1_epi8( '\n' );
+
+			std::uint64_t rv= 0;
+			for( std::size_t i= 0; i < C::blockSize; i+= 32 )
+			{
+				const __m256i bytes= _mm256_loadu_si256( reinterpret_cast< const __m256i * >( block + i ) );
+				const __m256i hits= _mm256_or_si256( _mm256_cmpeq_epi8( bytes, space ), _mm256_cmpeq_epi8( bytes, newline ) );
+				rv|= std::uint64_t( std::uint32_t( _mm256_movemask_epi8( hits ) ) ) << i;
+			}
+			return rv;
+		}
+		#endif
+
+		const BlockScan blockScan= evaluate <=[]() -> BlockScan
+		{
+			#ifdef __SSE2__
+			if( __builtin_cpu_supports( "avx2" ) ) return avx2Scan;
+			return sse2Scan;
+			#else
+			return scalarScan;
+			#endif
+		};
+
+		/*!
+		 * Finds the spaces and newlines in some text, in order.
+		 *
+		 * Whole blocks are classified at once, into a bit mask, so finding the next word boundary is usually just
+		 * a matter of taking the lowest set bit.
+		 */
+		class DelimiterScanner
+		{
+			private:
+				std::string_view text;
+				std::size_t next= 0; // The start of the next block to classify.
+				std::size_t base= 0; // The start of the block which `mask` describes.
+				std::uint64_t mask= 0;
+
+			public:
+				explicit DelimiterScanner( const std::string_view text ) noexcept : text( text ) {}
+
+				// Returns the position of the next space or newline, or `npos` if there are no more.
+				std::size_t
+				find() noexcept
+				{
+					while( not mask )
+					{
+						if( next >= text.size() ) return std::string_view::npos;
+
+						base= next;
+						if( text.size() - next >= C::blockSize ) mask= blockScan( text.data() + next );
+						else
+						{
+							std::array< char, C::blockSize > tail{};
+							std::copy( text.begin() + next, text.end(), tail.begin() );
+							mask= scalarScan( tail.data() ) & ( ( std::uint64_t{ 1 } << ( text.size() - next ) ) - 1 );
+						}
+						next+= C::blockSize;
+					}
+
+					const std::size_t rv= base + std::countr_zero( mask );
+					mask&= mask - 1;
+					return rv;
+				}
+		};
+	}
+
+	std::size_t
+	WordWrapFilter::applyWord( const std::string_view word, std::string &out )
+	{
+		if( word.empty() ) return 0;
+
+		// Most words are plain ASCII, and those are measured here, without a call.
+		const bool plain= std::all_of( word.begin(), word.end(), []( const char ch ) { return ch >= 0x20 and ch < 0x7F; } );
+		const std::size_t width= plain ? word.size() : displayWidth( word );
+		if( currentLineLength + width > maximumWidth )
+		{
+			out+= '\n';
+			out.append( nextLineOffset, ' ' );
+			currentLineLength= nextLineOffset;
+		}
+
+		out+= word;
+		currentLineLength+= width;
+		return width;
+	}
+
+	void
+	WordWrapFilter::process( const std::string_view input, std::string &out )
+	{
+		// Every wrap adds a newline and the indent, but never more often than once per line of output.
+		const std::size_t wraps= input.size() / std::max< std::size_t >( maximumWidth - std::min( maximumWidth, nextLineOffset ), 1 ) + 1;
+		out.reserve( out.size() + input.size() + wraps * ( nextLineOffset + 1 ) );
+
+		std::size_t position= 0;
+		DelimiterScanner scanner{ input };
+		for( std::size_t found; ( found= scanner.find() ) != std::string_view::npos; position= found + 1 )
+		{
+			const auto run= input.substr( position, found - position );
+
+			// A word which lies entirely within this span is applied without copying it.
+			const std::string_view word= evaluate <=[&]() -> std::string_view
 			{
-				outWrap << ' ';
-				++currentLineLength;
+				if( currentWord.empty() ) return run;
+				currentWord+= run;
+				return currentWord;
+			};
+
+			if( input[ found ] == '\n' )
+			{
+				const auto prev= currentLineLength;
+				const auto width= applyWord( word, out );
+				out+= '\n';
+				if( currentLineLength == prev + width )
+				{
+					out.append( nextLineOffset, ' ' );
+					currentLineLength= nextLineOffset;
+				}
+				else currentLineLength= 0;
 			}
+			else
+			{
+				applyWord( word, out );
+				if( currentLineLength < maximumWidth )
+				{
+					out+= ' ';
+					++currentLineLength;
+				}
+			}
+
+			currentWord.clear();
 		}
-		else currentWord+= ch;
+		currentWord+= input.substr( position );
+	}
+
+	std::string_view
+	WordWrapFilter::process( const std::string_view input )
+	{
+		output.clear();
+		process( input, output );
+		return output;
+	}
+
+	void
+	WordWrapFilter::finish( std::string &out )
+	{
+		applyWord( currentWord, out );
+		currentWord.clear();
+	}
+
+	std::string_view
+	WordWrapFilter::finish()
+	{
+		output.clear();
+		finish( output );
+		return output;
+	}
+
+	void
+	WordWrapStreambuf::writeChunk( const std::string_view chunk )
+	{
+		const auto out= wrapper.process( chunk );
+		underlying->sputn( out.data(), out.size() );
 	}
 
 	void
 	WordWrapStreambuf::drain()
 	{
-		if( currentWord.empty() ) return;
-		std::ostream outWrap{ underlying };
-		applyWordToLine( maximumWidth, nextLineOffset, currentLineLength, std::move( currentWord ), outWrap );
+		const auto out= wrapper.finish();
+		underlying->sputn( out.data(), out.size() );
 	}
 
 	std::string
 	exports::wordWrap( const std::string &text, const std::size_t width, const std::size_t nextLineOffset )
 	{
-		std::ostringstream oss;
-
-		oss << StartWrap{ width, nextLineOffset };
-		oss << text;
-		oss << EndWrap;
-
-		auto rv= std::move( oss ).str();
+		std::string rv;
+		WordWrapFilter wrapper{ width, nextLineOffset };
+		wrapper.process( text, rv );
+		wrapper.finish( rv );
 		return rv;
 	}
 
@@ -7,6 +7,7 @@ static_assert( __cplusplus > 2020'00 );
 #include <cstddef>
 
 #include <string>
+#include <string_view>
 #include <streambuf>
 
 #include <Alepha/Utility/StackableStreambuf.h>
@@ -28,6 +29,63 @@ namespace Alepha::Hydrogen  ::detail::  word_wrap_m
 		using StartWrap= Utility::PushStack< StartWrap_params >;
 
 		constexpr Utility::PopStack EndWrap;
+
+		/*!
+		 * The word wrapping behind `StartWrap`, as a filter which can be fused into a `Utility::pipeline`.
+		 *
+		 * Input is scanned a block at a time (with SIMD compares, where available), for the spaces and newlines which
+		 * end words.  Words are measured in terminal columns (see `displayWidth`), so UTF-8 text and styled text
+		 * wrap where they appear to.
+		 */
+		class WordWrapFilter
+		{
+			private:
+				std::size_t maximumWidth;
+				std::size_t nextLineOffset;
+				std::size_t currentLineLength= 0;
+
+				std::string currentWord; // A word which is not yet known to be complete.
+				std::string output;
+
+				// Returns the display width of the word.
+				std::size_t applyWord( std::string_view word, std::string &out );
+
+			public:
+				explicit
+				WordWrapFilter( const std::size_t width, const std::size_t nextLineOffset= 0 )
+					: maximumWidth( width ), nextLineOffset( nextLineOffset )
+				{}
+
+				/*!
+				 * Wrap some more text.
+				 *
+				 * @return The wrapped text which is ready to be written.  It remains valid until the next call.
+				 */
+				std::string_view process( std::string_view input );
+
+				// Wrap some more text, appending the result to `out`.
+				void process( std::string_view input, std::string &out );
+
+				// Wrap the final word, if any.
+				std::string_view finish();
+
+				// Wrap the final word, if any, appending the result to `out`.
+				void finish( std::string &out );
+
+				template< typename Sink >
+				void
+				filter( const std::string_view input, Sink &&sink )
+				{
+					if( const auto out= process( input ); not out.empty() ) sink( out );
+				}
+
+				template< typename Sink >
+				void
+				drain( Sink &&sink )
+				{
+					if( const auto out= finish(); not out.empty() ) sink( out );
+				}
+		};
 	}
 
 	inline namespace impl
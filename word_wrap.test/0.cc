@@ -2,6 +2,11 @@ static_assert( __cplusplus > 2020'00 );
 
 #include "../word_wrap.h"
 
+#include <algorithm>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
 #include <Alepha/Testing/test.h>
 #include <Alepha/Testing/TableTest.h>
 #include <Alepha/Utility/evaluation_helpers.h>
@@ -10,6 +15,54 @@ namespace
 {
 	using namespace Alepha::Testing::literals::test_literals;;
 	using Alepha::Testing::TableTest;
+
+	// `length` bytes of letters, with a delimiter at each of the positions in `breaks`.
+	std::string
+	withBreaks( const std::size_t length, const std::initializer_list< std::size_t > breaks, const char delimiter= '\n' )
+	{
+		std::string rv;
+		for( std::size_t i= 0; i < length; ++i ) rv+= char( 'a' + i % 26 );
+		for( const auto position: breaks ) rv.at( position )= delimiter;
+		return rv;
+	}
+
+	// `length` bytes of letters, with newlines from `first` up to `last`.
+	std::string
+	newlines( const std::size_t length, const std::size_t first, const std::size_t last )
+	{
+		std::string rv= withBreaks( length, {} );
+		std::fill( rv.begin() + first, rv.begin() + last, '\n' );
+		return rv;
+	}
+
+	// Text which is never wrapped, and is indented by 2, only gains the indent after each newline.
+	std::string
+	indented( const std::string &text )
+	{
+		std::string rv;
+		for( const char ch: text ) rv+= ch == '\n' ? std::string{ "\n  " } : std::string{ ch };
+		return rv;
+	}
+
+	// Wrapping a byte at a time never scans a whole block, so this checks the block scans against the scalar one.
+	std::string
+	bytewise( const std::string &text, const std::size_t width, const std::size_t nextLineOffset )
+	{
+		std::string rv;
+		Alepha::WordWrapFilter wrapper{ width, nextLineOffset };
+		for( const char ch: text ) wrapper.process( std::string_view{ &ch, 1 }, rv );
+		wrapper.finish( rv );
+		return rv;
+	}
+
+	// Words of every length from 1 to 12, over and over, to put delimiters at every offset within a block.
+	std::string
+	ragged( const std::size_t length )
+	{
+		std::string rv;
+		for( std::size_t word= 1; rv.size() < length; word= word % 12 + 1 ) rv+= std::string( word, 'w' ) + ' ';
+		return rv.substr( 0, length );
+	}
 }
 
 static auto init= Alepha::Utility::enroll <=[]
@@ -122,4 +175,32 @@ static auto init= Alepha::Utility::enroll <=[]
 		{ "Two word indent, extra newline", { "Hello\n\nWorld!", 8, 2 }, "Hello\n  \n  World!" },
 		{ "Two word indent, one newline", { "Hello\nWorld!", 8, 2 }, "Hello\n  World!" },
 	};
+
+	"word_wrap.display_width"_test <=TableTest< Alepha::wordWrap >::Cases
+	{
+		{ "Styled words wrap by their visible width", { "\e[1mHello\e[0m \e[1mWorld\e[0m", 11, 0 }, "\e[1mHello\e[0m \e[1mWorld\e[0m" },
+		{ "Accented words wrap by their visible width", { "caf\xC3\xA9 caf\xC3\xA9", 9, 0 }, "caf\xC3\xA9 caf\xC3\xA9" },
+		{ "Wide words wrap by their visible width", { "\xE6\x97\xA5\xE6\x9C\xAC \xE6\x97\xA5\xE6\x9C\xAC", 8, 0 },
+				"\xE6\x97\xA5\xE6\x9C\xAC \n\xE6\x97\xA5\xE6\x9C\xAC" },
+	};
+
+	"word_wrap.blocks"_test <=TableTest< Alepha::wordWrap >::Cases
+	{
+		{ "Newline at the end of the first block", { withBreaks( 130, { 63 } ), 1000, 2 }, indented( withBreaks( 130, { 63 } ) ) },
+		{ "Newline at the start of the second block", { withBreaks( 130, { 64 } ), 1000, 2 }, indented( withBreaks( 130, { 64 } ) ) },
+		{ "Newlines either side of a block edge", { withBreaks( 130, { 63, 64 } ), 1000, 2 },
+				indented( withBreaks( 130, { 63, 64 } ) ) },
+		{ "Newlines at both ends of both blocks, with no tail", { withBreaks( 128, { 0, 63, 64, 127 } ), 1000, 2 },
+				indented( withBreaks( 128, { 0, 63, 64, 127 } ) ) },
+		{ "Newline at the start of the tail", { withBreaks( 150, { 128 } ), 1000, 2 }, indented( withBreaks( 150, { 128 } ) ) },
+		{ "Newline as the last byte of the tail", { withBreaks( 150, { 149 } ), 1000, 2 }, indented( withBreaks( 150, { 149 } ) ) },
+		{ "A block of nothing but newlines", { newlines( 200, 64, 128 ), 1000, 2 }, indented( newlines( 200, 64, 128 ) ) },
+
+		{ "Spaces at block edges wrap as they do a byte at a time", { withBreaks( 200, { 63, 64, 127, 128, 191 }, ' ' ), 70, 0 },
+				bytewise( withBreaks( 200, { 63, 64, 127, 128, 191 }, ' ' ), 70, 0 ) },
+		{ "Ragged words wrap as they do a byte at a time", { ragged( 1000 ), 20, 0 }, bytewise( ragged( 1000 ), 20, 0 ) },
+		{ "Ragged words with an indent wrap as they do a byte at a time", { ragged( 1000 ), 17, 3 }, bytewise( ragged( 1000 ), 17, 3 ) },
+		{ "Ragged words ending mid-tail wrap as they do a byte at a time", { ragged( 1000 - 37 ), 9, 2 },
+				bytewise( ragged( 1000 - 37 ), 9, 2 ) },
+	};
 };